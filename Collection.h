@@ -3,17 +3,22 @@
 
 #include <functional>
 #include <initializer_list>
+#include <ostream>
 #include <sstream>
 #include <string>
-#include <typeinfo>
+#include <utility>
 
-#include "src/DispatcherImpl.h"
+#include "Dispatcher.h"
+#include "MemoryUsage.h"
+#include "View.h"
+#include "src/TextWriter.h"
 
 namespace etsai {
 namespace collections {
 
 using std::function;
 using std::initializer_list;
+using std::ostream;
 using std::string;
 using std::stringstream;
 
@@ -60,6 +65,12 @@ public:
      * @return  Max number of elements
      */
     virtual int capacity() const= 0;
+    /**
+     * Get the heap bytes owned by the collection, split into element payload, unused capacity, and bookkeeping 
+     * overhead.  Memory owned by the elements themselves is not included.
+     * @return  Bytes owned by the collection
+     */
+    virtual MemoryUsage memoryUsage() const= 0;
     /**
      * Returns true if the collection holds no elements
      * @return True if empty
@@ -86,18 +97,45 @@ public:
      */
     virtual bool forAll(const function<bool (const T&)>& predicate) const= 0;
     /**
-     * Creates a string representation of the collection
+     * Creates a string representation of the collection, in the default TextFormat
      * @return  String representation of the collection
      */
     virtual string toString() const;
     /**
-     * Transforms the collection from T collection -> U collection.  Evaluates [f(a0), f(a1), ..., f(an)].  The caller is 
-     * responsible for deallocating the created collection.
+     * Writes the text representation of the collection to the stream.  The text is built in a fixed size buffer 
+     * and written a chunk at a time, so memory use does not grow with the size of the collection.
+     * @param   output  Stream to write to
+     * @param   format  Delimiters, truncation, and chunk size to use
+     */
+    void writeTo(ostream& output, const TextFormat& format= TextFormat()) const;
+    /**
+     * Writes the text representation of the collection to the callback, one chunk of at most format.chunkSize 
+     * bytes at a time.  The chunks are only valid for the duration of the call.
+     * @param   writer  Lambda receiving each chunk as a pointer and a length
+     * @param   format  Delimiters, truncation, and chunk size to use
+     */
+    void writeTo(const function<void (const char*, size_t)>& writer, const TextFormat& format= TextFormat()) const;
+    /**
+     * Transforms the collection from T collection -> U collection.  Evaluates [f(a0), f(a1), ..., f(an)].  The created 
+     * collection is the same kind of collection as the calling object, found with a Dispatcher.  The caller is 
+     * responsible for deallocating the created collection.  Derived classes also provide a map function returning 
+     * their own class by value, which should be preferred when the concrete type is known.
      * @param   transform   Lambda that maps T -> U
-     * @return  Pointer to a C style array of the transformed values
+     * @return  Pointer to the collection of transformed values
      */
     template <class U>
     Collection<U>* map(const function<U (const T&)>& transform) const;
+    /**
+     * Creates a lazy view over the collection.  Operations chained on the view are fused into a single pass over 
+     * the collection and only evaluated when the view is consumed or collected.  The collection must outlive the view.
+     * @return  View of the collection's elements
+     */
+    View<T> view() const;
+    /**
+     * Calls the dispatcher overload matching the derived class of the collection
+     * @param   dispatcher  Dispatcher to pass the collection to
+     */
+    virtual void accept(Dispatcher<T>& dispatcher) const= 0;
     /**
      * Applies the lambda to each element in the collection.  This version does not allow you to modify the elements.
      * @param   lambda      Lambda function to evaluate each element with
@@ -121,6 +159,21 @@ public:
      * @return  True if the collection was modified
      */
     virtual bool add(const T& elem)= 0;
+    /**
+     * Adds the element to the collection, moving it in rather than copying it.  The default implementation copies 
+     * the element with the const reference version; collections that can store a moved value override it.
+     * @param   elem    Element to add
+     * @return  True if the collection was modified
+     */
+    virtual bool add(T&& elem);
+    /**
+     * Constructs an element from the arguments and adds it to the collection.  Classes that can construct the 
+     * element in its final position provide their own version.
+     * @param   args    Arguments to pass to the element's constructor
+     * @return  True if the collection was modified
+     */
+    template <class... Args>
+    bool emplace(Args&&... args);
     /**
      * Removes all elements in the collection
      */
@@ -131,34 +184,75 @@ template <class T>
 Collection<T>::~Collection() {
 }
 
+template <class T>
+bool Collection<T>::add(T&& elem) {
+    return add(static_cast<const T&>(elem));
+}
+
+template <class T> template <class... Args>
+bool Collection<T>::emplace(Args&&... args) {
+    return add(T(std::forward<Args>(args)...));
+}
+
+template <class T>
+View<T> Collection<T>::view() const {
+    return View<T>(view::Source<T>(this));
+}
+
 template <class T>
 string Collection<T>::toString() const {
-    stringstream str;
-    bool first(true);
+    string text;
 
-    str << "[";
-    each([&str, &first](const T& elem) -> void {
-        if (!first) {
-            str << ", ";
-        }
-        str << elem;
-        first= false;
+    writeTo([&text](const char* data, size_t length) -> void {
+        text.append(data, length);
     });
-    str << "]";
-    return str.str();
+    return text;
 }
 
-template <class T> template <class U>
-Collection<U>* Collection<T>::map(const function<U (const T&)>& transform) const {
-    Dispatcher<T,U> *dispatcher= new DispatcherImpl<T,U>();
-    Collection<U>* converted= dispatcher->create(this);
+template <class T>
+void Collection<T>::writeTo(ostream& output, const TextFormat& format) const {
+    writeTo([&output](const char* data, size_t length) -> void {
+        output.write(data, length);
+    }, format);
+}
 
-    each([&converted, &transform](const T& elem) -> void {
-        converted->add(transform(elem));
-    });
-    delete dispatcher;
+template <class T>
+void Collection<T>::writeTo(const function<void (const char*, size_t)>& writer, const TextFormat& format) const {
+    TextWriter text(writer, format.chunkSize);
+    int count= size(), index= 0;
+    int skipFrom= count, skipTo= count;
+    bool first= true;
+
+    if ((format.head >= 0 || format.tail >= 0) && (format.head < 0 ? 0 : format.head) + (format.tail < 0 ? 0 : format.tail) < count) {
+        skipFrom= format.head < 0 ? 0 : format.head;
+        skipTo= count - (format.tail < 0 ? 0 : format.tail);
+    }
 
-    return converted;
+    text.write(format.open);
+    exists([&text, &format, &index, &first, skipFrom, skipTo, count](const T& elem) -> bool {
+        if (index < skipFrom || index >= skipTo) {
+            if (!first) {
+                text.write(format.separator);
+            }
+            text.writeValue(elem);
+            first= false;
+        } else if (index == skipFrom) {
+            if (!first) {
+                text.write(format.separator);
+            }
+            text.write(format.ellipsis);
+            first= false;
+        }
+        index++;
+        return index >= skipFrom && skipTo == count;
+    });
+    if (skipFrom < skipTo && skipTo == count && index <= skipFrom) {
+        if (!first) {
+            text.write(format.separator);
+        }
+        text.write(format.ellipsis);
+    }
+    text.write(format.close);
 }
 
 }   //namespace collections
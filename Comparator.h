@@ -0,0 +1,64 @@
+#ifndef ETSAI_COLLECTIONS_COMPARATOR_H
+#define ETSAI_COLLECTIONS_COMPARATOR_H
+
+#include <type_traits>
+
+namespace etsai {
+namespace collections {
+
+/**
+ * Marker class for three-way comparators.  A comparator deriving from this class must return an int from its
+ * call operator that is negative, zero, or positive if the left element is respectively less than, equal to, or
+ * greater than the right element.  Ordered collections use three-way comparators to order two elements with a
+ * single comparison.  Comparators that do not derive from this class are treated as a strict weak ordering,
+ * such as std::less.
+ * @author etsai
+ */
+struct ThreeWayComparator {
+};
+
+/**
+ * Adapts a comparator into the three operations ordered collections need.  The adaption is decided at compile
+ * time so calls to the comparator can be inlined.
+ * @author etsai
+ */
+template <class T, class Compare, bool ThreeWay= std::is_base_of<ThreeWayComparator, Compare>::value>
+struct CompareTraits {
+    /**
+     * Returns true if the left element is ordered before the right element
+     */
+    static inline bool less(const Compare& compare, const T& left, const T& right) {
+        return compare(left, right);
+    }
+    /**
+     * Returns true if neither element is ordered before the other.  A strict weak ordering needs two comparisons.
+     */
+    static inline bool equivalent(const Compare& compare, const T& left, const T& right) {
+        return !compare(left, right) && !compare(right, left);
+    }
+    /**
+     * Returns a negative value, zero, or a positive value if the left element is respectively ordered before,
+     * equivalent to, or ordered after the right element
+     */
+    static inline int order(const Compare& compare, const T& left, const T& right) {
+        return compare(left, right) ? -1 : (compare(right, left) ? 1 : 0);
+    }
+};
+
+template <class T, class Compare>
+struct CompareTraits<T, Compare, true> {
+    static inline bool less(const Compare& compare, const T& left, const T& right) {
+        return compare(left, right) < 0;
+    }
+    static inline bool equivalent(const Compare& compare, const T& left, const T& right) {
+        return compare(left, right) == 0;
+    }
+    static inline int order(const Compare& compare, const T& left, const T& right) {
+        return compare(left, right);
+    }
+};
+
+}   //namespace collections
+}   //namespace etsai
+
+#endif
@@ -1,32 +1,39 @@
 #ifndef ETSAI_COLLECTIONS_DISPATCHER_H
 #define ETSAI_COLLECTIONS_DISPATCHER_H
 
+#include "Forward.h"
+
 namespace etsai {
 namespace collections {
 
-template <class Y>
-class Collection;
-
 /**
  * Pure virtual class that acts as a 3rd party class which knows all 
- * derived classes of the Collection abstract class.  The class' goal 
- * is to provide a way to create a new collection of type U, with the 
- * caveat that the collection is the same derived class of the input 
- * collection of type T.
+ * derived classes of the Collection abstract class.  A collection passes 
+ * itself to the dispatch overload matching its own class through 
+ * Collection::accept, giving the dispatcher the concrete type of the 
+ * collection without RTTI.  Collections that do not have their own 
+ * overload are dispatched as a generic List or Set.
  * @author etsai
  */
-template <class T, class U>
+template <class T>
 class Dispatcher {
 public:
+    virtual ~Dispatcher() {
+    }
+    /**
+     * Handles a list without its own overload
+     * @param   collection  The list being dispatched
+     */
+    virtual void dispatch(const List<T>& collection)= 0;
     /**
-     * Creates an empty collection of type U that is the same type as the 
-     * input's derived collection class
-     * @param   collection  The collection whose class to copy
-     * @return  Empty collection containing type U, that is the same type 
-     * as the input
+     * Handles a set without its own overload
+     * @param   collection  The set being dispatched
      */
-    virtual Collection<U>* create(const Collection<T>* collection)= 0;
-    
+    virtual void dispatch(const Set<T>& collection)= 0;
+    virtual void dispatch(const list::ArrayList<T>& collection)= 0;
+    virtual void dispatch(const list::CircularLinkedList<T>& collection)= 0;
+    virtual void dispatch(const list::TreeList<T>& collection)= 0;
+    virtual void dispatch(const set::SortedSet<T>& collection)= 0;
 };
 
 }
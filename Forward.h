@@ -0,0 +1,50 @@
+#ifndef ETSAI_COLLECTIONS_FORWARD_H
+#define ETSAI_COLLECTIONS_FORWARD_H
+
+#include "Instrumentation.h"
+
+#include <functional>
+
+/**
+ * Forward declarations of the collection classes.  Default template arguments may only be given once, so they
+ * are given here rather than on the class definitions, and are visible wherever a collection is named.
+ */
+namespace etsai {
+namespace collections {
+
+template <class T>
+class Collection;
+template <class T>
+class List;
+template <class T>
+class Set;
+
+namespace list {
+
+template <class T, class Instrumentation= NoInstrumentation>
+class ArrayList;
+template <class T, class Instrumentation= NoInstrumentation>
+class CircularLinkedList;
+template <class T>
+class TreeList;
+
+}
+
+namespace set {
+
+template <class T, class Compare= std::less<T>, class Instrumentation= NoInstrumentation>
+class SortedSet;
+
+}
+
+namespace queue {
+
+template <class T, class Compare= std::less<T>>
+class PriorityQueue;
+
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,157 @@
+#ifndef ETSAI_COLLECTIONS_INSTRUMENTATION_H
+#define ETSAI_COLLECTIONS_INSTRUMENTATION_H
+
+#include <atomic>
+#include <ostream>
+#include <string>
+
+namespace etsai {
+namespace collections {
+
+/**
+ * Counts of the work done by a container.  Containers only update the counters that apply to them.
+ * @author etsai
+ */
+struct OperationCounters {
+    OperationCounters() : reallocations(0), reallocatedElements(0), shiftedElements(0), nodeHops(0), comparisons(0) {
+    }
+
+    /**
+     * Adds the other counters to these counters
+     * @param   counters    Counters to add
+     * @return  Reference to this object
+     */
+    OperationCounters& operator +=(const OperationCounters& counters) {
+        reallocations+= counters.reallocations;
+        reallocatedElements+= counters.reallocatedElements;
+        shiftedElements+= counters.shiftedElements;
+        nodeHops+= counters.nodeHops;
+        comparisons+= counters.comparisons;
+        return *this;
+    }
+
+    /**
+     * Writes one "prefix.name value" line per counter, the plain text format most metrics exporters scrape
+     * @param   output  Stream to write to
+     * @param   prefix  Name to put in front of each counter
+     */
+    void dump(std::ostream& output, const std::string& prefix) const {
+        output << prefix << ".reallocations " << reallocations << "\n";
+        output << prefix << ".reallocated_elements " << reallocatedElements << "\n";
+        output << prefix << ".shifted_elements " << shiftedElements << "\n";
+        output << prefix << ".node_hops " << nodeHops << "\n";
+        output << prefix << ".comparisons " << comparisons << "\n";
+    }
+
+    /** Number of times an array was reallocated */
+    unsigned long reallocations;
+    /** Number of elements moved into a reallocated array */
+    unsigned long reallocatedElements;
+    /** Number of elements moved over to open or close a gap for an insertion or removal */
+    unsigned long shiftedElements;
+    /** Number of links followed to reach a node */
+    unsigned long nodeHops;
+    /** Number of calls to a comparator */
+    unsigned long comparisons;
+};
+
+/**
+ * Default instrumentation policy, which records nothing.  Containers inherit from their policy, so this empty
+ * class takes no space, and every hook is an empty inline function the compiler removes.  Hooks are const since
+ * lookups on const containers also do work worth counting.
+ * @author etsai
+ */
+class NoInstrumentation {
+public:
+    void reallocated(int) const {
+    }
+    void shifted(int) const {
+    }
+    void hopped(int) const {
+    }
+    void compared(int) const {
+    }
+    /**
+     * Get the counters of this container, which are always zero
+     */
+    OperationCounters counters() const {
+        return OperationCounters();
+    }
+};
+
+/**
+ * Instrumentation policy that counts the work done by each container, and adds every count to process wide
+ * totals.  The totals are atomic so containers on different threads can update them, at the cost of one atomic
+ * add per recorded event.
+ * @author etsai
+ */
+class CountingInstrumentation {
+public:
+    void reallocated(int elements) const {
+        local.reallocations++;
+        local.reallocatedElements+= elements;
+        totals().reallocations.fetch_add(1, std::memory_order_relaxed);
+        totals().reallocatedElements.fetch_add(elements, std::memory_order_relaxed);
+    }
+    void shifted(int elements) const {
+        local.shiftedElements+= elements;
+        totals().shiftedElements.fetch_add(elements, std::memory_order_relaxed);
+    }
+    void hopped(int nodes) const {
+        local.nodeHops+= nodes;
+        totals().nodeHops.fetch_add(nodes, std::memory_order_relaxed);
+    }
+    void compared(int comparisons) const {
+        local.comparisons+= comparisons;
+        totals().comparisons.fetch_add(comparisons, std::memory_order_relaxed);
+    }
+    /**
+     * Get the counters of this container
+     */
+    OperationCounters counters() const {
+        return local;
+    }
+
+    /**
+     * Get the sum of the counters of every instrumented container in the process, including destroyed ones
+     * @return  Process wide counters
+     */
+    static OperationCounters globalCounters() {
+        OperationCounters counters;
+
+        counters.reallocations= totals().reallocations.load();
+        counters.reallocatedElements= totals().reallocatedElements.load();
+        counters.shiftedElements= totals().shiftedElements.load();
+        counters.nodeHops= totals().nodeHops.load();
+        counters.comparisons= totals().comparisons.load();
+        return counters;
+    }
+    /**
+     * Sets the process wide counters back to zero
+     */
+    static void resetGlobalCounters() {
+        totals().reallocations= 0;
+        totals().reallocatedElements= 0;
+        totals().shiftedElements= 0;
+        totals().nodeHops= 0;
+        totals().comparisons= 0;
+    }
+
+private:
+    struct Totals {
+        std::atomic<unsigned long> reallocations, reallocatedElements, shiftedElements, nodeHops, comparisons;
+    };
+
+    static Totals& totals() {
+        static Totals totals= {{0}, {0}, {0}, {0}, {0}};
+
+        return totals;
+    }
+
+    mutable OperationCounters local;
+};
+
+}   //namespace collections
+}   //namespace etsai
+
+#endif
@@ -7,6 +7,7 @@
 #include <initializer_list>
 #include <sstream>
 #include <stdexcept>
+#include <utility>
 
 namespace etsai {
 namespace collections {
@@ -29,6 +30,7 @@ public:
      * Pure virtual destructor
      */
     virtual ~List()= 0;
+    using Collection<T>::add;
     virtual bool add(const T& elem)= 0;
     /**
      * Insert an element at the specific position.  If the index is greater than the list size or capacity, 
@@ -38,6 +40,22 @@ public:
      * @return  True if the collection was modified from the call
      */
     virtual bool add(int index, const T& elem)= 0;
+    /**
+     * Insert an element at the specific position, moving it in rather than copying it.  The default implementation 
+     * copies the element with the const reference version.
+     * @param   index   Index to insert the element at
+     * @param   elem    Element to insert
+     * @return  True if the collection was modified from the call
+     */
+    virtual bool add(int index, T&& elem);
+    /**
+     * Constructs an element from the arguments and inserts it at the specific position
+     * @param   index   Index to insert the element at
+     * @param   args    Arguments to pass to the element's constructor
+     * @return  True if the collection was modified from the call
+     */
+    template <class... Args>
+    bool emplaceAt(int index, Args&&... args);
     /**
      * Checks if both collections have the same elements in the same order.  This version takes in an 
      * initializer list, providing a convenient way to quickly construct a collection.
@@ -72,7 +90,15 @@ public:
      */
     virtual void set(int index, const T& elem) throw(out_of_range)= 0;
     /**
-     * Remove the element at the specific index and return the stored value
+     * Replace the element at the specific index with the new element, moving it in rather than copying it.  The 
+     * default implementation copies the element with the const reference version.
+     * @param   index   Index to replace
+     * @param   elem    Element to be stored 
+     * throws   out_of_range    If index lies outside the range [0, list size - 1]
+     */
+    virtual void set(int index, T&& elem) throw(out_of_range);
+    /**
+     * Remove the element at the specific index and return the stored value.  The value is moved out of the list.
      * @param   index   Index to remove
      * @return  Element stored at the index
      * @throws  out_of_range    If index lies outside the range [0, list size - 1]
@@ -85,6 +111,14 @@ public:
      * @throws  out_of_range    If index lies outside the range [0, list size - 1]
      */
     virtual T get(int index) const throw(out_of_range)= 0;
+    /**
+     * Get a reference to the element stored at the index, without copying it.  The reference is invalidated by the 
+     * next modification of the list.
+     * @param   index   Index to lookup
+     * @return  Reference to the element at the given index
+     * @throws  out_of_range    If index lies outside the range [0, list size - 1]
+     */
+    virtual const T& at(int index) const throw(out_of_range)= 0;
     /**
      * Creates a sublist starting from the start index to the end index.  It is the function caller's responsibility to  
      * deallocate the created list
@@ -96,25 +130,73 @@ public:
      */
     virtual List<T>* subList(int startIndex, int endIndex) const throw(out_of_range, invalid_argument)= 0;
     /**
-     * Applies a function across all elements with an initial value with a left fold ordering.  Evaluates f(...f(f(a, b0), b1), bn)
+     * Applies the lambda to each element in the collection, from the last element to the first.  The default 
+     * implementation looks up every index with get; derived classes should override it with their own traversal.
+     * @param   lambda      Lambda function to evaluate each element with
+     */
+    virtual void eachReverse(const function<void (const T&)>& lambda) const;
+    /**
+     * Steps through the elements of a list from the first to the last, so callers can pull elements one at a 
+     * time.  The list must not be modified while a cursor is in use.
+     * @author etsai
+     */
+    class Cursor {
+    public:
+        virtual ~Cursor() {
+        }
+        /**
+         * Get the next element
+         * @return  Pointer to the element, or NULL once every element has been visited
+         */
+        virtual const T* next()= 0;
+    };
+    /**
+     * Creates a cursor positioned before the first element.  The default cursor looks up every index with at; 
+     * lists without constant time indexing should override it with their own traversal.  The caller is 
+     * responsible for deallocating the cursor.
+     * @return  Cursor over the list
+     */
+    virtual Cursor* cursor() const;
+    /**
+     * Applies a function across all elements with an initial value with a left fold ordering.  Evaluates f(...f(f(a, b0), b1), bn).  
+     * The elements are visited with each and the result of every call is moved into the accumulator.  An empty list 
+     * folds to the initial value.
      * @param   initialValue    Initial value to give to the function
      * @param   lambda          Lambda that takes 2 parameters, mapping (U, T) -> U
      */
     template <class U>
     U foldLeft(const U& initialValue, const function<U (const U&, const T&)>& lambda) const;
     /**
-     * Applies a function across all elements with an initial value with a right fold odering.  Evaluates f(b0, ...f(bn-1, f(bn, a)))
+     * Applies a function across all elements with an initial value with a right fold odering.  Evaluates f(b0, ...f(bn-1, f(bn, a))).  
+     * The elements are visited with eachReverse and the result of every call is moved into the accumulator.  An empty 
+     * list folds to the initial value.
      * @param   initialValue    Initial value to give to the function
      * @param   lambda          Lambda that takes 2 parameters, mapping (T, U) -> U
      */
     template <class U>
     U foldRight(const U& initialValue, const function<U (const T&, const U&)>& lambda) const;
+    /**
+     * Reduces the list with an associative operation.  The list may be split into consecutive runs, each folded 
+     * left from the identity with op, and the partial results joined in order with combine.  This version folds 
+     * the whole list in one run; ArrayList provides a version that folds the runs in parallel.
+     * @param   identity    Value that leaves any other value unchanged when combined with it
+     * @param   op          Lambda that folds an element into a partial result, mapping (U, T) -> U
+     * @param   combine     Associative lambda joining two partial results, mapping (U, U) -> U
+     * @return  Reduced value, or the identity if the list is empty
+     */
+    template <class U>
+    U reduce(const U& identity, const function<U (const U&, const T&)>& op, const function<U (const U&, const U&)>& combine) const;
     /**
      * Changes the capacity of the collection to the new size.  If new size > current size, then only the capacity will 
      * be modified.  However, if new size < current size, then both capacity and size will shrink and be equal, and data 
      * will be lost
      */
     virtual void resize(int newSize)= 0;
+    /**
+     * Dispatches the list as a generic list.  Lists with their own dispatcher overload must override this function.
+     * @param   dispatcher  Dispatcher to pass the list to
+     */
+    virtual void accept(Dispatcher<T>& dispatcher) const;
 
 protected:
     /**
@@ -124,42 +206,85 @@ protected:
      * @param   listSize    Size of the list
      */
     inline void rangeCheck(int index, int listSize) const;
+
+private:
+    /**
+     * Cursor looking up each index with at
+     */
+    class IndexCursor : public Cursor {
+    public:
+        explicit IndexCursor(const List<T>* list) : list(list), index(0) {
+        }
+        virtual const T* next() {
+            return index < list->size() ? &list->at(index++) : NULL;
+        }
+
+    private:
+        const List<T>* list;
+        int index;
+    };
 };
 
 template <class T>
 List<T>::~List() {
 }
 
+template <class T>
+bool List<T>::add(int index, T&& elem) {
+    return add(index, static_cast<const T&>(elem));
+}
+
+template <class T> template <class... Args>
+bool List<T>::emplaceAt(int index, Args&&... args) {
+    return add(index, T(std::forward<Args>(args)...));
+}
+
+template <class T>
+void List<T>::set(int index, T&& elem) throw(out_of_range) {
+    set(index, static_cast<const T&>(elem));
+}
+
+template <class T>
+void List<T>::eachReverse(const function<void (const T&)>& lambda) const {
+    for(int i= this->size() - 1; i >= 0; i--) {
+        lambda(at(i));
+    }
+}
+
+template <class T>
+typename List<T>::Cursor* List<T>::cursor() const {
+    return new IndexCursor(this);
+}
+
 template <class T> template <class U>
 U List<T>::foldLeft(const U& initialValue, const function<U (const U&, const T&)>& lambda) const {
-    U accum;
-    int listSize= this->size();
-    for(int i= 0; i < listSize; i++) {
-        if (i == 0) {
-            accum= lambda(initialValue, get(i));
-        } else {
-            accum= lambda(accum, get(i));
-        }
-    }
+    U accum(initialValue);
 
+    this->each([&accum, &lambda](const T& elem) -> void {
+        accum= lambda(accum, elem);
+    });
     return accum;
 }
 
 template <class T> template <class U>
 U List<T>::foldRight(const U& initialValue, const function<U (const T&, const U&)>& lambda) const {
-    U accum;
-    int end= this->size() - 1;
-    for(int i= end; i >= 0; i--) {
-        if (i == end) {
-            accum= lambda(get(i), initialValue);
-        } else {
-            accum= lambda(get(i), accum);
-        }
-    }
+    U accum(initialValue);
 
+    eachReverse([&accum, &lambda](const T& elem) -> void {
+        accum= lambda(elem, accum);
+    });
     return accum;
 }
 
+template <class T> template <class U>
+U List<T>::reduce(const U& identity, const function<U (const U&, const T&)>& op, const function<U (const U&, const U&)>&) const {
+    return foldLeft(identity, op);
+}
+
+template <class T>
+void List<T>::accept(Dispatcher<T>& dispatcher) const {
+    dispatcher.dispatch(*this);
+}
 
 template <class T>
 void List<T>::rangeCheck(int index, int listSize) const {
@@ -173,4 +298,6 @@ void List<T>::rangeCheck(int index, int listSize) const {
 }   //namespace collections
 }   //namespace etsai
 
+#include "src/DispatcherImpl.h"
+
 #endif
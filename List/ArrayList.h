@@ -2,14 +2,23 @@
 #define ETSAI_COLLECTIONS_LIST_ARRAYLIST_H
 
 #include "List.h"
+#include "src/Snapshot.h"
+#include "src/WorkStealingPool.h"
 
 #include <algorithm>
+#include <limits>
+#include <atomic>
 #include <functional>
 #include <initializer_list>
 #include <memory>
+#include <mutex>
 #include <new>
 #include <sstream>
 #include <string.h>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace etsai {
 namespace collections {
@@ -18,20 +27,44 @@ namespace list {
 using namespace std;
 
 /**
- * Implements the List abstract class with an array
+ * Implements the List abstract class with an array.  The Instrumentation policy, NoInstrumentation by default,
+ * is told about every reallocation of the array and every element shifted by an insertion or removal.
+ *
+ * In copy-on-write mode, copies made by the copy constructor, clone, subList, and reverse share the array with the
+ * list they were made from instead of copying it.  The array is reference counted, and whichever list is modified
+ * first while it is shared copies it.  A reversed copy reads the shared array from the back until it is modified.
+ *
+ * In incremental resize mode, an append that outgrows the array allocates the larger array but does not move the 
+ * elements into it.  Both arrays are kept, and every following append or set moves a few more elements over, so no 
+ * single call pays for copying the whole list.  Reads look up an element in whichever array holds it.  Any other 
+ * modification finishes moving the elements first.  The arrays are still created with new[] and freed with 
+ * delete[], so element types with non-trivial constructors or destructors pay for those in the call that grows 
+ * the array and the call that empties the old one; SegmentedArrayList avoids both.
  * @author etsai
  */
-template <class T>
-class ArrayList : public collections::List<T> {
+template <class T, class Instrumentation>
+class ArrayList : public collections::List<T>, private Instrumentation {
 public:
+    /**
+     * Gives the ArrayList type holding elements of type U, with the same instrumentation
+     */
+    template <class U>
+    struct rebind {
+        typedef ArrayList<U, Instrumentation> other;
+    };
+
     /**
      * Constructs an empty ArrayList with 0 size and capacity
      */
     ArrayList();
     /**
-     * Copy constructor
+     * Copy constructor.  In copy-on-write mode the copy shares the list's array and mode.
      */
-    ArrayList(const ArrayList<T>& list);
+    ArrayList(const ArrayList<T, Instrumentation>& list);
+    /**
+     * Move constructor.  The moved from list is left empty with 0 capacity.
+     */
+    ArrayList(ArrayList<T, Instrumentation>&& list);
     /**
      * Constructs an ArrayList containing the elements in the initialier list.  This constructor provides a quick way to 
      * create an ArrayList with the elements already known
@@ -63,61 +96,352 @@ public:
      * Class destructor to free up the allocated memory for the list
      */
     ~ArrayList();
+    /**
+     * Move assignment.  The moved from list is left empty with 0 capacity.
+     */
+    ArrayList<T, Instrumentation>& operator =(ArrayList<T, Instrumentation>&& list);
 
     virtual ArrayList* clone() const;
     virtual bool equals(initializer_list<T> collection) const;
     virtual bool equals(const Collection<T>* collection) const;
     virtual int size() const;
     virtual int capacity() const;
+    /**
+     * Get the heap bytes owned by the list.  A list backed by a mapped snapshot owns no element storage until 
+     * it is modified.  An array shared in copy-on-write mode is counted in full by every list sharing it.
+     * @return  Bytes owned by the list
+     */
+    virtual MemoryUsage memoryUsage() const;
     virtual bool isEmpty() const;
     virtual bool contains(const T& elem) const;
     virtual void each(const function<void (const T&)>& lambda) const;
     virtual void each(const function<void (T&)>& lambda);
+    virtual void eachReverse(const function<void (const T&)>& lambda) const;
     virtual bool exists(const function<bool (const T&)>& lambda) const;
     virtual bool forAll(const function<bool (const T&)>& lambda) const;
 
     virtual bool remove(const T& elem); 
     virtual bool add(const T& elem);
+    virtual bool add(T&& elem);
     /**
      * This function will reset the size back to 0, but will not change the capacity
      */
     virtual void clear();
-    virtual ArrayList<T>* reverse() const;
-    virtual ArrayList<T>* reverse(bool mutate);
+    /**
+     * Creates a reversed copy.  In copy-on-write mode the copy is a view reading this list's array from the back, 
+     * and is only copied into its own array when it is modified.
+     */
+    virtual ArrayList<T, Instrumentation>* reverse() const;
+    virtual ArrayList<T, Instrumentation>* reverse(bool mutate);
     virtual void resize(int newSize);
     virtual bool add(int index, const T& elem);
+    virtual bool add(int index, T&& elem);
     virtual void set(int index, const T& elem) throw(out_of_range);
+    virtual void set(int index, T&& elem) throw(out_of_range);
     virtual T minus(int index) throw(out_of_range);
     virtual T get(int index) const throw(out_of_range);
-    virtual ArrayList<T>* subList(int startIndex, int endIndex) const throw(out_of_range, invalid_argument);
+    virtual const T& at(int index) const throw(out_of_range);
+    /**
+     * Creates a list of the elements in [startIndex, endIndex].  In copy-on-write mode the new list shares the 
+     * range of this list's array and is only copied into its own array when it is modified.
+     */
+    virtual ArrayList<T, Instrumentation>* subList(int startIndex, int endIndex) const throw(out_of_range, invalid_argument);
+    virtual void accept(Dispatcher<T>& dispatcher) const;
+    /**
+     * Transforms the list from T list -> U list.  Evaluates [f(a0), f(a1), ..., f(an)].  The new list is allocated 
+     * with the list's size up front and filled directly.
+     * @param   transform   Lambda that maps T -> U
+     * @return  List of the transformed values
+     */
+    template <class U>
+    typename rebind<U>::other map(const function<U (const T&)>& transform) const;
+
+    /**
+     * Parallel version of each.  The list is split into chunks of contiguous elements that are processed 
+     * concurrently on a work stealing pool, so the lambda must be safe to call from several threads and elements 
+     * are not visited in order.  Lists no longer than the grain size are processed on the calling thread.
+     * @param   lambda      Lambda function to evaluate each element with
+     * @param   grain       Number of elements per chunk, or 0 to pick one from the list size and thread count
+     * @param   pool        Pool to run the chunks on, or NULL to use WorkStealingPool::global()
+     */
+    void parEach(const function<void (const T&)>& lambda, int grain= 0, WorkStealingPool* pool= NULL) const;
+    /**
+     * Parallel version of each that allows the elements to be modified
+     * @param   lambda      Lambda function to evaluate each element with
+     * @param   grain       Number of elements per chunk, or 0 to pick one from the list size and thread count
+     * @param   pool        Pool to run the chunks on, or NULL to use WorkStealingPool::global()
+     * @see parEach
+     */
+    void parEach(const function<void (T&)>& lambda, int grain= 0, WorkStealingPool* pool= NULL);
+    /**
+     * Parallel version of map.  Each chunk writes its transformed values directly into the new list.
+     * @param   transform   Lambda that maps T -> U
+     * @param   grain       Number of elements per chunk, or 0 to pick one from the list size and thread count
+     * @param   pool        Pool to run the chunks on, or NULL to use WorkStealingPool::global()
+     * @return  List of the transformed values, in the same order as the list
+     */
+    template <class U>
+    typename rebind<U>::other parMap(const function<U (const T&)>& transform, int grain= 0, WorkStealingPool* pool= NULL) const;
+    /**
+     * Parallel version of exists.  Once any chunk finds a matching element, the other chunks stop at their next 
+     * element.
+     * @param   predicate   Lambda that maps T -> bool
+     * @param   grain       Number of elements per chunk, or 0 to pick one from the list size and thread count
+     * @param   pool        Pool to run the chunks on, or NULL to use WorkStealingPool::global()
+     * @return  True if at least one element satisfies the predicate
+     */
+    bool parExists(const function<bool (const T&)>& predicate, int grain= 0, WorkStealingPool* pool= NULL) const;
+    /**
+     * Parallel version of forAll.  Once any chunk finds an element failing the predicate, the other chunks stop at 
+     * their next element.
+     * @param   predicate   Lambda that maps T -> bool
+     * @param   grain       Number of elements per chunk, or 0 to pick one from the list size and thread count
+     * @param   pool        Pool to run the chunks on, or NULL to use WorkStealingPool::global()
+     * @return  True if all elements satisfy the predicate
+     */
+    bool parForAll(const function<bool (const T&)>& predicate, int grain= 0, WorkStealingPool* pool= NULL) const;
+    /**
+     * Counts the elements satisfying the predicate in parallel
+     * @param   predicate   Lambda that maps T -> bool
+     * @param   grain       Number of elements per chunk, or 0 to pick one from the list size and thread count
+     * @param   pool        Pool to run the chunks on, or NULL to use WorkStealingPool::global()
+     * @return  Number of elements satisfying the predicate
+     */
+    int parCount(const function<bool (const T&)>& predicate, int grain= 0, WorkStealingPool* pool= NULL) const;
+    /**
+     * Reduces the list with an associative operation in parallel.  Each chunk is folded left from the identity with 
+     * op, then the partial results are joined in list order with combine, so combine need not be commutative.
+     * @param   identity    Value that leaves any other value unchanged when combined with it
+     * @param   op          Lambda that folds an element into a partial result, mapping (U, T) -> U
+     * @param   combine     Associative lambda joining two partial results, mapping (U, U) -> U
+     * @param   grain       Number of elements per chunk, or 0 to pick one from the list size and thread count
+     * @param   pool        Pool to run the chunks on, or NULL to use WorkStealingPool::global()
+     * @return  Reduced value, or the identity if the list is empty
+     */
+    template <class U>
+    U reduce(const U& identity, const function<U (const U&, const T&)>& op, const function<U (const U&, const U&)>& combine, 
+            int grain= 0, WorkStealingPool* pool= NULL) const;
+
+    /**
+     * Writes the elements to a binary snapshot file.  The file holds a versioned header, with a checksum of the 
+     * elements, followed by the raw element array aligned to 64 bytes.  Only lists of trivially copyable types can 
+     * be saved.
+     * @param   path    Path of the file to write
+     * @throws  runtime_error   If the file cannot be written
+     */
+    void save(const string& path) const;
+    /**
+     * Reads a list from a snapshot file written by save, verifying its checksum.  The elements are copied into 
+     * memory owned by the list.
+     * @param   path    Path of the file to read
+     * @return  List holding the saved elements
+     * @throws  runtime_error   If the file cannot be read or does not hold a valid snapshot of this list type
+     */
+    static ArrayList<T, Instrumentation> load(const string& path);
+    /**
+     * Maps a snapshot file written by save into memory and reads the elements directly from the mapped pages.  
+     * Loading takes constant time, pages are only read when first touched, and processes mapping the same file 
+     * share the page cache.  The list is read-only while mapped: the first modification copies the elements into 
+     * memory owned by the list and releases the mapping.
+     * @param   path    Path of the file to map
+     * @param   verify  True if the checksum should be checked, which reads the whole file
+     * @return  List backed by the mapped file
+     * @throws  runtime_error   If the file cannot be mapped or does not hold a valid snapshot of this list type
+     */
+    static ArrayList<T, Instrumentation> loadMapped(const string& path, bool verify= false);
+    /**
+     * Returns true if the elements are read from a mapped snapshot file
+     * @return  True if the list is backed by a mapping
+     */
+    bool isMapped() const;
+    /**
+     * Turns copy-on-write mode on or off.  Copies made in copy-on-write mode start in the mode too.  Lists sharing 
+     * an array may be used from different threads, the same as lists with their own arrays.
+     * @param   enabled     True if copies should share the array until one of them is modified
+     */
+    void setCopyOnWrite(bool enabled);
+    /**
+     * Returns true if the list is in copy-on-write mode
+     */
+    bool isCopyOnWrite() const;
+    /**
+     * Turns incremental resize mode on or off.  Copies made by the copy constructor start in the mode too.  Turning 
+     * the mode off does not finish a resize in progress; the next modification other than an append or set does.
+     * @param   enabled     True if growing the array should spread moving the elements over the following appends
+     */
+    void setIncrementalResize(bool enabled);
+    /**
+     * Returns true if the list is in incremental resize mode
+     */
+    bool isIncrementalResize() const;
+    /**
+     * Returns true if an incremental resize is moving elements into the new array
+     */
+    bool isResizing() const;
+    /**
+     * Get the operation counts recorded by the instrumentation policy
+     * @return  Counters for this list
+     */
+    OperationCounters counters() const;
+
 private:
+    template <class U, class I>
+    friend class ArrayList;
+    template <class U, class Compare, class I>
+    friend class set::SortedSet;
+
     template <class U>
     struct ListDeleter {
+        ListDeleter(bool owned= true) : owned(owned) {
+        }
         void operator()(U* p) {
-            delete [] p;
+            if (owned) {
+                delete [] p;
+            }
         }
+
+        bool owned;
     };
 
+    /**
+     * Smallest number of elements worth handing to another thread
+     */
+    static const int MIN_GRAIN= 4096;
+    /**
+     * Number of elements an append or set moves into the new array during an incremental resize.  Appends grow the 
+     * array by half, so moving more than 2 per append finishes before the next resize is needed.
+     */
+    static const int MIGRATION_STEP= 4;
+
+    /**
+     * Runs the body over [0, list size) in chunks on the pool.  Small lists run on the calling thread without 
+     * touching the pool, so the global pool is not started for them.
+     * @param   grain   Number of elements per chunk, or 0 to pick one
+     * @param   pool    Pool to run the chunks on, or NULL for the global pool
+     * @param   body    Lambda taking the [begin, end) bounds of a chunk
+     */
+    void parallelFor(int grain, WorkStealingPool* pool, const function<void (int, int)>& body) const;
+    /**
+     * Inserts the element at the index, shifting the following elements back by moving them.  The element is 
+     * copied or moved into its slot depending on how it is passed.
+     * @param   index   Index to insert the element at
+     * @param   elem    Element to insert
+     * @return  True if the list was modified
+     */
+    template <class U>
+    bool insert(int index, U&& elem);
+    /**
+     * Get the element at the index, reading the array from the back if the list is a reversed view and from the 
+     * old array if an incremental resize has not moved it yet
+     */
+    const T& element(int index) const;
+    /**
+     * Get the slot holding the element at the index during an incremental resize.  The list must not be reversed.
+     */
+    T& slot(int index);
+    /**
+     * Returns true if the element lives in one of the list's arrays
+     */
+    bool aliases(const T& elem) const;
+    /**
+     * Grows the array to the new capacity, moving the elements in one pass or, in incremental resize mode, leaving 
+     * them in the old array to be moved by later calls
+     */
+    void expand(int newCapacity);
+    /**
+     * Moves up to count elements from the old array of an incremental resize into the new one, and frees the old 
+     * array once it is empty
+     */
+    void migrate(int count);
+    /**
+     * Frees the old array of an incremental resize without moving the rest of its elements
+     */
+    void release();
+    /**
+     * Takes ownership of a newly allocated array, holding it through a reference count in copy-on-write mode so 
+     * copies can share it
+     */
+    void adopt(T* array);
+    /**
+     * Makes the list the only user of its array, copying the elements out of a mapped snapshot or an array shared 
+     * with other lists, puts a reversed view's elements in order, and finishes an incremental resize.  Must be 
+     * called before the elements are modified.  When the array is not shared, an acquire fence pairs with the release of the last other list's 
+     * reference, so that list's reads finish before this list writes.
+     */
+    void detach();
+    void save(const string& path, snapshot::Kind kind) const;
+    static ArrayList<T, Instrumentation> loadMapped(const string& path, snapshot::Kind kind, bool verify);
+
     int listCapacity, listSize;
     unique_ptr<T, ListDeleter<T>> elements;
     unique_ptr<T> defaultValue;
+    shared_ptr<snapshot::Mapping> mapping;
+    /** Owner of the array in copy-on-write mode, shared with the copies using it; elements does not own it then */
+    shared_ptr<T> buffer;
+    bool copyOnWrite;
+    /** True if the array holds the elements in reverse order */
+    bool reversed;
+    bool incremental;
+    /** Array an incremental resize is moving elements out of, or NULL if no resize is in progress */
+    unique_ptr<T, ListDeleter<T>> previous;
+    /** Owner of the old array if it was reference counted in copy-on-write mode */
+    shared_ptr<T> previousBuffer;
+    /** Elements in [migrated, previousSize) are still in the old array; all others are in elements */
+    int migrated, previousSize, previousCapacity;
 };
 
-template <class T>
-ArrayList<T>::ArrayList() : ArrayList(0) {
+template <class T, class Instrumentation>
+const int ArrayList<T, Instrumentation>::MIN_GRAIN;
+template <class T, class Instrumentation>
+const int ArrayList<T, Instrumentation>::MIGRATION_STEP;
+
+template <class T, class Instrumentation>
+ArrayList<T, Instrumentation>::ArrayList() : ArrayList(0) {
 }
 
-template <class T>
-ArrayList<T>::ArrayList(const ArrayList<T>& list) : ArrayList(list.listCapacity) {
+template <class T, class Instrumentation>
+ArrayList<T, Instrumentation>::ArrayList(const ArrayList<T, Instrumentation>& list) : 
+        ArrayList(list.copyOnWrite && list.previous == NULL ? 0 : list.listCapacity) {
     listSize= list.listSize;
-    copy(list.elements.get(), list.elements.get() + list.listSize, elements.get());
+    incremental= list.incremental;
+    if (list.copyOnWrite && list.previous == NULL) {
+        copyOnWrite= true;
+        listCapacity= list.listCapacity;
+        elements= unique_ptr<T, ListDeleter<T>>(list.elements.get(), ListDeleter<T>(false));
+        mapping= list.mapping;
+        buffer= list.buffer;
+        reversed= list.reversed;
+    } else {
+        if (list.reversed) {
+            reverse_copy(list.elements.get(), list.elements.get() + list.listSize, elements.get());
+        } else if (list.previous != NULL) {
+            for(int i= 0; i < listSize; i++) {
+                elements.get()[i]= list.element(i);
+            }
+        } else {
+            copy(list.elements.get(), list.elements.get() + list.listSize, elements.get());
+        }
+        setCopyOnWrite(list.copyOnWrite);
+    }
     if (list.defaultValue != NULL) {
         defaultValue.reset(new T(*(list.defaultValue)));
     }
 }
 
-template <class T>
-ArrayList<T>::ArrayList(initializer_list<T> elements) : ArrayList(elements.size()) {
+template <class T, class Instrumentation>
+ArrayList<T, Instrumentation>::ArrayList(ArrayList<T, Instrumentation>&& list) : listCapacity(list.listCapacity), listSize(list.listSize), 
+        elements(std::move(list.elements)), defaultValue(std::move(list.defaultValue)), mapping(std::move(list.mapping)), 
+        buffer(std::move(list.buffer)), copyOnWrite(list.copyOnWrite), reversed(list.reversed), incremental(list.incremental), 
+        previous(std::move(list.previous)), previousBuffer(std::move(list.previousBuffer)), migrated(list.migrated), 
+        previousSize(list.previousSize), previousCapacity(list.previousCapacity) {
+    list.listCapacity= 0;
+    list.listSize= 0;
+    list.reversed= false;
+    list.migrated= list.previousSize= list.previousCapacity= 0;
+}
+
+template <class T, class Instrumentation>
+ArrayList<T, Instrumentation>::ArrayList(initializer_list<T> elements) : ArrayList(elements.size()) {
     int offset(0);
 
     for(auto &elem: elements) {
@@ -127,52 +451,79 @@ ArrayList<T>::ArrayList(initializer_list<T> elements) : ArrayList(elements.size(
     listSize= listCapacity;
 }
 
-template <class T>
-ArrayList<T>::ArrayList(initializer_list<T> elements, const T& defaultValue) : ArrayList(elements) {
+template <class T, class Instrumentation>
+ArrayList<T, Instrumentation>::ArrayList(initializer_list<T> elements, const T& defaultValue) : ArrayList(elements) {
     this->defaultValue.reset(new T(defaultValue));
 }
 
-template <class T>
-ArrayList<T>::ArrayList(int initialCapacity) : listCapacity(initialCapacity), listSize(0), elements(NULL, ListDeleter<T>()) {
+template <class T, class Instrumentation>
+ArrayList<T, Instrumentation>::ArrayList(int initialCapacity) : listCapacity(initialCapacity), listSize(0), elements(NULL, ListDeleter<T>()), 
+        copyOnWrite(false), reversed(false), incremental(false), previous(NULL, ListDeleter<T>()), migrated(0), previousSize(0), 
+        previousCapacity(0) {
     if (initialCapacity > 0) {
         elements.reset(new T[listCapacity]);
     }
 }
 
-template <class T>
-ArrayList<T>::ArrayList(int initialSize, const T& defaultValue) : ArrayList(initialSize) {
+template <class T, class Instrumentation>
+ArrayList<T, Instrumentation>::ArrayList(int initialSize, const T& defaultValue) : ArrayList(initialSize) {
     this->defaultValue.reset(new T(defaultValue));
     fill(elements.get(), elements.get() + initialSize, defaultValue);
 }
 
-template <class T>
-ArrayList<T>::~ArrayList() {
+template <class T, class Instrumentation>
+ArrayList<T, Instrumentation>::~ArrayList() {
     elements.reset(NULL);
     defaultValue.reset(NULL);
 }
 
-template <class T>
-ArrayList<T>* ArrayList<T>::clone() const {
-    return new ArrayList<T>(*this);
+template <class T, class Instrumentation>
+ArrayList<T, Instrumentation>& ArrayList<T, Instrumentation>::operator =(ArrayList<T, Instrumentation>&& list) {
+    if (this != &list) {
+        listCapacity= list.listCapacity;
+        listSize= list.listSize;
+        elements= std::move(list.elements);
+        defaultValue= std::move(list.defaultValue);
+        mapping= std::move(list.mapping);
+        buffer= std::move(list.buffer);
+        copyOnWrite= list.copyOnWrite;
+        reversed= list.reversed;
+        incremental= list.incremental;
+        previous= std::move(list.previous);
+        previousBuffer= std::move(list.previousBuffer);
+        migrated= list.migrated;
+        previousSize= list.previousSize;
+        previousCapacity= list.previousCapacity;
+        list.listCapacity= 0;
+        list.listSize= 0;
+        list.reversed= false;
+        list.migrated= list.previousSize= list.previousCapacity= 0;
+    }
+    return *this;
+}
+
+template <class T, class Instrumentation>
+ArrayList<T, Instrumentation>* ArrayList<T, Instrumentation>::clone() const {
+    return new ArrayList<T, Instrumentation>(*this);
 }
 
-template <class T>
-bool ArrayList<T>::equals(initializer_list<T> collection) const {
+template <class T, class Instrumentation>
+bool ArrayList<T, Instrumentation>::equals(initializer_list<T> collection) const {
     int index= 0;
     bool equal= true;
 
     if (collection.size() != listSize) {
         return false;
     }
-    for(auto elem: collection) {
-        equal= equal && (elements.get()[index] == elem);
+    for(const T& elem: collection) {
+        equal= equal && (element(index) == elem);
         index++;
     }
     return equal;
 }
 
-template <class T>
-bool ArrayList<T>::equals(const Collection<T>* collection) const {
+template <class T, class Instrumentation>
+bool ArrayList<T, Instrumentation>::equals(const Collection<T>* collection) const {
     int index= 0;
     bool equal= true;
 
@@ -180,127 +531,134 @@ bool ArrayList<T>::equals(const Collection<T>* collection) const {
         return false;
     }
     collection->each([&equal, &index, this](const T& elem) -> void {
-        equal= equal && (elements.get()[index] == elem);
+        equal= equal && (element(index) == elem);
         index++;
     });
     return equal;
 }
 
-template <class T>
-int ArrayList<T>::size() const {
+template <class T, class Instrumentation>
+int ArrayList<T, Instrumentation>::size() const {
     return listSize;
 }
 
-template <class T>
-int ArrayList<T>::capacity() const {
+template <class T, class Instrumentation>
+int ArrayList<T, Instrumentation>::capacity() const {
     return listCapacity;
 }
 
-template <class T>
-bool ArrayList<T>::isEmpty() const {
+template <class T, class Instrumentation>
+MemoryUsage ArrayList<T, Instrumentation>::memoryUsage() const {
+    MemoryUsage usage;
+
+    if (!isMapped()) {
+        usage.payload= listSize * sizeof(T);
+        usage.slack= (listCapacity - listSize) * sizeof(T);
+    }
+    usage.overhead+= previousCapacity * sizeof(T);
+    if (defaultValue != NULL) {
+        usage.overhead+= sizeof(T);
+    }
+    return usage;
+}
+
+template <class T, class Instrumentation>
+bool ArrayList<T, Instrumentation>::isEmpty() const {
     return listSize == 0;
 }
 
-template <class T>
-bool ArrayList<T>::contains(const T& elem) const {
-    bool found= false;
-    function<void (int)> iterate= [this, &iterate, &found, &elem](int index) -> void {
-        if (index >= listSize || found) {
-            return;
+template <class T, class Instrumentation>
+bool ArrayList<T, Instrumentation>::contains(const T& elem) const {
+    for(int i= 0; i < listSize; i++) {
+        if (element(i) == elem) {
+            return true;
         }
-        found= elements.get()[index] == elem;
-        iterate(index + 1);
-    };
-    iterate(0);
-    return found;
+    }
+    return false;
 }
 
-template <class T>
-void ArrayList<T>::each(const function<void (const T&)>& lambda) const {
-    function<void (int)> iterate= [this, &iterate, &lambda](int index) -> void {
-        if (index >= listSize) {
-            return;
-        }
-        lambda(elements.get()[index]);
-        iterate(index + 1);
-    };
-    iterate(0);
+template <class T, class Instrumentation>
+void ArrayList<T, Instrumentation>::each(const function<void (const T&)>& lambda) const {
+    for(int i= 0; i < listSize; i++) {
+        lambda(element(i));
+    }
 }
 
-template <class T>
-void ArrayList<T>::each(const function<void (T&)>& lambda) {
-    function<void (int)> iterate= [this, &iterate, &lambda](int index) -> void {
-        if (index >= listSize) {
-            return;
-        }
-        lambda(elements.get()[index]);
-        iterate(index + 1);
-    };
-    iterate(0);
+template <class T, class Instrumentation>
+void ArrayList<T, Instrumentation>::each(const function<void (T&)>& lambda) {
+    detach();
+    for(int i= 0; i < listSize; i++) {
+        lambda(elements.get()[i]);
+    }
+}
+
+template <class T, class Instrumentation>
+void ArrayList<T, Instrumentation>::eachReverse(const function<void (const T&)>& lambda) const {
+    for(int i= listSize - 1; i >= 0; i--) {
+        lambda(element(i));
+    }
 }
 
-template <class T>
-bool ArrayList<T>::exists(const function<bool (const T&)>& lambda) const {
+template <class T, class Instrumentation>
+bool ArrayList<T, Instrumentation>::exists(const function<bool (const T&)>& lambda) const {
     bool doesExist= false;
 
     for(int i= 0; !doesExist && i < listSize; i++) {
-        doesExist= doesExist || lambda(elements.get()[i]);
+        doesExist= doesExist || lambda(element(i));
     }
 
     return doesExist;
 }
 
-template <class T>
-bool ArrayList<T>::forAll(const function<bool (const T&)>& lambda) const {
+template <class T, class Instrumentation>
+bool ArrayList<T, Instrumentation>::forAll(const function<bool (const T&)>& lambda) const {
     bool allTrue= true;
 
     for(int i= 0; allTrue && i < listSize; i++) {
-        allTrue= allTrue && lambda(elements.get()[i]);
+        allTrue= allTrue && lambda(element(i));
     }
 
     return allTrue;
 }
 
-template <class T>
-bool ArrayList<T>::remove(const T& elem) {
-    int elemIndex= -1;
-    function<void (int)> iterate= [this, &iterate, &elemIndex, &elem](int index) -> void {
-        if (index >= listSize) {
-            return;
-        }
-        if (elements.get()[index] == elem) {
-            elemIndex= index;
-            return;
+template <class T, class Instrumentation>
+bool ArrayList<T, Instrumentation>::remove(const T& elem) {
+    for(int i= 0; i < listSize; i++) {
+        if (element(i) == elem) {
+            minus(i);
+            return true;
         }
-        iterate(index + 1);
-    };
-    iterate(0);
-    if (elemIndex == -1) {
-        return false;
     }
-    minus(elemIndex);
-    return true;
+    return false;
 }
 
-template <class T>
-bool ArrayList<T>::add(const T& elem) {
+template <class T, class Instrumentation>
+bool ArrayList<T, Instrumentation>::add(const T& elem) {
     return add(listSize, elem);
 }
 
-template <class T>
-void ArrayList<T>::clear() {
+template <class T, class Instrumentation>
+bool ArrayList<T, Instrumentation>::add(T&& elem) {
+    return insert(listSize, std::move(elem));
+}
+
+template <class T, class Instrumentation>
+void ArrayList<T, Instrumentation>::clear() {
     listSize= 0;
+    release();
 }
 
-template <class T>
-void ArrayList<T>::resize(int newSize) {
+template <class T, class Instrumentation>
+void ArrayList<T, Instrumentation>::resize(int newSize) {
+    detach();
     if (newSize > 0 && newSize != listCapacity) {
         int offset= newSize - listCapacity;
 
         T *newList= new T[newSize];
         if (listCapacity > 0) {
             int maxLen= (offset < 0 ? newSize : listCapacity);
-            copy(elements.get(), elements.get() + maxLen, newList);
+            std::move(elements.get(), elements.get() + maxLen, newList);
+            this->reallocated(min(maxLen, listSize));
         }
         if (offset > 0) {
             if (defaultValue != NULL) {
@@ -309,14 +667,21 @@ void ArrayList<T>::resize(int newSize) {
         } else {
             listSize= newSize;
         }
-        elements.reset(newList);
+        adopt(newList);
         listCapacity= newSize;
     }
 }
 
-template <class T>
-ArrayList<T>* ArrayList<T>::reverse() const {
-    ArrayList<T>* copy= (defaultValue == NULL) ? new ArrayList<T>(listCapacity) : new ArrayList<T>(listCapacity, *defaultValue);
+template <class T, class Instrumentation>
+ArrayList<T, Instrumentation>* ArrayList<T, Instrumentation>::reverse() const {
+    if (copyOnWrite && previous == NULL) {
+        ArrayList<T, Instrumentation>* view= new ArrayList<T, Instrumentation>(*this);
+
+        view->reversed= !reversed;
+        return view;
+    }
+
+    ArrayList<T, Instrumentation>* copy= (defaultValue == NULL) ? new ArrayList<T, Instrumentation>(listCapacity) : new ArrayList<T, Instrumentation>(listCapacity, *defaultValue);
 
     int rIndex= listSize - 1;
     copy->listSize= listSize;
@@ -327,32 +692,48 @@ ArrayList<T>* ArrayList<T>::reverse() const {
     return copy;
 }
 
-template <class T>
-ArrayList<T>* ArrayList<T>::reverse(bool mutate) {
+template <class T, class Instrumentation>
+ArrayList<T, Instrumentation>* ArrayList<T, Instrumentation>::reverse(bool mutate) {
     if (!mutate) {
         return reverse();
     }
 
     int half= listSize / 2;
+    detach();
     for(int i= 0; i < half; i++) {
-        int pairIndex= listSize - 1 - i;
-        T tmp= get(i);
-
-        set(i, get(pairIndex));
-        set(pairIndex, tmp);
+        swap(elements.get()[i], elements.get()[listSize - 1 - i]);
     }
     return NULL;
 }
 
-template <class T>
-bool ArrayList<T>::add(int index, const T& elem) {
+template <class T, class Instrumentation>
+bool ArrayList<T, Instrumentation>::add(int index, const T& elem) {
+    if (aliases(elem)) {
+        T copy(elem);
+        return insert(index, std::move(copy));
+    }
+    return insert(index, elem);
+}
+
+template <class T, class Instrumentation>
+bool ArrayList<T, Instrumentation>::add(int index, T&& elem) {
+    return insert(index, std::move(elem));
+}
+
+template <class T, class Instrumentation> template <class U>
+bool ArrayList<T, Instrumentation>::insert(int index, U&& elem) {
     bool status= true;
 
     try {
+        if (previous != NULL && index >= listSize) {
+            migrate(MIGRATION_STEP);
+        } else {
+            detach();
+        }
         if (elements == NULL) {
             resize(8);
         } else if (index >= listCapacity) {
-            resize((index + 1) * 1.5);
+            expand((index + 1) * 1.5);
         }
         if (index >= listSize) {
             if (defaultValue != NULL) {
@@ -363,39 +744,71 @@ bool ArrayList<T>::add(int index, const T& elem) {
             if (listSize + 1 > listCapacity) {
                 resize(listCapacity * 1.5);
             }
-            copy_backward(elements.get() + index, elements.get() + listSize, elements.get() + listSize + 1);
+            move_backward(elements.get() + index, elements.get() + listSize, elements.get() + listSize + 1);
+            this->shifted(listSize - index);
             listSize++;
         }
-        elements.get()[index]= elem;
+        elements.get()[index]= std::forward<U>(elem);
     } catch (std::bad_alloc& ex) {
         status= false;
     }
     return status;
 }
 
-template <class T>
-void ArrayList<T>::set(int index, const T& elem) throw(out_of_range) {
+template <class T, class Instrumentation>
+void ArrayList<T, Instrumentation>::set(int index, const T& elem) throw(out_of_range) {
     this->rangeCheck(index, listSize);
+    if (aliases(elem)) {
+        T copy(elem);
+        set(index, std::move(copy));
+        return;
+    }
+    if (previous != NULL) {
+        migrate(MIGRATION_STEP);
+        slot(index)= elem;
+        return;
+    }
+    detach();
     elements.get()[index]= elem;
 }
 
-template <class T>
-T ArrayList<T>::minus(int index) throw(out_of_range) {
+template <class T, class Instrumentation>
+void ArrayList<T, Instrumentation>::set(int index, T&& elem) throw(out_of_range) {
+    this->rangeCheck(index, listSize);
+    if (previous != NULL) {
+        migrate(MIGRATION_STEP);
+        slot(index)= std::move(elem);
+        return;
+    }
+    detach();
+    elements.get()[index]= std::move(elem);
+}
+
+template <class T, class Instrumentation>
+T ArrayList<T, Instrumentation>::minus(int index) throw(out_of_range) {
     this->rangeCheck(index, listSize);
-    T elem= elements.get()[index];
+    detach();
+    T elem(std::move(elements.get()[index]));
     listSize--;
-    copy(elements.get() + index + 1, elements.get() + listSize + 1, elements.get() + index);
+    std::move(elements.get() + index + 1, elements.get() + listSize + 1, elements.get() + index);
+    this->shifted(listSize - index);
     return elem;
 }
 
-template <class T>
-T ArrayList<T>::get(int index) const throw(out_of_range) {
+template <class T, class Instrumentation>
+T ArrayList<T, Instrumentation>::get(int index) const throw(out_of_range) {
     this->rangeCheck(index, listSize);
-    return elements.get()[index];
+    return element(index);
 }
 
-template <class T>
-ArrayList<T>* ArrayList<T>::subList(int startIndex, int endIndex) const throw(out_of_range, invalid_argument) {
+template <class T, class Instrumentation>
+const T& ArrayList<T, Instrumentation>::at(int index) const throw(out_of_range) {
+    this->rangeCheck(index, listSize);
+    return element(index);
+}
+
+template <class T, class Instrumentation>
+ArrayList<T, Instrumentation>* ArrayList<T, Instrumentation>::subList(int startIndex, int endIndex) const throw(out_of_range, invalid_argument) {
     if (startIndex < 0 || startIndex >= listSize || endIndex < 0 || endIndex >= listSize) {
         stringstream msg;
         msg << "Indices (" << startIndex << ", " << endIndex << ") lay outside the range [0, " << listSize - 1 << "]";
@@ -406,12 +819,351 @@ ArrayList<T>* ArrayList<T>::subList(int startIndex, int endIndex) const throw(ou
         throw invalid_argument(msg.str());
     }
         
-    ArrayList<T>* newList= new ArrayList<T>(endIndex - startIndex + 1);
-    copy(elements.get() + startIndex, elements.get() + endIndex + 1, newList->elements.get());
+    if (copyOnWrite && previous == NULL) {
+        ArrayList<T, Instrumentation>* view= new ArrayList<T, Instrumentation>();
+        int first= reversed ? listSize - 1 - endIndex : startIndex;
+
+        view->elements= unique_ptr<T, ListDeleter<T>>(elements.get() + first, ListDeleter<T>(false));
+        view->listSize= view->listCapacity= endIndex - startIndex + 1;
+        view->mapping= mapping;
+        view->buffer= buffer;
+        view->copyOnWrite= true;
+        view->reversed= reversed;
+        return view;
+    }
+
+    ArrayList<T, Instrumentation>* newList= new ArrayList<T, Instrumentation>(endIndex - startIndex + 1);
+    if (reversed) {
+        reverse_copy(elements.get() + listSize - 1 - endIndex, elements.get() + listSize - startIndex, newList->elements.get());
+    } else if (previous != NULL) {
+        for(int i= startIndex; i <= endIndex; i++) {
+            newList->elements.get()[i - startIndex]= element(i);
+        }
+    } else {
+        copy(elements.get() + startIndex, elements.get() + endIndex + 1, newList->elements.get());
+    }
     newList->listSize= newList->listCapacity;
     return newList;
 }
 
+template <class T, class Instrumentation>
+void ArrayList<T, Instrumentation>::accept(Dispatcher<T>& dispatcher) const {
+    dispatcher.dispatch(*this);
+}
+
+template <class T, class Instrumentation> template <class U>
+typename ArrayList<T, Instrumentation>::template rebind<U>::other ArrayList<T, Instrumentation>::map(const function<U (const T&)>& transform) const {
+    typename rebind<U>::other mapped(listSize);
+
+    for(int i= 0; i < listSize; i++) {
+        mapped.elements.get()[i]= transform(element(i));
+    }
+    mapped.listSize= listSize;
+    mapped.setCopyOnWrite(copyOnWrite);
+    return mapped;
+}
+
+template <class T, class Instrumentation>
+void ArrayList<T, Instrumentation>::parallelFor(int grain, WorkStealingPool* pool, const function<void (int, int)>& body) const {
+    if (listSize <= (grain > 0 ? grain : MIN_GRAIN)) {
+        body(0, listSize);
+        return;
+    }
+    if (pool == NULL) {
+        pool= &WorkStealingPool::global();
+    }
+    if (grain <= 0) {
+        grain= max(MIN_GRAIN, listSize / (8 * (pool->threads() + 1)));
+    }
+    pool->parallelFor(0, listSize, grain, body);
+}
+
+template <class T, class Instrumentation>
+void ArrayList<T, Instrumentation>::parEach(const function<void (const T&)>& lambda, int grain, WorkStealingPool* pool) const {
+    parallelFor(grain, pool, [this, &lambda](int begin, int end) -> void {
+        for(int i= begin; i < end; i++) {
+            lambda(element(i));
+        }
+    });
+}
+
+template <class T, class Instrumentation>
+void ArrayList<T, Instrumentation>::parEach(const function<void (T&)>& lambda, int grain, WorkStealingPool* pool) {
+    detach();
+
+    T* values= elements.get();
+
+    parallelFor(grain, pool, [values, &lambda](int begin, int end) -> void {
+        for(int i= begin; i < end; i++) {
+            lambda(values[i]);
+        }
+    });
+}
+
+template <class T, class Instrumentation> template <class U>
+typename ArrayList<T, Instrumentation>::template rebind<U>::other ArrayList<T, Instrumentation>::parMap(const function<U (const T&)>& transform, int grain, WorkStealingPool* pool) const {
+    typename rebind<U>::other mapped(listSize);
+    U* mappedValues= mapped.elements.get();
+
+    parallelFor(grain, pool, [this, mappedValues, &transform](int begin, int end) -> void {
+        for(int i= begin; i < end; i++) {
+            mappedValues[i]= transform(element(i));
+        }
+    });
+    mapped.listSize= listSize;
+    mapped.setCopyOnWrite(copyOnWrite);
+    return mapped;
+}
+
+template <class T, class Instrumentation>
+bool ArrayList<T, Instrumentation>::parExists(const function<bool (const T&)>& predicate, int grain, WorkStealingPool* pool) const {
+    atomic<bool> found(false);
+
+    parallelFor(grain, pool, [this, &predicate, &found](int begin, int end) -> void {
+        for(int i= begin; i < end && !found.load(memory_order_relaxed); i++) {
+            if (predicate(element(i))) {
+                found.store(true, memory_order_relaxed);
+            }
+        }
+    });
+    return found.load();
+}
+
+template <class T, class Instrumentation>
+bool ArrayList<T, Instrumentation>::parForAll(const function<bool (const T&)>& predicate, int grain, WorkStealingPool* pool) const {
+    return !parExists([&predicate](const T& elem) -> bool {
+        return !predicate(elem);
+    }, grain, pool);
+}
+
+template <class T, class Instrumentation>
+int ArrayList<T, Instrumentation>::parCount(const function<bool (const T&)>& predicate, int grain, WorkStealingPool* pool) const {
+    atomic<int> total(0);
+
+    parallelFor(grain, pool, [this, &predicate, &total](int begin, int end) -> void {
+        int count= 0;
+
+        for(int i= begin; i < end; i++) {
+            if (predicate(element(i))) {
+                count++;
+            }
+        }
+        total.fetch_add(count);
+    });
+    return total.load();
+}
+
+template <class T, class Instrumentation> template <class U>
+U ArrayList<T, Instrumentation>::reduce(const U& identity, const function<U (const U&, const T&)>& op, const function<U (const U&, const U&)>& combine, 
+        int grain, WorkStealingPool* pool) const {
+    vector<pair<int, U>> partials;
+    mutex partialsLock;
+
+    parallelFor(grain, pool, [this, &identity, &op, &partials, &partialsLock](int begin, int end) -> void {
+        U accum(identity);
+
+        for(int i= begin; i < end; i++) {
+            accum= op(accum, element(i));
+        }
+        lock_guard<mutex> lock(partialsLock);
+        partials.push_back(pair<int, U>(begin, std::move(accum)));
+    });
+    if (partials.empty()) {
+        return identity;
+    }
+    sort(partials.begin(), partials.end(), [](const pair<int, U>& left, const pair<int, U>& right) -> bool {
+        return left.first < right.first;
+    });
+
+    U result(std::move(partials[0].second));
+    for(size_t i= 1; i < partials.size(); i++) {
+        result= combine(result, partials[i].second);
+    }
+    return result;
+}
+
+template <class T, class Instrumentation>
+void ArrayList<T, Instrumentation>::save(const string& path) const {
+    save(path, snapshot::LIST);
+}
+
+template <class T, class Instrumentation>
+ArrayList<T, Instrumentation> ArrayList<T, Instrumentation>::load(const string& path) {
+    ArrayList<T, Instrumentation> mapped(loadMapped(path, snapshot::LIST, true));
+    ArrayList<T, Instrumentation> list(mapped.listSize);
+
+    copy(mapped.elements.get(), mapped.elements.get() + mapped.listSize, list.elements.get());
+    list.listSize= mapped.listSize;
+    return list;
+}
+
+template <class T, class Instrumentation>
+ArrayList<T, Instrumentation> ArrayList<T, Instrumentation>::loadMapped(const string& path, bool verify) {
+    return loadMapped(path, snapshot::LIST, verify);
+}
+
+template <class T, class Instrumentation>
+bool ArrayList<T, Instrumentation>::isMapped() const {
+    return mapping != NULL;
+}
+
+template <class T, class Instrumentation>
+void ArrayList<T, Instrumentation>::setCopyOnWrite(bool enabled) {
+    copyOnWrite= enabled;
+    if (copyOnWrite && buffer == NULL && mapping == NULL && elements != NULL) {
+        buffer.reset(elements.get(), default_delete<T[]>());
+        elements.get_deleter().owned= false;
+    }
+}
+
+template <class T, class Instrumentation>
+bool ArrayList<T, Instrumentation>::isCopyOnWrite() const {
+    return copyOnWrite;
+}
+
+template <class T, class Instrumentation>
+void ArrayList<T, Instrumentation>::setIncrementalResize(bool enabled) {
+    incremental= enabled;
+}
+
+template <class T, class Instrumentation>
+bool ArrayList<T, Instrumentation>::isIncrementalResize() const {
+    return incremental;
+}
+
+template <class T, class Instrumentation>
+bool ArrayList<T, Instrumentation>::isResizing() const {
+    return previous != NULL;
+}
+
+template <class T, class Instrumentation>
+void ArrayList<T, Instrumentation>::save(const string& path, snapshot::Kind kind) const {
+    static_assert(is_trivially_copyable<T>::value, "Only lists of trivially copyable types can be saved");
+
+    if (reversed || previous != NULL) {
+        ArrayList<T, Instrumentation> ordered(*this);
+
+        ordered.detach();
+        ordered.save(path, kind);
+        return;
+    }
+    snapshot::write(path, kind, elements.get(), listSize, sizeof(T), alignof(T));
+}
+
+template <class T, class Instrumentation>
+ArrayList<T, Instrumentation> ArrayList<T, Instrumentation>::loadMapped(const string& path, snapshot::Kind kind, bool verify) {
+    static_assert(is_trivially_copyable<T>::value, "Only lists of trivially copyable types can be loaded");
+    static_assert(alignof(T) <= snapshot::Header::ALIGNMENT, "Element alignment exceeds the snapshot alignment");
+
+    shared_ptr<snapshot::Mapping> mapping(new snapshot::Mapping(path, kind, sizeof(T), alignof(T), verify));
+    ArrayList<T, Instrumentation> list;
+
+    if (mapping->count() > (uint64_t) numeric_limits<int>::max()) {
+        throw runtime_error("Snapshot " + path + " holds more elements than a list can index");
+    }
+    list.listCapacity= list.listSize= mapping->count();
+    list.elements= unique_ptr<T, ListDeleter<T>>(static_cast<T*>(const_cast<void*>(mapping->data())), ListDeleter<T>(false));
+    list.mapping= mapping;
+    return list;
+}
+
+template <class T, class Instrumentation>
+OperationCounters ArrayList<T, Instrumentation>::counters() const {
+    return Instrumentation::counters();
+}
+
+template <class T, class Instrumentation>
+const T& ArrayList<T, Instrumentation>::element(int index) const {
+    int position= reversed ? listSize - 1 - index : index;
+
+    return position < migrated || position >= previousSize ? elements.get()[position] : previous.get()[position];
+}
+
+template <class T, class Instrumentation>
+T& ArrayList<T, Instrumentation>::slot(int index) {
+    return index < migrated || index >= previousSize ? elements.get()[index] : previous.get()[index];
+}
+
+template <class T, class Instrumentation>
+bool ArrayList<T, Instrumentation>::aliases(const T& elem) const {
+    return (&elem >= elements.get() && &elem < elements.get() + listSize) || 
+            (&elem >= previous.get() && &elem < previous.get() + previousSize);
+}
+
+template <class T, class Instrumentation>
+void ArrayList<T, Instrumentation>::expand(int newCapacity) {
+    if (!incremental || listSize == 0) {
+        resize(newCapacity);
+        return;
+    }
+
+    migrate(previousSize);
+    T* newList= new T[newCapacity];
+    this->reallocated(listSize);
+    previous= std::move(elements);
+    previousBuffer= std::move(buffer);
+    previousSize= listSize;
+    previousCapacity= listCapacity;
+    migrated= 0;
+    adopt(newList);
+    listCapacity= newCapacity;
+}
+
+template <class T, class Instrumentation>
+void ArrayList<T, Instrumentation>::migrate(int count) {
+    int end= min(previousSize, migrated + count);
+
+    std::move(previous.get() + migrated, previous.get() + end, elements.get() + migrated);
+    migrated= end;
+    if (migrated == previousSize) {
+        release();
+    }
+}
+
+template <class T, class Instrumentation>
+void ArrayList<T, Instrumentation>::release() {
+    if (previous != NULL) {
+        previous.reset();
+        previousBuffer.reset();
+        migrated= previousSize= previousCapacity= 0;
+    }
+}
+
+template <class T, class Instrumentation>
+void ArrayList<T, Instrumentation>::adopt(T* array) {
+    if (copyOnWrite) {
+        buffer.reset(array, default_delete<T[]>());
+        elements= unique_ptr<T, ListDeleter<T>>(array, ListDeleter<T>(false));
+    } else {
+        elements= unique_ptr<T, ListDeleter<T>>(array, ListDeleter<T>());
+        buffer.reset();
+    }
+}
+
+template <class T, class Instrumentation>
+void ArrayList<T, Instrumentation>::detach() {
+    if (previous != NULL) {
+        migrate(previousSize);
+    }
+    if (mapping != NULL || buffer.use_count() > 1) {
+        T* owned= listCapacity > 0 ? new T[listCapacity] : NULL;
+
+        if (reversed) {
+            reverse_copy(elements.get(), elements.get() + listSize, owned);
+        } else {
+            copy(elements.get(), elements.get() + listSize, owned);
+        }
+        adopt(owned);
+        mapping.reset();
+    } else {
+        atomic_thread_fence(memory_order_acquire);
+        if (reversed) {
+            std::reverse(elements.get(), elements.get() + listSize);
+        }
+    }
+    reversed= false;
+}
+
 }
 }
 }
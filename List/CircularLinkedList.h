@@ -5,29 +5,43 @@
 
 #include <initializer_list>
 #include <memory>
+#include <new>
 #include <sstream>
 #include <stdexcept>
+#include <utility>
 #include <iostream>
+#include <vector>
 
 namespace etsai {
 namespace collections {
 namespace list {
 
+using std::bad_alloc;
 using std::initializer_list;
 using std::invalid_argument;
 using std::out_of_range;
 using std::shared_ptr;
 using std::stringstream;
 using std::unique_ptr;
+using std::vector;
 
 /**
  * Implements the List abstract with a circular linked list.  For a circular linked list, the size will 
- * always equal the capacity
+ * always equal the capacity.  The Instrumentation policy, NoInstrumentation by default, is told about every
+ * link followed to reach a node.
  * @author etsai
  */
-template <class T>
-class CircularLinkedList : public collections::List<T> {
+template <class T, class Instrumentation>
+class CircularLinkedList : public collections::List<T>, private Instrumentation {
 public:
+    /**
+     * Gives the CircularLinkedList type holding elements of type U, with the same instrumentation
+     */
+    template <class U>
+    struct rebind {
+        typedef CircularLinkedList<U, Instrumentation> other;
+    };
+
     /**
      * Default constructor that creates an empty list
      */
@@ -35,7 +49,11 @@ public:
     /**
      * Copy constructor
      */
-    CircularLinkedList(const CircularLinkedList<T>& list);
+    CircularLinkedList(const CircularLinkedList<T, Instrumentation>& list);
+    /**
+     * Move constructor.  The moved from list is left empty.
+     */
+    CircularLinkedList(CircularLinkedList<T, Instrumentation>&& list);
     /**
      * Creates an empty list, that will fill gaps with the default value during expansions
      * @param   defaultValue    Default value to fill gaps
@@ -63,46 +81,145 @@ public:
     virtual bool equals(const Collection<T>* collection) const;
     virtual int size() const;
     virtual int capacity() const;
+    /**
+     * Get the heap bytes owned by the list.  Every element lives in its own node, and each node carries a link 
+     * and the reference counts of the shared_ptr it is owned by, which are reported as overhead.
+     * @return  Bytes owned by the list
+     */
+    virtual MemoryUsage memoryUsage() const;
     virtual bool isEmpty() const;
     virtual bool contains(const T& elem) const;
     virtual void each(const function<void (const T&)>& lambda) const;
     virtual void each(const function<void (T&)>& lambda);
+    /**
+     * Applies the lambda to each element, from the last element to the first.  The nodes only link forward, so the 
+     * addresses of the elements are gathered in one pass and visited backwards, taking linear time.
+     * @param   lambda      Lambda function to evaluate each element with
+     */
+    virtual void eachReverse(const function<void (const T&)>& lambda) const;
     virtual bool exists(const function<bool (const T&)>& lambda) const;
     virtual bool forAll(const function<bool (const T&)>& lambda) const;
 
     virtual bool remove(const T& elem); 
     virtual bool add(const T& elem);
+    virtual bool add(T&& elem);
+    /**
+     * Constructs an element from the arguments directly inside a new node at the end of the list
+     * @param   args    Arguments to pass to the element's constructor
+     * @return  True if the list was modified
+     */
+    template <class... Args>
+    bool emplace(Args&&... args);
     /**
      * This function will delete all memory allocated for the list nodes, resetting the size and capacity back to 0
      */
     virtual void clear();
-    virtual CircularLinkedList<T>* reverse() const;
-    virtual CircularLinkedList<T>* reverse(bool mutate);
+    virtual CircularLinkedList<T, Instrumentation>* reverse() const;
+    virtual CircularLinkedList<T, Instrumentation>* reverse(bool mutate);
     virtual void resize(int newSize);
     virtual bool add(int index, const T& elem);
+    virtual bool add(int index, T&& elem);
+    /**
+     * Constructs an element from the arguments directly inside a new node at the specific position
+     * @param   index   Index to insert the element at
+     * @param   args    Arguments to pass to the element's constructor
+     * @return  True if the list was modified
+     */
+    template <class... Args>
+    bool emplaceAt(int index, Args&&... args);
     virtual void set(int index, const T& elem) throw(out_of_range);
+    virtual void set(int index, T&& elem) throw(out_of_range);
     virtual T minus(int index) throw(out_of_range);
     virtual T get(int index) const throw(out_of_range);
-    virtual CircularLinkedList<T>* subList(int startIndex, int endIndex) const throw(out_of_range, invalid_argument);
+    virtual const T& at(int index) const throw(out_of_range);
+    virtual CircularLinkedList<T, Instrumentation>* subList(int startIndex, int endIndex) const throw(out_of_range, invalid_argument);
+    virtual void accept(Dispatcher<T>& dispatcher) const;
+    /**
+     * Creates a cursor that follows the links between nodes, so stepping to the next element is O(1)
+     * @return  Cursor over the list
+     */
+    virtual typename List<T>::Cursor* cursor() const;
+    /**
+     * Get the operation counts recorded by the instrumentation policy
+     * @return  Counters for this list
+     */
+    OperationCounters counters() const;
+    /**
+     * Transforms the list from T list -> U list.  Evaluates [f(a0), f(a1), ..., f(an)].  The new list is built by 
+     * appending nodes directly rather than through the virtual add function.
+     * @param   transform   Lambda that maps T -> U
+     * @return  List of the transformed values
+     */
+    template <class U>
+    typename rebind<U>::other map(const function<U (const T&)>& transform) const;
 
 private:
+    template <class U, class I>
+    friend class CircularLinkedList;
+
     template <class U>
     struct Node {
+        template <class... Args>
+        Node(Args&&... args) : value(std::forward<Args>(args)...) {
+        }
+
         U value;
         shared_ptr<Node<U>> next;
     };
+    /**
+     * Cursor following the next links from the head of the list
+     */
+    class NodeCursor : public List<T>::Cursor {
+    public:
+        NodeCursor(const Node<T>* head, int remaining) : node(head), remaining(remaining) {
+        }
+        virtual const T* next() {
+            if (remaining == 0) {
+                return NULL;
+            }
+
+            const T* value= &node->value;
+            node= node->next.get();
+            remaining--;
+            return value;
+        }
+
+    private:
+        const Node<T>* node;
+        int remaining;
+    };
+
+    /**
+     * Links a new node after the tail, constructing its element from the arguments
+     * @param   args    Arguments to pass to the element's constructor
+     */
+    template <class... Args>
+    inline void append(Args&&... args);
+    /**
+     * Links a new node at the index, constructing its element from the arguments.  Indices past the end of the 
+     * list are filled with the default value.
+     * @param   index   Index to insert the element at
+     * @param   args    Arguments to pass to the element's constructor
+     * @return  True if the list was modified
+     */
+    template <class... Args>
+    bool insert(int index, Args&&... args);
+    /**
+     * Get the node at the index, which must be in range
+     */
+    Node<T>* node(int index) const;
     
     int listSize;
     shared_ptr<Node<T>> tail;
     unique_ptr<T> defaultValue;
 };
 
-template <class T>
-CircularLinkedList<T>::CircularLinkedList() : listSize(0) {
+template <class T, class Instrumentation>
+CircularLinkedList<T, Instrumentation>::CircularLinkedList() : listSize(0) {
 }
 
-template <class T>
-CircularLinkedList<T>::CircularLinkedList(const CircularLinkedList<T>& list) {
+template <class T, class Instrumentation>
+CircularLinkedList<T, Instrumentation>::CircularLinkedList(const CircularLinkedList<T, Instrumentation>& list) {
     listSize= 0;
     list.each([this](const T& elem) -> void {
         this->add(elem);
@@ -112,37 +229,43 @@ CircularLinkedList<T>::CircularLinkedList(const CircularLinkedList<T>& list) {
     }
 }
 
-template <class T>
-CircularLinkedList<T>::CircularLinkedList(const T& defaultValue) : CircularLinkedList() {
+template <class T, class Instrumentation>
+CircularLinkedList<T, Instrumentation>::CircularLinkedList(CircularLinkedList<T, Instrumentation>&& list) : listSize(list.listSize), tail(std::move(list.tail)), 
+        defaultValue(std::move(list.defaultValue)) {
+    list.listSize= 0;
+}
+
+template <class T, class Instrumentation>
+CircularLinkedList<T, Instrumentation>::CircularLinkedList(const T& defaultValue) : CircularLinkedList() {
     this->defaultValue.reset(new T(defaultValue));
 }
 
-template <class T>
-CircularLinkedList<T>::CircularLinkedList(initializer_list<T> collection) : CircularLinkedList() {
+template <class T, class Instrumentation>
+CircularLinkedList<T, Instrumentation>::CircularLinkedList(initializer_list<T> collection) : CircularLinkedList() {
     for(auto &elem: collection) {
         add(elem);
     }
 }
 
-template <class T>
-CircularLinkedList<T>::CircularLinkedList(initializer_list<T> collection, const T& defaultValue) : CircularLinkedList(collection) {
+template <class T, class Instrumentation>
+CircularLinkedList<T, Instrumentation>::CircularLinkedList(initializer_list<T> collection, const T& defaultValue) : CircularLinkedList(collection) {
     this->defaultValue.reset(new T(defaultValue));
 }
 
-template <class T>
-CircularLinkedList<T>::~CircularLinkedList() {
+template <class T, class Instrumentation>
+CircularLinkedList<T, Instrumentation>::~CircularLinkedList() {
     clear();
     defaultValue.reset();
 }
 
-template <class T>
-CircularLinkedList<T>* CircularLinkedList<T>::clone() const {
-    return new CircularLinkedList<T>(*this);
+template <class T, class Instrumentation>
+CircularLinkedList<T, Instrumentation>* CircularLinkedList<T, Instrumentation>::clone() const {
+    return new CircularLinkedList<T, Instrumentation>(*this);
 }
 
 
-template <class T>
-bool CircularLinkedList<T>::equals(initializer_list<T> collection) const {
+template <class T, class Instrumentation>
+bool CircularLinkedList<T, Instrumentation>::equals(initializer_list<T> collection) const {
     if (listSize != collection.size()) {
         return false;
     }
@@ -152,13 +275,13 @@ bool CircularLinkedList<T>::equals(initializer_list<T> collection) const {
 
     shared_ptr<Node<T>> ptr= tail->next;
     auto it= collection.begin();
-    for(it; *it == ptr->value && it != collection.end(); it++, ptr= ptr->next);
+    for(; it != collection.end() && *it == ptr->value; it++, ptr= ptr->next);
 
     return it == collection.end();
 }
 
-template <class T>
-bool CircularLinkedList<T>::equals(const Collection<T>* collection) const {
+template <class T, class Instrumentation>
+bool CircularLinkedList<T, Instrumentation>::equals(const Collection<T>* collection) const {
     if (listSize != collection->size()) {
         return false;
     }
@@ -176,23 +299,35 @@ bool CircularLinkedList<T>::equals(const Collection<T>* collection) const {
     return equal;
 }
 
-template <class T>
-int CircularLinkedList<T>::size() const {
+template <class T, class Instrumentation>
+int CircularLinkedList<T, Instrumentation>::size() const {
     return listSize;
 }
 
-template <class T>
-int CircularLinkedList<T>::capacity() const {
+template <class T, class Instrumentation>
+int CircularLinkedList<T, Instrumentation>::capacity() const {
     return listSize;
 }
 
-template <class T>
-bool CircularLinkedList<T>::isEmpty() const {
+template <class T, class Instrumentation>
+MemoryUsage CircularLinkedList<T, Instrumentation>::memoryUsage() const {
+    /** Size of the control block make_shared places in front of each node: a vtable pointer and two counts */
+    const size_t CONTROL_BLOCK= sizeof(void*) + 2 * sizeof(int);
+    MemoryUsage usage(listSize * sizeof(T), 0, listSize * (sizeof(Node<T>) - sizeof(T) + CONTROL_BLOCK));
+
+    if (defaultValue != NULL) {
+        usage.overhead+= sizeof(T);
+    }
+    return usage;
+}
+
+template <class T, class Instrumentation>
+bool CircularLinkedList<T, Instrumentation>::isEmpty() const {
     return tail == NULL;
 }
 
-template <class T>
-bool CircularLinkedList<T>::contains(const T& elem) const {
+template <class T, class Instrumentation>
+bool CircularLinkedList<T, Instrumentation>::contains(const T& elem) const {
     bool contain= false;
 
     each([&contain,&elem](const T& myElem) -> void {
@@ -201,32 +336,47 @@ bool CircularLinkedList<T>::contains(const T& elem) const {
     return contain;
 }
 
-template <class T>
-void CircularLinkedList<T>::each(const function<void (const T&)>& lambda) const {
+template <class T, class Instrumentation>
+void CircularLinkedList<T, Instrumentation>::each(const function<void (const T&)>& lambda) const {
     if (tail != NULL) {
-        shared_ptr<Node<T>> ptr= tail->next;
+        Node<T>* head= tail->next.get();
+        Node<T>* ptr= head;
 
         do {
             lambda(ptr->value);
-            ptr= ptr->next;
-        } while(ptr != tail->next);
+            ptr= ptr->next.get();
+        } while(ptr != head);
     }
 }
 
-template <class T>
-void CircularLinkedList<T>::each(const function<void (T&)>& lambda) {
+template <class T, class Instrumentation>
+void CircularLinkedList<T, Instrumentation>::each(const function<void (T&)>& lambda) {
     if (tail != NULL) {
-        shared_ptr<Node<T>> ptr= tail->next;
+        Node<T>* head= tail->next.get();
+        Node<T>* ptr= head;
 
         do {
             lambda(ptr->value);
-            ptr= ptr->next;
-        } while(ptr != tail->next);
+            ptr= ptr->next.get();
+        } while(ptr != head);
     }
 }
 
-template <class T>
-bool CircularLinkedList<T>::exists(const function<bool (const T&)>& lambda) const {
+template <class T, class Instrumentation>
+void CircularLinkedList<T, Instrumentation>::eachReverse(const function<void (const T&)>& lambda) const {
+    vector<const T*> values;
+
+    values.reserve(listSize);
+    each([&values](const T& elem) -> void {
+        values.push_back(&elem);
+    });
+    for(auto it= values.rbegin(); it != values.rend(); it++) {
+        lambda(**it);
+    }
+}
+
+template <class T, class Instrumentation>
+bool CircularLinkedList<T, Instrumentation>::exists(const function<bool (const T&)>& lambda) const {
     if (this->isEmpty()) {
         return false;
     }
@@ -241,8 +391,8 @@ bool CircularLinkedList<T>::exists(const function<bool (const T&)>& lambda) cons
     return doesExist;
 }
 
-template <class T>
-bool CircularLinkedList<T>::forAll(const function<bool (const T&)>& lambda) const {
+template <class T, class Instrumentation>
+bool CircularLinkedList<T, Instrumentation>::forAll(const function<bool (const T&)>& lambda) const {
     if (this->isEmpty()) {
         return false;
     }
@@ -257,54 +407,45 @@ bool CircularLinkedList<T>::forAll(const function<bool (const T&)>& lambda) cons
     return allTrue;
 }
 
-template <class T>
-bool CircularLinkedList<T>::remove(const T& elem) {
+template <class T, class Instrumentation>
+bool CircularLinkedList<T, Instrumentation>::remove(const T& elem) {
     if (tail != NULL) {
-        shared_ptr<Node<T>> ptr(tail->next), prev(tail);
-
-        do {
-            prev= ptr;
-            ptr= ptr->next;
-        } while(ptr != tail->next && !(ptr->value == elem));
+        Node<T>* ptr= tail->next.get();
 
-        if (ptr->value == elem) {
-            if (ptr == tail) {
-                tail= prev;
+        for(int i= 0; i < listSize; i++, ptr= ptr->next.get()) {
+            if (ptr->value == elem) {
+                minus(i);
+                return true;
             }
-            prev->next= ptr->next;
-            listSize--;
-            ptr.reset();
-            return true;
         }
     }
     return false;
 }
 
-template <class T>
-bool CircularLinkedList<T>::add(const T& elem) {
+template <class T, class Instrumentation>
+bool CircularLinkedList<T, Instrumentation>::add(const T& elem) {
+    return emplace(elem);
+}
+
+template <class T, class Instrumentation>
+bool CircularLinkedList<T, Instrumentation>::add(T&& elem) {
+    return emplace(std::move(elem));
+}
+
+template <class T, class Instrumentation> template <class... Args>
+bool CircularLinkedList<T, Instrumentation>::emplace(Args&&... args) {
     bool modified= true;
 
     try {
-        shared_ptr<Node<T>> ptr(new Node<T>());
-        ptr->value= elem;
-
-        if (tail == NULL) {
-            tail= ptr;
-            tail->next= tail;
-        } else {
-            ptr->next= tail->next;
-            tail->next= ptr;
-            tail= ptr;
-        }
-        listSize++;
+        append(std::forward<Args>(args)...);
     } catch (bad_alloc& ex) {
         modified= false;
     }
     return modified;
 }
 
-template <class T>
-void CircularLinkedList<T>::clear() {
+template <class T, class Instrumentation>
+void CircularLinkedList<T, Instrumentation>::clear() {
     shared_ptr<Node<T>> ptr;
 
     if (tail != NULL) {
@@ -312,14 +453,15 @@ void CircularLinkedList<T>::clear() {
             tail->next= ptr->next;
             ptr.reset();
         }
+        tail->next.reset();
         tail.reset();
     }
     listSize= 0;
 }
 
-template <class T>
-CircularLinkedList<T>* CircularLinkedList<T>::reverse() const {
-    CircularLinkedList<T>* copy= (defaultValue == NULL) ? new CircularLinkedList<T>() : new CircularLinkedList<T>(*defaultValue);
+template <class T, class Instrumentation>
+CircularLinkedList<T, Instrumentation>* CircularLinkedList<T, Instrumentation>::reverse() const {
+    CircularLinkedList<T, Instrumentation>* copy= (defaultValue == NULL) ? new CircularLinkedList<T, Instrumentation>() : new CircularLinkedList<T, Instrumentation>(*defaultValue);
 
     each([&copy](const T& elem) -> void {
         copy->add(0, elem);
@@ -327,36 +469,30 @@ CircularLinkedList<T>* CircularLinkedList<T>::reverse() const {
     return copy;
 }
 
-template <class T>
-CircularLinkedList<T>* CircularLinkedList<T>::reverse(bool mutate) {
+template <class T, class Instrumentation>
+CircularLinkedList<T, Instrumentation>* CircularLinkedList<T, Instrumentation>::reverse(bool mutate) {
     if (!mutate) {
         return reverse();
     }
 
     if (tail != NULL) {
-        shared_ptr<Node<T>>* elements= new shared_ptr<Node<T>>[listSize];
-        shared_ptr<Node<T>> ptr= tail->next;
-        int index= 0;
-    
+        shared_ptr<Node<T>> head(tail->next), prev(tail), ptr(head);
+
         do {
-            elements[index]= ptr;
-            ptr= ptr->next;
-            index++;
-        } while(ptr != tail->next);
-        for(int rIndex= listSize - 1; rIndex > 0; rIndex--) {
-            elements[rIndex]->next= elements[rIndex - 1];
-        }
-        elements[0]->next= elements[listSize - 1];
-        tail= elements[0];
+            shared_ptr<Node<T>> next(ptr->next);
 
-        delete []elements;
+            ptr->next= prev;
+            prev= ptr;
+            ptr= next;
+        } while(ptr != head);
+        tail= head;
     }
 
     return NULL;
 }
 
-template <class T>
-void CircularLinkedList<T>::resize(int newSize) {
+template <class T, class Instrumentation>
+void CircularLinkedList<T, Instrumentation>::resize(int newSize) {
     if (newSize < listSize) {
         shared_ptr<Node<T>> ptr(tail->next);
 
@@ -379,8 +515,23 @@ void CircularLinkedList<T>::resize(int newSize) {
 }
 
 
-template <class T>
-bool CircularLinkedList<T>::add(int index, const T& elem) {
+template <class T, class Instrumentation>
+bool CircularLinkedList<T, Instrumentation>::add(int index, const T& elem) {
+    return insert(index, elem);
+}
+
+template <class T, class Instrumentation>
+bool CircularLinkedList<T, Instrumentation>::add(int index, T&& elem) {
+    return insert(index, std::move(elem));
+}
+
+template <class T, class Instrumentation> template <class... Args>
+bool CircularLinkedList<T, Instrumentation>::emplaceAt(int index, Args&&... args) {
+    return insert(index, std::forward<Args>(args)...);
+}
+
+template <class T, class Instrumentation> template <class... Args>
+bool CircularLinkedList<T, Instrumentation>::insert(int index, Args&&... args) {
     bool modified= true;
 
     if (index >= listSize) {
@@ -392,9 +543,8 @@ bool CircularLinkedList<T>::add(int index, const T& elem) {
         shared_ptr<Node<T>> fillerNodes= NULL, it;
         try {
             for(int i= listSize; i < index; i++) {
-                shared_ptr<Node<T>> node(new Node<T>());
+                shared_ptr<Node<T>> node(std::make_shared<Node<T>>(filler));
 
-                node->value= filler;
                 if (fillerNodes == NULL) {
                     fillerNodes= node;
                 } else {
@@ -402,8 +552,7 @@ bool CircularLinkedList<T>::add(int index, const T& elem) {
                 }
                 it= node;
             }
-            shared_ptr<Node<T>> end(new Node<T>());
-            end->value= elem;
+            shared_ptr<Node<T>> end(std::make_shared<Node<T>>(std::forward<Args>(args)...));
             if (fillerNodes == NULL) {
                 fillerNodes= end;
             } else {
@@ -431,9 +580,9 @@ bool CircularLinkedList<T>::add(int index, const T& elem) {
             shared_ptr<Node<T>> ptr(tail->next), prev(tail);
 
             for(int i= 0; i < index; i++,prev=ptr,ptr= ptr->next);
+            this->hopped(index);
     
-            shared_ptr<Node<T>> newNode(new Node<T>());
-            newNode->value= elem;
+            shared_ptr<Node<T>> newNode(std::make_shared<Node<T>>(std::forward<Args>(args)...));
             newNode->next= ptr;
             prev->next= newNode;
             listSize++;
@@ -444,40 +593,55 @@ bool CircularLinkedList<T>::add(int index, const T& elem) {
     return modified;
 }
 
-template <class T>
-void CircularLinkedList<T>::set(int index, const T& elem) throw(out_of_range) {
+template <class T, class Instrumentation>
+void CircularLinkedList<T, Instrumentation>::set(int index, const T& elem) throw(out_of_range) {
     this->rangeCheck(index, listSize);
+    node(index)->value= elem;
+}
 
-    shared_ptr<Node<T>> ptr(tail->next);
-    for(int i= 0; i < index; i++,ptr= ptr->next);
-    ptr->value= elem;
+template <class T, class Instrumentation>
+void CircularLinkedList<T, Instrumentation>::set(int index, T&& elem) throw(out_of_range) {
+    this->rangeCheck(index, listSize);
+    node(index)->value= std::move(elem);
 }
 
-template <class T>
-T CircularLinkedList<T>::minus(int index) throw(out_of_range) {
+template <class T, class Instrumentation>
+T CircularLinkedList<T, Instrumentation>::minus(int index) throw(out_of_range) {
     this->rangeCheck(index, listSize);
 
     shared_ptr<Node<T>> ptr(tail->next), prev(tail);
-    for(int i= 0; i < index; i++,ptr= tail,tail= tail->next);
+    for(int i= 0; i < index; i++,prev= ptr,ptr= ptr->next);
+    this->hopped(index);
 
-    T value= ptr->value;
-    prev->next= ptr->next;
-    ptr.reset();
+    T value(std::move(ptr->value));
+    if (listSize == 1) {
+        tail->next.reset();
+        tail.reset();
+    } else {
+        prev->next= ptr->next;
+        if (ptr == tail) {
+            tail= prev;
+        }
+    }
+    listSize--;
 
     return value;
 }
 
-template <class T>
-T CircularLinkedList<T>::get(int index) const throw(out_of_range) {
+template <class T, class Instrumentation>
+T CircularLinkedList<T, Instrumentation>::get(int index) const throw(out_of_range) {
     this->rangeCheck(index, listSize);
+    return node(index)->value;
+}
 
-    shared_ptr<Node<T>> ptr(tail->next);
-    for(int i= 0; i < index; i++,ptr= ptr->next);
-    return ptr->value;
+template <class T, class Instrumentation>
+const T& CircularLinkedList<T, Instrumentation>::at(int index) const throw(out_of_range) {
+    this->rangeCheck(index, listSize);
+    return node(index)->value;
 }
 
-template <class T>
-CircularLinkedList<T>* CircularLinkedList<T>::subList(int startIndex, int endIndex) const throw(out_of_range, invalid_argument) {
+template <class T, class Instrumentation>
+CircularLinkedList<T, Instrumentation>* CircularLinkedList<T, Instrumentation>::subList(int startIndex, int endIndex) const throw(out_of_range, invalid_argument) {
     if (startIndex < 0 || startIndex >= listSize || endIndex < 0 || endIndex >= listSize) {
         stringstream msg;
         msg << "Indices (" << startIndex << ", " << endIndex << ") lay outside the range [0, " << listSize - 1 << "]";
@@ -488,11 +652,12 @@ CircularLinkedList<T>* CircularLinkedList<T>::subList(int startIndex, int endInd
         throw invalid_argument(msg.str());
     }
 
-    CircularLinkedList<T> *newList= new CircularLinkedList<T>();
+    CircularLinkedList<T, Instrumentation> *newList= new CircularLinkedList<T, Instrumentation>();
 
     shared_ptr<Node<T>> ptr(tail->next);
     int i;
     for(i= 0; i < startIndex; i++, ptr= ptr->next);
+    this->hopped(startIndex);
     for(i; i <= endIndex; i++, ptr= ptr->next) {
         newList->add(ptr->value);
     }
@@ -500,6 +665,62 @@ CircularLinkedList<T>* CircularLinkedList<T>::subList(int startIndex, int endInd
     return newList;
 }
 
+template <class T, class Instrumentation>
+void CircularLinkedList<T, Instrumentation>::accept(Dispatcher<T>& dispatcher) const {
+    dispatcher.dispatch(*this);
+}
+
+template <class T, class Instrumentation>
+typename List<T>::Cursor* CircularLinkedList<T, Instrumentation>::cursor() const {
+    return new NodeCursor(tail == NULL ? NULL : tail->next.get(), listSize);
+}
+
+template <class T, class Instrumentation>
+OperationCounters CircularLinkedList<T, Instrumentation>::counters() const {
+    return Instrumentation::counters();
+}
+
+template <class T, class Instrumentation> template <class U>
+typename CircularLinkedList<T, Instrumentation>::template rebind<U>::other CircularLinkedList<T, Instrumentation>::map(const function<U (const T&)>& transform) const {
+    typename rebind<U>::other mapped;
+
+    if (tail != NULL) {
+        shared_ptr<Node<T>> ptr= tail->next;
+
+        do {
+            mapped.append(transform(ptr->value));
+            ptr= ptr->next;
+        } while(ptr != tail->next);
+    }
+    return mapped;
+}
+
+template <class T, class Instrumentation> template <class... Args>
+void CircularLinkedList<T, Instrumentation>::append(Args&&... args) {
+    shared_ptr<Node<T>> ptr(std::make_shared<Node<T>>(std::forward<Args>(args)...));
+
+    if (tail == NULL) {
+        tail= ptr;
+        tail->next= tail;
+    } else {
+        ptr->next= tail->next;
+        tail->next= ptr;
+        tail= ptr;
+    }
+    listSize++;
+}
+
+template <class T, class Instrumentation>
+typename CircularLinkedList<T, Instrumentation>::template Node<T>* CircularLinkedList<T, Instrumentation>::node(int index) const {
+    Node<T>* ptr= tail->next.get();
+
+    for(int i= 0; i < index; i++) {
+        ptr= ptr->next.get();
+    }
+    this->hopped(index);
+    return ptr;
+}
+
 }
 }
 }
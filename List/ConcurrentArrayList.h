@@ -0,0 +1,552 @@
+#ifndef ETSAI_COLLECTIONS_LIST_CONCURRENTARRAYLIST_H
+#define ETSAI_COLLECTIONS_LIST_CONCURRENTARRAYLIST_H
+
+#include "List.h"
+#include "src/Segments.h"
+
+#include <atomic>
+#include <functional>
+#include <initializer_list>
+#include <limits>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace etsai {
+namespace collections {
+namespace list {
+
+using std::atomic;
+using std::initializer_list;
+using std::invalid_argument;
+using std::length_error;
+using std::logic_error;
+using std::out_of_range;
+using std::stringstream;
+
+/**
+ * An append-only list that many threads can add to at once without locking.  An add reserves the next index with
+ * an atomic increment, then constructs the element in its slot and publishes it.  Slots live in segments that
+ * double in size and are never moved or freed while the list is alive, so references to elements stay valid as
+ * the list grows.  Readers take no locks: get, at, and each can run alongside adds, and reading an index that is
+ * reserved but not yet published waits for the adding thread to finish constructing it.
+ *
+ * Only appending is supported.  Functions that insert at an index, remove elements, or reorder the list throw
+ * logic_error.  Replacing an element with set is allowed, but is not synchronized with readers of that element.
+ * @author etsai
+ */
+template <class T>
+class ConcurrentArrayList : public collections::List<T> {
+public:
+    /**
+     * Gives the ConcurrentArrayList type holding elements of type U
+     */
+    template <class U>
+    struct rebind {
+        typedef ConcurrentArrayList<U> other;
+    };
+
+    /**
+     * Constructs an empty list
+     */
+    ConcurrentArrayList();
+    /**
+     * Copy constructor.  Copies the elements published when the copy starts; the given list may keep growing.
+     */
+    ConcurrentArrayList(const ConcurrentArrayList<T>& list);
+    /**
+     * Move constructor.  No other thread may use the moved from list, which is left empty.
+     */
+    ConcurrentArrayList(ConcurrentArrayList<T>&& list);
+    /**
+     * Constructs a list with the elements of the initializer list
+     * @param   collection  Initial values for the list
+     */
+    ConcurrentArrayList(initializer_list<T> collection);
+    /**
+     * Destroys the elements and frees every segment.  No other thread may use the list while it is destroyed.
+     */
+    ~ConcurrentArrayList();
+
+    virtual ConcurrentArrayList<T>* clone() const;
+    virtual bool equals(initializer_list<T> collection) const;
+    virtual bool equals(const Collection<T>* collection) const;
+    /**
+     * Get the number of reserved indices.  Indices below the size are either published or about to be.
+     */
+    virtual int size() const;
+    /**
+     * Get the number of slots in the allocated segments
+     */
+    virtual int capacity() const;
+    virtual MemoryUsage memoryUsage() const;
+    virtual bool isEmpty() const;
+    virtual bool contains(const T& elem) const;
+    virtual bool exists(const function<bool (const T&)>& predicate) const;
+    virtual bool forAll(const function<bool (const T&)>& predicate) const;
+    /**
+     * Applies the lambda to each element reserved when the call starts, in index order
+     */
+    virtual void each(const function<void (const T&)>& lambda) const;
+    virtual void each(const function<void (T&)>& lambda);
+    /**
+     * Appends the element.  Safe to call from any number of threads at once.
+     * @param   elem    Element to add
+     * @return  True, since appending always modifies the list
+     * @throws  length_error    If the list already holds the maximum number of elements
+     */
+    virtual bool add(const T& elem);
+    virtual bool add(T&& elem);
+    /**
+     * Constructs an element from the arguments directly in the next free slot.  Safe to call from any number of
+     * threads at once.
+     * @param   args    Arguments to pass to the element's constructor
+     * @return  True, since appending always modifies the list
+     */
+    template <class... Args>
+    bool emplace(Args&&... args);
+    /**
+     * Not supported, always throws logic_error
+     */
+    virtual bool add(int index, const T& elem);
+    /**
+     * Not supported, always throws logic_error
+     */
+    virtual bool remove(const T& elem);
+    /**
+     * Not supported, always throws logic_error
+     */
+    virtual void clear();
+    virtual ConcurrentArrayList<T>* reverse() const;
+    /**
+     * Returns a reversed copy.  Reversing in place is not supported and throws logic_error.
+     */
+    virtual ConcurrentArrayList<T>* reverse(bool mutate);
+    /**
+     * Not supported, always throws logic_error
+     */
+    virtual void resize(int newSize);
+    virtual void set(int index, const T& elem) throw(out_of_range);
+    virtual void set(int index, T&& elem) throw(out_of_range);
+    /**
+     * Not supported.  Always throws out_of_range, which is the logic_error the exception specification allows.
+     */
+    virtual T minus(int index) throw(out_of_range);
+    virtual T get(int index) const throw(out_of_range);
+    /**
+     * Get a reference to the element at the index, waiting for it to be published.  The reference stays valid
+     * for the lifetime of the list.
+     * @throws  out_of_range    If the index is not reserved, or the element's constructor threw
+     */
+    virtual const T& at(int index) const throw(out_of_range);
+    virtual ConcurrentArrayList<T>* subList(int startIndex, int endIndex) const throw(out_of_range, invalid_argument);
+    /**
+     * Transforms the list from T list -> U list.  Evaluates [f(a0), f(a1), ..., f(an)].
+     * @param   transform   Lambda that maps T -> U
+     * @return  List of the transformed values
+     */
+    template <class U>
+    typename rebind<U>::other map(const function<U (const T&)>& transform) const;
+
+private:
+    template <class U>
+    friend class ConcurrentArrayList;
+
+    enum State {
+        RESERVED,
+        PUBLISHED,
+        ABANDONED
+    };
+
+    struct Slot {
+        Slot() : state(RESERVED) {
+        }
+
+        atomic<int> state;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+
+        T* value() {
+            return reinterpret_cast<T*>(&storage);
+        }
+        const T* value() const {
+            return reinterpret_cast<const T*>(&storage);
+        }
+    };
+
+    /**
+     * Reserves an index and constructs the element there from the arguments
+     */
+    template <class... Args>
+    void append(Args&&... args);
+    /**
+     * Get the slot for the index, allocating its segment if needed
+     */
+    Slot& slot(int index) const;
+    /**
+     * Waits until the slot is published or abandoned
+     * @return  True if the slot holds an element
+     */
+    static bool await(const Slot& slot);
+    static void unsupported(const char* operation);
+
+    mutable atomic<Slot*> segments[segmented::SEGMENTS];
+    /** Number of reserved indices, wide enough that failed adds past the maximum size cannot wrap it */
+    atomic<long> reserved;
+};
+
+
+template <class T>
+ConcurrentArrayList<T>::ConcurrentArrayList() : reserved(0) {
+    for(int i= 0; i < segmented::SEGMENTS; i++) {
+        segments[i]= NULL;
+    }
+}
+
+template <class T>
+ConcurrentArrayList<T>::ConcurrentArrayList(const ConcurrentArrayList<T>& list) : ConcurrentArrayList() {
+    list.each([this](const T& elem) -> void {
+        append(elem);
+    });
+}
+
+template <class T>
+ConcurrentArrayList<T>::ConcurrentArrayList(ConcurrentArrayList<T>&& list) : reserved(list.reserved.load()) {
+    for(int i= 0; i < segmented::SEGMENTS; i++) {
+        segments[i]= list.segments[i].load();
+        list.segments[i]= NULL;
+    }
+    list.reserved= 0;
+}
+
+template <class T>
+ConcurrentArrayList<T>::ConcurrentArrayList(initializer_list<T> collection) : ConcurrentArrayList() {
+    for(const T& elem: collection) {
+        append(elem);
+    }
+}
+
+template <class T>
+ConcurrentArrayList<T>::~ConcurrentArrayList() {
+    int listSize= size();
+
+    for(int i= 0; i < listSize; i++) {
+        Slot& current= slot(i);
+
+        if (current.state == PUBLISHED) {
+            current.value()->~T();
+        }
+    }
+    for(int i= 0; i < segmented::SEGMENTS; i++) {
+        delete[] segments[i].load();
+    }
+}
+
+template <class T>
+ConcurrentArrayList<T>* ConcurrentArrayList<T>::clone() const {
+    return new ConcurrentArrayList<T>(*this);
+}
+
+template <class T>
+bool ConcurrentArrayList<T>::equals(initializer_list<T> collection) const {
+    int index= 0;
+
+    if ((int) collection.size() != size()) {
+        return false;
+    }
+    for(const T& elem: collection) {
+        if (!(at(index) == elem)) {
+            return false;
+        }
+        index++;
+    }
+    return true;
+}
+
+template <class T>
+bool ConcurrentArrayList<T>::equals(const Collection<T>* collection) const {
+    int index= 0;
+    bool equal= true;
+
+    if (collection->size() != size()) {
+        return false;
+    }
+    collection->each([&equal, &index, this](const T& elem) -> void {
+        equal= equal && (at(index) == elem);
+        index++;
+    });
+    return equal;
+}
+
+template <class T>
+int ConcurrentArrayList<T>::size() const {
+    long count= reserved.load(std::memory_order_acquire);
+
+    return count < std::numeric_limits<int>::max() ? count : std::numeric_limits<int>::max();
+}
+
+template <class T>
+int ConcurrentArrayList<T>::capacity() const {
+    int slots= 0;
+
+    for(int i= 0; i < segmented::SEGMENTS; i++) {
+        if (segments[i].load(std::memory_order_acquire) != NULL) {
+            slots+= segmented::length(i);
+        }
+    }
+    return slots;
+}
+
+template <class T>
+MemoryUsage ConcurrentArrayList<T>::memoryUsage() const {
+    int slots= capacity(), elements= size();
+
+    return MemoryUsage(elements * sizeof(T), (slots - elements) * sizeof(T), slots * (sizeof(Slot) - sizeof(T)));
+}
+
+template <class T>
+bool ConcurrentArrayList<T>::isEmpty() const {
+    return size() == 0;
+}
+
+template <class T>
+bool ConcurrentArrayList<T>::contains(const T& elem) const {
+    return exists([&elem](const T& current) -> bool {
+        return current == elem;
+    });
+}
+
+template <class T>
+bool ConcurrentArrayList<T>::exists(const function<bool (const T&)>& predicate) const {
+    int listSize= size();
+
+    for(int i= 0; i < listSize; i++) {
+        const Slot& current= slot(i);
+
+        if (await(current) && predicate(*current.value())) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <class T>
+bool ConcurrentArrayList<T>::forAll(const function<bool (const T&)>& predicate) const {
+    return !exists([&predicate](const T& elem) -> bool {
+        return !predicate(elem);
+    });
+}
+
+template <class T>
+void ConcurrentArrayList<T>::each(const function<void (const T&)>& lambda) const {
+    int listSize= size();
+
+    for(int i= 0; i < listSize; i++) {
+        const Slot& current= slot(i);
+
+        if (await(current)) {
+            lambda(*current.value());
+        }
+    }
+}
+
+template <class T>
+void ConcurrentArrayList<T>::each(const function<void (T&)>& lambda) {
+    int listSize= size();
+
+    for(int i= 0; i < listSize; i++) {
+        Slot& current= slot(i);
+
+        if (await(current)) {
+            lambda(*current.value());
+        }
+    }
+}
+
+template <class T>
+bool ConcurrentArrayList<T>::add(const T& elem) {
+    append(elem);
+    return true;
+}
+
+template <class T>
+bool ConcurrentArrayList<T>::add(T&& elem) {
+    append(std::move(elem));
+    return true;
+}
+
+template <class T> template <class... Args>
+bool ConcurrentArrayList<T>::emplace(Args&&... args) {
+    append(std::forward<Args>(args)...);
+    return true;
+}
+
+template <class T>
+bool ConcurrentArrayList<T>::add(int, const T&) {
+    unsupported("Inserting at an index");
+    return false;
+}
+
+template <class T>
+bool ConcurrentArrayList<T>::remove(const T&) {
+    unsupported("Removing elements");
+    return false;
+}
+
+template <class T>
+void ConcurrentArrayList<T>::clear() {
+    unsupported("Clearing");
+}
+
+template <class T>
+ConcurrentArrayList<T>* ConcurrentArrayList<T>::reverse() const {
+    ConcurrentArrayList<T>* reversed= new ConcurrentArrayList<T>();
+
+    for(int i= size() - 1; i >= 0; i--) {
+        const Slot& current= slot(i);
+
+        if (await(current)) {
+            reversed->append(*current.value());
+        }
+    }
+    return reversed;
+}
+
+template <class T>
+ConcurrentArrayList<T>* ConcurrentArrayList<T>::reverse(bool mutate) {
+    if (mutate) {
+        unsupported("Reversing in place");
+    }
+    return reverse();
+}
+
+template <class T>
+void ConcurrentArrayList<T>::resize(int) {
+    unsupported("Resizing");
+}
+
+template <class T>
+void ConcurrentArrayList<T>::set(int index, const T& elem) throw(out_of_range) {
+    const_cast<T&>(at(index))= elem;
+}
+
+template <class T>
+void ConcurrentArrayList<T>::set(int index, T&& elem) throw(out_of_range) {
+    const_cast<T&>(at(index))= std::move(elem);
+}
+
+template <class T>
+T ConcurrentArrayList<T>::minus(int) throw(out_of_range) {
+    throw out_of_range("Removing elements is not supported by ConcurrentArrayList");
+}
+
+template <class T>
+T ConcurrentArrayList<T>::get(int index) const throw(out_of_range) {
+    return at(index);
+}
+
+template <class T>
+const T& ConcurrentArrayList<T>::at(int index) const throw(out_of_range) {
+    this->rangeCheck(index, size());
+
+    const Slot& current= slot(index);
+    if (!await(current)) {
+        stringstream msg;
+        msg << "Element at index " << index << " was never constructed";
+        throw out_of_range(msg.str());
+    }
+    return *current.value();
+}
+
+template <class T>
+ConcurrentArrayList<T>* ConcurrentArrayList<T>::subList(int startIndex, int endIndex) const throw(out_of_range, invalid_argument) {
+    int listSize= size();
+
+    if (startIndex < 0 || startIndex >= listSize || endIndex < 0 || endIndex >= listSize) {
+        stringstream msg;
+        msg << "Indices (" << startIndex << ", " << endIndex << ") lay outside the range [0, " << listSize - 1 << "]";
+        throw out_of_range(msg.str());
+    } else if (endIndex < startIndex) {
+        stringstream msg;
+        msg << "End index < start index (" << endIndex << " < " << startIndex << ")";
+        throw invalid_argument(msg.str());
+    }
+
+    ConcurrentArrayList<T>* newList= new ConcurrentArrayList<T>();
+    for(int i= startIndex; i <= endIndex; i++) {
+        const Slot& current= slot(i);
+
+        if (await(current)) {
+            newList->append(*current.value());
+        }
+    }
+    return newList;
+}
+
+template <class T> template <class U>
+typename ConcurrentArrayList<T>::template rebind<U>::other ConcurrentArrayList<T>::map(const function<U (const T&)>& transform) const {
+    typename rebind<U>::other mapped;
+
+    each([&mapped, &transform](const T& elem) -> void {
+        mapped.append(transform(elem));
+    });
+    return mapped;
+}
+
+template <class T> template <class... Args>
+void ConcurrentArrayList<T>::append(Args&&... args) {
+    long index= reserved.fetch_add(1, std::memory_order_acq_rel);
+
+    if (index >= std::numeric_limits<int>::max()) {
+        throw length_error("ConcurrentArrayList cannot hold more elements");
+    }
+
+    Slot& current= slot(index);
+    try {
+        new (current.value()) T(std::forward<Args>(args)...);
+    } catch (...) {
+        current.state.store(ABANDONED, std::memory_order_release);
+        throw;
+    }
+    current.state.store(PUBLISHED, std::memory_order_release);
+}
+
+template <class T>
+typename ConcurrentArrayList<T>::Slot& ConcurrentArrayList<T>::slot(int index) const {
+    segmented::Location location= segmented::locate(index);
+    Slot* slots= segments[location.segment].load(std::memory_order_acquire);
+
+    if (slots == NULL) {
+        Slot* allocated= new Slot[segmented::length(location.segment)];
+
+        if (segments[location.segment].compare_exchange_strong(slots, allocated, std::memory_order_acq_rel)) {
+            slots= allocated;
+        } else {
+            delete[] allocated;
+        }
+    }
+    return slots[location.offset];
+}
+
+template <class T>
+bool ConcurrentArrayList<T>::await(const Slot& slot) {
+    int state;
+
+    while((state= slot.state.load(std::memory_order_acquire)) == RESERVED) {
+        std::this_thread::yield();
+    }
+    return state == PUBLISHED;
+}
+
+template <class T>
+void ConcurrentArrayList<T>::unsupported(const char* operation) {
+    throw logic_error(string(operation) + " is not supported by ConcurrentArrayList");
+}
+
+}   //namespace list
+}   //namespace collections
+}   //namespace etsai
+
+#endif
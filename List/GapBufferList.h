@@ -0,0 +1,547 @@
+#ifndef ETSAI_COLLECTIONS_LIST_GAPBUFFERLIST_H
+#define ETSAI_COLLECTIONS_LIST_GAPBUFFERLIST_H
+
+#include "List.h"
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+namespace etsai {
+namespace collections {
+namespace list {
+
+using std::initializer_list;
+using std::invalid_argument;
+using std::out_of_range;
+using std::stringstream;
+using std::unique_ptr;
+
+/**
+ * Implements the List abstract class with an array holding a gap of unused slots.  The elements before the gap
+ * sit at the front of the array and the elements after it at the back.  An insertion or removal first moves the
+ * gap to its index, shifting only the elements between the old and new position, then fills or widens the gap
+ * in O(1).  Edits clustered around the same position, such as typing into a text buffer, are O(1) amortized
+ * instead of shifting the whole tail of the list each time.
+ *
+ * The array grows the same way as an ArrayList's: it starts with 8 slots and grows by half when the gap is used
+ * up.  Traversals visit the two runs of elements on either side of the gap, so each is as fast as an ArrayList's.
+ * @author etsai
+ */
+template <class T>
+class GapBufferList : public collections::List<T> {
+public:
+    /**
+     * Gives the GapBufferList type holding elements of type U
+     */
+    template <class U>
+    struct rebind {
+        typedef GapBufferList<U> other;
+    };
+
+    /**
+     * Constructs an empty list with 0 capacity
+     */
+    GapBufferList();
+    /**
+     * Copy constructor.  The copy's gap sits at the end of the list.
+     */
+    GapBufferList(const GapBufferList<T>& list);
+    /**
+     * Move constructor.  The moved from list is left empty with 0 capacity.
+     */
+    GapBufferList(GapBufferList<T>&& list);
+    /**
+     * Constructs a list with the elements of the initializer list
+     * @param   collection  Initial values for the list
+     */
+    GapBufferList(initializer_list<T> collection);
+    /**
+     * Constructs an empty list that can hold the given number of elements before growing
+     * @param   initialCapacity     Number of slots to allocate
+     */
+    explicit GapBufferList(int initialCapacity);
+    /**
+     * Move assignment.  The moved from list is left empty with 0 capacity.
+     */
+    GapBufferList<T>& operator =(GapBufferList<T>&& list);
+
+    virtual GapBufferList<T>* clone() const;
+    virtual bool equals(initializer_list<T> collection) const;
+    virtual bool equals(const Collection<T>* collection) const;
+    virtual int size() const;
+    virtual int capacity() const;
+    /**
+     * Get the heap bytes of the array.  The gap is counted as slack.
+     */
+    virtual MemoryUsage memoryUsage() const;
+    virtual bool isEmpty() const;
+    virtual bool contains(const T& elem) const;
+    virtual bool exists(const function<bool (const T&)>& predicate) const;
+    virtual bool forAll(const function<bool (const T&)>& predicate) const;
+    virtual void each(const function<void (const T&)>& lambda) const;
+    virtual void each(const function<void (T&)>& lambda);
+    virtual void eachReverse(const function<void (const T&)>& lambda) const;
+    virtual bool remove(const T& elem);
+    virtual bool add(const T& elem);
+    virtual bool add(T&& elem);
+    /**
+     * Moves the gap to the index and inserts the element at the start of it.  If the index is past the end, the
+     * slots in between are filled with default constructed elements.
+     */
+    virtual bool add(int index, const T& elem);
+    virtual bool add(int index, T&& elem);
+    /**
+     * Removes every element and moves the gap over the whole array, without changing the capacity
+     */
+    virtual void clear();
+    virtual GapBufferList<T>* reverse() const;
+    virtual GapBufferList<T>* reverse(bool mutate);
+    /**
+     * Changes the capacity to the new size.  If the new size is less than the list size, the elements past it are
+     * dropped.
+     */
+    virtual void resize(int newSize);
+    virtual void set(int index, const T& elem) throw(out_of_range);
+    virtual void set(int index, T&& elem) throw(out_of_range);
+    /**
+     * Moves the gap to the index and widens it over the removed element
+     */
+    virtual T minus(int index) throw(out_of_range);
+    virtual T get(int index) const throw(out_of_range);
+    virtual const T& at(int index) const throw(out_of_range);
+    virtual GapBufferList<T>* subList(int startIndex, int endIndex) const throw(out_of_range, invalid_argument);
+    /**
+     * Get the index the gap sits at, which is where the last insertion or removal happened
+     */
+    int gapIndex() const;
+    /**
+     * Transforms the list from T list -> U list.  Evaluates [f(a0), f(a1), ..., f(an)].
+     * @param   transform   Lambda that maps T -> U
+     * @return  List of the transformed values
+     */
+    template <class U>
+    typename rebind<U>::other map(const function<U (const T&)>& transform) const;
+
+private:
+    template <class U>
+    friend class GapBufferList;
+
+    /**
+     * Get the array position of the element at the index
+     */
+    int position(int index) const;
+    /**
+     * Moves the gap so it starts at the index, shifting the elements between the old and new start across it
+     */
+    void moveGap(int index);
+    /**
+     * Reallocates the array with the new capacity, which must hold every element, keeping the gap where it is
+     */
+    void reallocate(int newCapacity);
+    template <class U>
+    bool insert(int index, U&& elem);
+    /**
+     * Appends the element to a list whose gap is at the end and has room for it
+     */
+    template <class U>
+    void append(U&& elem);
+
+    int listCapacity;
+    unique_ptr<T[]> elements;
+    /** Elements are in [0, gapStart) and [gapEnd, listCapacity) */
+    int gapStart, gapEnd;
+};
+
+template <class T>
+GapBufferList<T>::GapBufferList() : GapBufferList(0) {
+}
+
+template <class T>
+GapBufferList<T>::GapBufferList(const GapBufferList<T>& list) : GapBufferList(list.listCapacity) {
+    std::copy(list.elements.get(), list.elements.get() + list.gapStart, elements.get());
+    std::copy(list.elements.get() + list.gapEnd, list.elements.get() + list.listCapacity, elements.get() + list.gapStart);
+    gapStart= list.size();
+}
+
+template <class T>
+GapBufferList<T>::GapBufferList(GapBufferList<T>&& list) : listCapacity(list.listCapacity), elements(std::move(list.elements)),
+        gapStart(list.gapStart), gapEnd(list.gapEnd) {
+    list.listCapacity= list.gapStart= list.gapEnd= 0;
+}
+
+template <class T>
+GapBufferList<T>::GapBufferList(initializer_list<T> collection) : GapBufferList(collection.size()) {
+    for(const T& elem: collection) {
+        append(elem);
+    }
+}
+
+template <class T>
+GapBufferList<T>::GapBufferList(int initialCapacity) : listCapacity(initialCapacity > 0 ? initialCapacity : 0), gapStart(0) {
+    gapEnd= listCapacity;
+    if (listCapacity > 0) {
+        elements.reset(new T[listCapacity]);
+    }
+}
+
+template <class T>
+GapBufferList<T>& GapBufferList<T>::operator =(GapBufferList<T>&& list) {
+    if (this != &list) {
+        listCapacity= list.listCapacity;
+        elements= std::move(list.elements);
+        gapStart= list.gapStart;
+        gapEnd= list.gapEnd;
+        list.listCapacity= list.gapStart= list.gapEnd= 0;
+    }
+    return *this;
+}
+
+template <class T>
+GapBufferList<T>* GapBufferList<T>::clone() const {
+    return new GapBufferList<T>(*this);
+}
+
+template <class T>
+bool GapBufferList<T>::equals(initializer_list<T> collection) const {
+    int index= 0;
+
+    if ((int) collection.size() != size()) {
+        return false;
+    }
+    for(const T& elem: collection) {
+        if (!(elements[position(index)] == elem)) {
+            return false;
+        }
+        index++;
+    }
+    return true;
+}
+
+template <class T>
+bool GapBufferList<T>::equals(const Collection<T>* collection) const {
+    int index= 0;
+    bool equal= true;
+
+    if (collection->size() != size()) {
+        return false;
+    }
+    collection->each([&equal, &index, this](const T& elem) -> void {
+        equal= equal && (elements[position(index)] == elem);
+        index++;
+    });
+    return equal;
+}
+
+template <class T>
+int GapBufferList<T>::size() const {
+    return listCapacity - (gapEnd - gapStart);
+}
+
+template <class T>
+int GapBufferList<T>::capacity() const {
+    return listCapacity;
+}
+
+template <class T>
+MemoryUsage GapBufferList<T>::memoryUsage() const {
+    return MemoryUsage(size() * sizeof(T), (gapEnd - gapStart) * sizeof(T), 0);
+}
+
+template <class T>
+bool GapBufferList<T>::isEmpty() const {
+    return size() == 0;
+}
+
+template <class T>
+bool GapBufferList<T>::contains(const T& elem) const {
+    return exists([&elem](const T& current) -> bool {
+        return current == elem;
+    });
+}
+
+template <class T>
+bool GapBufferList<T>::exists(const function<bool (const T&)>& predicate) const {
+    const T* values= elements.get();
+
+    for(int i= 0; i < gapStart; i++) {
+        if (predicate(values[i])) {
+            return true;
+        }
+    }
+    for(int i= gapEnd; i < listCapacity; i++) {
+        if (predicate(values[i])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <class T>
+bool GapBufferList<T>::forAll(const function<bool (const T&)>& predicate) const {
+    return !exists([&predicate](const T& elem) -> bool {
+        return !predicate(elem);
+    });
+}
+
+template <class T>
+void GapBufferList<T>::each(const function<void (const T&)>& lambda) const {
+    const T* values= elements.get();
+
+    for(int i= 0; i < gapStart; i++) {
+        lambda(values[i]);
+    }
+    for(int i= gapEnd; i < listCapacity; i++) {
+        lambda(values[i]);
+    }
+}
+
+template <class T>
+void GapBufferList<T>::each(const function<void (T&)>& lambda) {
+    T* values= elements.get();
+
+    for(int i= 0; i < gapStart; i++) {
+        lambda(values[i]);
+    }
+    for(int i= gapEnd; i < listCapacity; i++) {
+        lambda(values[i]);
+    }
+}
+
+template <class T>
+void GapBufferList<T>::eachReverse(const function<void (const T&)>& lambda) const {
+    const T* values= elements.get();
+
+    for(int i= listCapacity - 1; i >= gapEnd; i--) {
+        lambda(values[i]);
+    }
+    for(int i= gapStart - 1; i >= 0; i--) {
+        lambda(values[i]);
+    }
+}
+
+template <class T>
+bool GapBufferList<T>::remove(const T& elem) {
+    int listSize= size();
+
+    for(int i= 0; i < listSize; i++) {
+        if (elements[position(i)] == elem) {
+            minus(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+template <class T>
+bool GapBufferList<T>::add(const T& elem) {
+    return add(size(), elem);
+}
+
+template <class T>
+bool GapBufferList<T>::add(T&& elem) {
+    return insert(size(), std::move(elem));
+}
+
+template <class T>
+bool GapBufferList<T>::add(int index, const T& elem) {
+    if (&elem >= elements.get() && &elem < elements.get() + listCapacity) {
+        T copy(elem);
+        return insert(index, std::move(copy));
+    }
+    return insert(index, elem);
+}
+
+template <class T>
+bool GapBufferList<T>::add(int index, T&& elem) {
+    return insert(index, std::move(elem));
+}
+
+template <class T>
+void GapBufferList<T>::clear() {
+    gapStart= 0;
+    gapEnd= listCapacity;
+}
+
+template <class T>
+GapBufferList<T>* GapBufferList<T>::reverse() const {
+    GapBufferList<T>* reversed= new GapBufferList<T>(listCapacity);
+
+    eachReverse([reversed](const T& elem) -> void {
+        reversed->append(elem);
+    });
+    return reversed;
+}
+
+template <class T>
+GapBufferList<T>* GapBufferList<T>::reverse(bool mutate) {
+    if (!mutate) {
+        return reverse();
+    }
+
+    moveGap(size());
+    std::reverse(elements.get(), elements.get() + gapStart);
+    return NULL;
+}
+
+template <class T>
+void GapBufferList<T>::resize(int newSize) {
+    if (newSize > 0 && newSize != listCapacity) {
+        int listSize= size();
+
+        moveGap(listSize < newSize ? listSize : newSize);
+        gapEnd= listCapacity;
+        reallocate(newSize);
+    }
+}
+
+template <class T>
+void GapBufferList<T>::set(int index, const T& elem) throw(out_of_range) {
+    this->rangeCheck(index, size());
+    elements[position(index)]= elem;
+}
+
+template <class T>
+void GapBufferList<T>::set(int index, T&& elem) throw(out_of_range) {
+    this->rangeCheck(index, size());
+    elements[position(index)]= std::move(elem);
+}
+
+template <class T>
+T GapBufferList<T>::minus(int index) throw(out_of_range) {
+    this->rangeCheck(index, size());
+
+    if (index < gapStart) {
+        moveGap(index + 1);
+        gapStart--;
+        return std::move(elements[gapStart]);
+    }
+    moveGap(index);
+    gapEnd++;
+    return std::move(elements[gapEnd - 1]);
+}
+
+template <class T>
+T GapBufferList<T>::get(int index) const throw(out_of_range) {
+    return at(index);
+}
+
+template <class T>
+const T& GapBufferList<T>::at(int index) const throw(out_of_range) {
+    this->rangeCheck(index, size());
+    return elements[position(index)];
+}
+
+template <class T>
+GapBufferList<T>* GapBufferList<T>::subList(int startIndex, int endIndex) const throw(out_of_range, invalid_argument) {
+    int listSize= size();
+
+    if (startIndex < 0 || startIndex >= listSize || endIndex < 0 || endIndex >= listSize) {
+        stringstream msg;
+        msg << "Indices (" << startIndex << ", " << endIndex << ") lay outside the range [0, " << listSize - 1 << "]";
+        throw out_of_range(msg.str());
+    } else if (endIndex < startIndex) {
+        stringstream msg;
+        msg << "End index < start index (" << endIndex << " < " << startIndex << ")";
+        throw invalid_argument(msg.str());
+    }
+
+    GapBufferList<T>* newList= new GapBufferList<T>(endIndex - startIndex + 1);
+    for(int i= startIndex; i <= endIndex; i++) {
+        newList->append(elements[position(i)]);
+    }
+    return newList;
+}
+
+template <class T>
+int GapBufferList<T>::gapIndex() const {
+    return gapStart;
+}
+
+template <class T> template <class U>
+typename GapBufferList<T>::template rebind<U>::other GapBufferList<T>::map(const function<U (const T&)>& transform) const {
+    typename rebind<U>::other mapped(size());
+
+    each([&mapped, &transform](const T& elem) -> void {
+        mapped.append(transform(elem));
+    });
+    return mapped;
+}
+
+template <class T>
+int GapBufferList<T>::position(int index) const {
+    return index < gapStart ? index : index + (gapEnd - gapStart);
+}
+
+template <class T>
+void GapBufferList<T>::moveGap(int index) {
+    T* values= elements.get();
+
+    if (index < gapStart) {
+        std::move_backward(values + index, values + gapStart, values + gapEnd);
+        gapEnd-= gapStart - index;
+        gapStart= index;
+    } else if (index > gapStart) {
+        std::move(values + gapEnd, values + gapEnd + (index - gapStart), values + gapStart);
+        gapEnd+= index - gapStart;
+        gapStart= index;
+    }
+}
+
+template <class T>
+void GapBufferList<T>::reallocate(int newCapacity) {
+    int after= listCapacity - gapEnd;
+    T* newList= new T[newCapacity];
+
+    std::move(elements.get(), elements.get() + gapStart, newList);
+    std::move(elements.get() + gapEnd, elements.get() + listCapacity, newList + newCapacity - after);
+    elements.reset(newList);
+    listCapacity= newCapacity;
+    gapEnd= newCapacity - after;
+}
+
+template <class T> template <class U>
+bool GapBufferList<T>::insert(int index, U&& elem) {
+    int listSize= size();
+
+    if (index < 0) {
+        stringstream msg;
+        msg << "Index (" << index << ") cannot be negative";
+        throw out_of_range(msg.str());
+    }
+    if (index >= listSize) {
+        int needed= index + 1;
+
+        if (needed > listCapacity) {
+            moveGap(listSize);
+            reallocate(listCapacity == 0 && needed <= 8 ? 8 : needed * 1.5);
+        }
+        moveGap(listSize);
+        std::fill(elements.get() + gapStart, elements.get() + index, T());
+        gapStart= index;
+    } else {
+        if (gapStart == gapEnd) {
+            reallocate(std::max<int>(listCapacity + 1, listCapacity * 1.5));
+        }
+        moveGap(index);
+    }
+    elements[gapStart]= std::forward<U>(elem);
+    gapStart++;
+    return true;
+}
+
+template <class T> template <class U>
+void GapBufferList<T>::append(U&& elem) {
+    elements[gapStart]= std::forward<U>(elem);
+    gapStart++;
+}
+
+}   //namespace list
+}   //namespace collections
+}   //namespace etsai
+
+#endif
@@ -0,0 +1,991 @@
+#ifndef ETSAI_COLLECTIONS_LIST_PERSISTENTLIST_H
+#define ETSAI_COLLECTIONS_LIST_PERSISTENTLIST_H
+
+#include "List.h"
+
+#include <atomic>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace etsai {
+namespace collections {
+namespace list {
+
+using std::initializer_list;
+using std::invalid_argument;
+using std::make_shared;
+using std::out_of_range;
+using std::shared_ptr;
+using std::static_pointer_cast;
+using std::stringstream;
+using std::vector;
+
+/**
+ * A list whose versions share structure, so copies are cheap and never see each other's changes.  Elements are
+ * stored in leaves of 32 elements, held by a trie of 32 way branches, plus a tail leaf holding the last 1 to 32
+ * elements outside the trie.  Copying or cloning the list copies three pointers.  Replacing an element copies the
+ * path from the root to its leaf, and appending copies the tail, so both cost O(log32 n) no matter how many
+ * versions share the nodes.  Inserting or removing anywhere but the end rebuilds the list in O(n).
+ *
+ * appended and updated return a new version and leave the list unchanged; the mutating List functions replace
+ * the list's own version the same way, so clones taken earlier are not affected.  Lists are best built in bulk
+ * with a Transient, which edits the nodes it created in place instead of copying them.
+ * @author etsai
+ */
+template <class T>
+class PersistentList : public collections::List<T> {
+public:
+    /**
+     * Gives the PersistentList type holding elements of type U
+     */
+    template <class U>
+    struct rebind {
+        typedef PersistentList<U> other;
+    };
+
+    /**
+     * Mutable builder for a PersistentList
+     */
+    class Transient;
+
+    /**
+     * Constructs an empty list
+     */
+    PersistentList();
+    /**
+     * Constructs a list with the elements of the initializer list
+     * @param   collection  Initial values for the list
+     */
+    PersistentList(initializer_list<T> collection);
+
+    /**
+     * Creates a copy sharing every node with this list, in O(1)
+     * @return  Copy of the list
+     */
+    virtual PersistentList<T>* clone() const;
+    virtual bool equals(initializer_list<T> collection) const;
+    virtual bool equals(const Collection<T>* collection) const;
+    virtual int size() const;
+    /**
+     * Get the number of elements the list can hold before its tail leaf is full
+     */
+    virtual int capacity() const;
+    /**
+     * Get the heap bytes of the nodes reachable from this list.  Nodes shared with other versions are counted in
+     * full by every version holding them.
+     */
+    virtual MemoryUsage memoryUsage() const;
+    virtual bool isEmpty() const;
+    virtual bool contains(const T& elem) const;
+    virtual bool exists(const function<bool (const T&)>& predicate) const;
+    virtual bool forAll(const function<bool (const T&)>& predicate) const;
+    virtual void each(const function<void (const T&)>& lambda) const;
+    /**
+     * Applies the lambda to copies of the elements, then replaces the list with the modified copies.  Clones taken
+     * before the call keep the original elements.
+     */
+    virtual void each(const function<void (T&)>& lambda);
+    virtual void eachReverse(const function<void (const T&)>& lambda) const;
+    virtual bool remove(const T& elem);
+    virtual bool add(const T& elem);
+    virtual bool add(T&& elem);
+    /**
+     * Inserts the element at the index.  Appending is O(log32 n); inserting anywhere else rebuilds the list.  If
+     * the index is past the end, the gap is filled with default constructed elements.
+     */
+    virtual bool add(int index, const T& elem);
+    virtual void clear();
+    virtual PersistentList<T>* reverse() const;
+    virtual PersistentList<T>* reverse(bool mutate);
+    /**
+     * Shrinks the list to the new size by dropping elements from the end.  A larger size leaves the list unchanged,
+     * since the list has no capacity to reserve.
+     */
+    virtual void resize(int newSize);
+    virtual void set(int index, const T& elem) throw(out_of_range);
+    /**
+     * Removes the element at the index.  Removing the last element is O(log32 n); removing any other rebuilds the
+     * list.
+     */
+    virtual T minus(int index) throw(out_of_range);
+    virtual T get(int index) const throw(out_of_range);
+    virtual const T& at(int index) const throw(out_of_range);
+    virtual PersistentList<T>* subList(int startIndex, int endIndex) const throw(out_of_range, invalid_argument);
+    /**
+     * Get a new version with the element appended.  This list is not changed.
+     * @param   elem    Element to append
+     * @return  List sharing all but the tail with this list
+     */
+    PersistentList<T> appended(const T& elem) const;
+    /**
+     * Get a new version with the element at the index replaced.  This list is not changed.
+     * @param   index   Index of the element to replace
+     * @param   elem    New value
+     * @return  List sharing all but one path of nodes with this list
+     * @throws  out_of_range    If the index is outside [0, size - 1]
+     */
+    PersistentList<T> updated(int index, const T& elem) const;
+    /**
+     * Get a builder starting from this list's elements
+     * @return  Builder sharing this list's nodes
+     */
+    Transient transient() const;
+    /**
+     * Transforms the list from T list -> U list.  Evaluates [f(a0), f(a1), ..., f(an)].
+     * @param   transform   Lambda that maps T -> U
+     * @return  List of the transformed values
+     */
+    template <class U>
+    typename rebind<U>::other map(const function<U (const T&)>& transform) const;
+
+private:
+    static const int BITS= 5;
+    static const int WIDTH= 1 << BITS;
+    static const int MASK= WIDTH - 1;
+
+    /**
+     * Node of the trie.  A node may only be changed in place by the builder whose owner id it carries; lists
+     * always copy.
+     */
+    struct Node {
+        explicit Node(long owner) : owner(owner) {
+        }
+
+        long owner;
+    };
+    struct Branch : Node {
+        explicit Branch(long owner) : Node(owner) {
+        }
+        Branch(const Branch& branch, long owner) : Node(owner) {
+            for(int i= 0; i < WIDTH; i++) {
+                children[i]= branch.children[i];
+            }
+        }
+
+        shared_ptr<Node> children[WIDTH];
+    };
+    struct Leaf : Node {
+        explicit Leaf(long owner) : Node(owner) {
+            values.reserve(WIDTH);
+        }
+        Leaf(const Leaf& leaf, long owner) : Node(owner) {
+            values.reserve(WIDTH);
+            values.insert(values.end(), leaf.values.begin(), leaf.values.end());
+        }
+
+        vector<T> values;
+    };
+
+    /**
+     * Root, tail, and size of one version.  Every edit takes the id of the builder making it, or 0 for a list,
+     * and copies the nodes on its path that carry a different id.
+     */
+    struct Trie {
+        Trie();
+
+        /**
+         * Get the index of the tail's first element
+         */
+        int tailOffset() const;
+        const Leaf& leafAt(int index) const;
+        shared_ptr<Leaf> leafPointer(int index) const;
+        const T& at(int index) const;
+        template <class U>
+        void push(U&& elem, long owner);
+        template <class U>
+        void assign(int index, U&& elem, long owner);
+        void pop(long owner);
+        /**
+         * Applies the lambda to each element from first to last until it returns true
+         * @return  True if the lambda returned true
+         */
+        bool visit(const function<bool (const T&)>& lambda) const;
+
+        shared_ptr<Branch> pushTail(int level, const shared_ptr<Branch>& parent, const shared_ptr<Leaf>& leaf, long owner);
+        shared_ptr<Node> newPath(int level, const shared_ptr<Node>& node, long owner);
+        template <class U>
+        shared_ptr<Branch> assignPath(int level, const shared_ptr<Branch>& branch, int index, U&& elem, long owner);
+        shared_ptr<Branch> popTail(int level, const shared_ptr<Branch>& branch, long owner);
+        void addUsage(int level, const Node* node, MemoryUsage& usage) const;
+
+        int count, shift;
+        shared_ptr<Branch> root;
+        shared_ptr<Leaf> tail;
+    };
+
+    /**
+     * Get the empty nodes shared by every empty list, so creating or clearing a list does not allocate
+     */
+    static const shared_ptr<Branch>& emptyBranch();
+    static const shared_ptr<Leaf>& emptyLeaf();
+    /**
+     * Get an id no other builder has used
+     */
+    static long nextOwner();
+    /**
+     * Get the branch to change in place for the owner, copying it if the owner does not own it
+     */
+    static shared_ptr<Branch> editable(const shared_ptr<Branch>& branch, long owner);
+    static shared_ptr<Leaf> editable(const shared_ptr<Leaf>& leaf, long owner);
+    /**
+     * Rebuilds the list from the elements before the index, the element, then the elements from the index on
+     */
+    void rebuild(int index, const T* elem, int skip);
+
+    explicit PersistentList(const Trie& trie);
+
+    Trie trie;
+};
+
+/**
+ * Mutable builder for a PersistentList.  Nodes created by the builder are changed in place by later edits,
+ * so building a list of n elements costs O(n) with one allocation per 32 elements.  Nodes shared with a
+ * PersistentList are copied the first time they are edited.  A builder must only be used by one thread.
+ * @author etsai
+ */
+template <class T>
+class PersistentList<T>::Transient {
+public:
+    /**
+     * Starts an empty builder
+     */
+    Transient();
+    /**
+     * Starts a builder from the elements of the list.  The list is not copied; its nodes are copied as the
+     * builder edits them.
+     * @param   list    List to start from
+     */
+    explicit Transient(const PersistentList<T>& list);
+    /**
+     * Copy constructor.  Both builders take new owner ids, so each copies the nodes they share before changing
+     * them, and neither can see the other's edits.
+     * @param   builder     Builder to copy
+     */
+    Transient(const Transient& builder);
+    /**
+     * Move constructor.  The builder keeps editing the moved nodes in place, and the moved from builder is left
+     * empty.
+     * @param   builder     Builder to move
+     */
+    Transient(Transient&& builder);
+
+    Transient& operator=(const Transient& builder);
+    Transient& operator=(Transient&& builder);
+
+    /**
+     * Appends the element
+     * @return  Reference to this builder
+     */
+    Transient& add(const T& elem);
+    Transient& add(T&& elem);
+    /**
+     * Replaces the element at the index
+     * @return  Reference to this builder
+     * @throws  out_of_range    If the index is outside [0, size - 1]
+     */
+    Transient& set(int index, const T& elem);
+    /**
+     * Removes the last element
+     * @return  Reference to this builder
+     * @throws  out_of_range    If the builder is empty
+     */
+    Transient& pop();
+    /**
+     * Get the number of elements added so far
+     */
+    int size() const;
+    /**
+     * Get a reference to the element at the index, which is valid until the builder next changes
+     * @throws  out_of_range    If the index is outside [0, size - 1]
+     */
+    const T& at(int index) const;
+    /**
+     * Creates a list with the builder's elements in O(1).  The builder may keep being used afterwards; it will
+     * copy the nodes it shares with the returned list before changing them.
+     * @return  List holding the elements added so far
+     */
+    PersistentList<T> persistent();
+
+private:
+    Trie trie;
+    /** Mutable since copying a builder gives the source a new owner id as well */
+    mutable long owner;
+};
+
+template <class T>
+const int PersistentList<T>::BITS;
+template <class T>
+const int PersistentList<T>::WIDTH;
+template <class T>
+const int PersistentList<T>::MASK;
+
+template <class T>
+PersistentList<T>::Trie::Trie() : count(0), shift(BITS), root(emptyBranch()), tail(emptyLeaf()) {
+}
+
+template <class T>
+int PersistentList<T>::Trie::tailOffset() const {
+    return count < WIDTH ? 0 : ((count - 1) >> BITS) << BITS;
+}
+
+template <class T>
+const typename PersistentList<T>::Leaf& PersistentList<T>::Trie::leafAt(int index) const {
+    if (index >= tailOffset()) {
+        return *tail;
+    }
+
+    const Node* node= root.get();
+    for(int level= shift; level > 0; level-= BITS) {
+        node= static_cast<const Branch*>(node)->children[(index >> level) & MASK].get();
+    }
+    return *static_cast<const Leaf*>(node);
+}
+
+template <class T>
+shared_ptr<typename PersistentList<T>::Leaf> PersistentList<T>::Trie::leafPointer(int index) const {
+    if (index >= tailOffset()) {
+        return tail;
+    }
+
+    shared_ptr<Node> node= root;
+    for(int level= shift; level > 0; level-= BITS) {
+        node= static_pointer_cast<Branch>(node)->children[(index >> level) & MASK];
+    }
+    return static_pointer_cast<Leaf>(node);
+}
+
+template <class T>
+const T& PersistentList<T>::Trie::at(int index) const {
+    return leafAt(index).values[index & MASK];
+}
+
+template <class T> template <class U>
+void PersistentList<T>::Trie::push(U&& elem, long owner) {
+    if (count - tailOffset() < WIDTH) {
+        shared_ptr<Leaf> leaf= editable(tail, owner);
+
+        leaf->values.push_back(std::forward<U>(elem));
+        tail= leaf;
+    } else {
+        shared_ptr<Leaf> leaf= make_shared<Leaf>(owner);
+        shared_ptr<Branch> newRoot;
+
+        leaf->values.push_back(std::forward<U>(elem));
+        if ((count >> BITS) > (1 << shift)) {
+            newRoot= make_shared<Branch>(owner);
+            newRoot->children[0]= root;
+            newRoot->children[1]= newPath(shift, tail, owner);
+            shift+= BITS;
+        } else {
+            newRoot= pushTail(shift, root, tail, owner);
+        }
+        root= newRoot;
+        tail= leaf;
+    }
+    count++;
+}
+
+template <class T> template <class U>
+void PersistentList<T>::Trie::assign(int index, U&& elem, long owner) {
+    if (index >= tailOffset()) {
+        shared_ptr<Leaf> leaf= editable(tail, owner);
+
+        leaf->values[index & MASK]= std::forward<U>(elem);
+        tail= leaf;
+    } else {
+        root= assignPath(shift, root, index, std::forward<U>(elem), owner);
+    }
+}
+
+template <class T>
+void PersistentList<T>::Trie::pop(long owner) {
+    if (count == 1) {
+        *this= Trie();
+        return;
+    }
+    if (count - tailOffset() > 1) {
+        shared_ptr<Leaf> leaf= editable(tail, owner);
+
+        leaf->values.pop_back();
+        tail= leaf;
+    } else {
+        shared_ptr<Leaf> newTail= leafPointer(count - 2);
+        shared_ptr<Branch> newRoot= popTail(shift, root, owner);
+
+        if (newRoot == NULL) {
+            newRoot= make_shared<Branch>(owner);
+        }
+        if (shift > BITS && newRoot->children[1] == NULL) {
+            newRoot= static_pointer_cast<Branch>(newRoot->children[0]);
+            shift-= BITS;
+        }
+        root= newRoot;
+        tail= newTail;
+    }
+    count--;
+}
+
+template <class T>
+bool PersistentList<T>::Trie::visit(const function<bool (const T&)>& lambda) const {
+    for(int start= 0; start < count; start+= WIDTH) {
+        for(const T& elem: leafAt(start).values) {
+            if (lambda(elem)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+template <class T>
+shared_ptr<typename PersistentList<T>::Branch> PersistentList<T>::Trie::pushTail(int level, const shared_ptr<Branch>& parent,
+        const shared_ptr<Leaf>& leaf, long owner) {
+    shared_ptr<Branch> result= editable(parent, owner);
+    int child= ((count - 1) >> level) & MASK;
+
+    if (level == BITS) {
+        result->children[child]= leaf;
+    } else if (result->children[child] != NULL) {
+        result->children[child]= pushTail(level - BITS, static_pointer_cast<Branch>(result->children[child]), leaf, owner);
+    } else {
+        result->children[child]= newPath(level - BITS, leaf, owner);
+    }
+    return result;
+}
+
+template <class T>
+shared_ptr<typename PersistentList<T>::Node> PersistentList<T>::Trie::newPath(int level, const shared_ptr<Node>& node, long owner) {
+    if (level == 0) {
+        return node;
+    }
+
+    shared_ptr<Branch> branch= make_shared<Branch>(owner);
+    branch->children[0]= newPath(level - BITS, node, owner);
+    return branch;
+}
+
+template <class T> template <class U>
+shared_ptr<typename PersistentList<T>::Branch> PersistentList<T>::Trie::assignPath(int level, const shared_ptr<Branch>& branch,
+        int index, U&& elem, long owner) {
+    shared_ptr<Branch> result= editable(branch, owner);
+    int child= (index >> level) & MASK;
+
+    if (level == BITS) {
+        shared_ptr<Leaf> leaf= editable(static_pointer_cast<Leaf>(result->children[child]), owner);
+
+        leaf->values[index & MASK]= std::forward<U>(elem);
+        result->children[child]= leaf;
+    } else {
+        result->children[child]= assignPath(level - BITS, static_pointer_cast<Branch>(result->children[child]), index,
+                std::forward<U>(elem), owner);
+    }
+    return result;
+}
+
+template <class T>
+shared_ptr<typename PersistentList<T>::Branch> PersistentList<T>::Trie::popTail(int level, const shared_ptr<Branch>& branch, long owner) {
+    int child= ((count - 2) >> level) & MASK;
+
+    if (level > BITS) {
+        shared_ptr<Branch> newChild= popTail(level - BITS, static_pointer_cast<Branch>(branch->children[child]), owner);
+
+        if (newChild == NULL && child == 0) {
+            return NULL;
+        }
+
+        shared_ptr<Branch> result= editable(branch, owner);
+        result->children[child]= newChild;
+        return result;
+    } else if (child == 0) {
+        return NULL;
+    }
+
+    shared_ptr<Branch> result= editable(branch, owner);
+    result->children[child].reset();
+    return result;
+}
+
+template <class T>
+void PersistentList<T>::Trie::addUsage(int level, const Node* node, MemoryUsage& usage) const {
+    /** Reference counts and deleter of a make_shared control block */
+    const size_t CONTROL= 2 * sizeof(int) + sizeof(void*);
+
+    if (level == 0) {
+        const Leaf* leaf= static_cast<const Leaf*>(node);
+
+        usage.payload+= leaf->values.size() * sizeof(T);
+        usage.slack+= (leaf->values.capacity() - leaf->values.size()) * sizeof(T);
+        usage.overhead+= sizeof(Leaf) + CONTROL;
+        return;
+    }
+
+    const Branch* branch= static_cast<const Branch*>(node);
+    usage.overhead+= sizeof(Branch) + CONTROL;
+    for(int i= 0; i < WIDTH && branch->children[i] != NULL; i++) {
+        addUsage(level - BITS, branch->children[i].get(), usage);
+    }
+}
+
+template <class T>
+PersistentList<T>::Transient::Transient() : owner(nextOwner()) {
+}
+
+template <class T>
+PersistentList<T>::Transient::Transient(const PersistentList<T>& list) : trie(list.trie), owner(nextOwner()) {
+}
+
+template <class T>
+PersistentList<T>::Transient::Transient(const Transient& builder) : trie(builder.trie), owner(nextOwner()) {
+    builder.owner= nextOwner();
+}
+
+template <class T>
+PersistentList<T>::Transient::Transient(Transient&& builder) : trie(builder.trie), owner(builder.owner) {
+    builder.trie= Trie();
+    builder.owner= nextOwner();
+}
+
+template <class T>
+typename PersistentList<T>::Transient& PersistentList<T>::Transient::operator=(const Transient& builder) {
+    if (this != &builder) {
+        trie= builder.trie;
+        owner= nextOwner();
+        builder.owner= nextOwner();
+    }
+    return *this;
+}
+
+template <class T>
+typename PersistentList<T>::Transient& PersistentList<T>::Transient::operator=(Transient&& builder) {
+    if (this != &builder) {
+        trie= builder.trie;
+        owner= builder.owner;
+        builder.trie= Trie();
+        builder.owner= nextOwner();
+    }
+    return *this;
+}
+
+template <class T>
+typename PersistentList<T>::Transient& PersistentList<T>::Transient::add(const T& elem) {
+    trie.push(elem, owner);
+    return *this;
+}
+
+template <class T>
+typename PersistentList<T>::Transient& PersistentList<T>::Transient::add(T&& elem) {
+    trie.push(std::move(elem), owner);
+    return *this;
+}
+
+template <class T>
+typename PersistentList<T>::Transient& PersistentList<T>::Transient::set(int index, const T& elem) {
+    at(index);
+    trie.assign(index, elem, owner);
+    return *this;
+}
+
+template <class T>
+typename PersistentList<T>::Transient& PersistentList<T>::Transient::pop() {
+    if (trie.count == 0) {
+        throw out_of_range("Cannot pop from an empty PersistentList::Transient");
+    }
+    trie.pop(owner);
+    return *this;
+}
+
+template <class T>
+int PersistentList<T>::Transient::size() const {
+    return trie.count;
+}
+
+template <class T>
+const T& PersistentList<T>::Transient::at(int index) const {
+    if (index < 0 || index >= trie.count) {
+        stringstream msg;
+        msg << "Index (" << index << ") out of range [0, " << trie.count - 1 << "]";
+        throw out_of_range(msg.str());
+    }
+    return trie.at(index);
+}
+
+template <class T>
+PersistentList<T> PersistentList<T>::Transient::persistent() {
+    owner= nextOwner();
+    return PersistentList<T>(trie);
+}
+
+template <class T>
+PersistentList<T>::PersistentList() {
+}
+
+template <class T>
+PersistentList<T>::PersistentList(initializer_list<T> collection) {
+    Transient builder;
+
+    for(const T& elem: collection) {
+        builder.add(elem);
+    }
+    trie= builder.persistent().trie;
+}
+
+template <class T>
+PersistentList<T>::PersistentList(const Trie& trie) : trie(trie) {
+}
+
+template <class T>
+PersistentList<T>* PersistentList<T>::clone() const {
+    return new PersistentList<T>(*this);
+}
+
+template <class T>
+bool PersistentList<T>::equals(initializer_list<T> collection) const {
+    int index= 0;
+
+    if ((int) collection.size() != size()) {
+        return false;
+    }
+    for(const T& elem: collection) {
+        if (!(trie.at(index) == elem)) {
+            return false;
+        }
+        index++;
+    }
+    return true;
+}
+
+template <class T>
+bool PersistentList<T>::equals(const Collection<T>* collection) const {
+    int index= 0;
+    bool equal= true;
+
+    if (collection->size() != size()) {
+        return false;
+    }
+    collection->each([&equal, &index, this](const T& elem) -> void {
+        equal= equal && (trie.at(index) == elem);
+        index++;
+    });
+    return equal;
+}
+
+template <class T>
+int PersistentList<T>::size() const {
+    return trie.count;
+}
+
+template <class T>
+int PersistentList<T>::capacity() const {
+    return trie.tailOffset() + WIDTH;
+}
+
+template <class T>
+MemoryUsage PersistentList<T>::memoryUsage() const {
+    MemoryUsage usage;
+
+    trie.addUsage(trie.shift, trie.root.get(), usage);
+    trie.addUsage(0, trie.tail.get(), usage);
+    return usage;
+}
+
+template <class T>
+bool PersistentList<T>::isEmpty() const {
+    return trie.count == 0;
+}
+
+template <class T>
+bool PersistentList<T>::contains(const T& elem) const {
+    return trie.visit([&elem](const T& current) -> bool {
+        return current == elem;
+    });
+}
+
+template <class T>
+bool PersistentList<T>::exists(const function<bool (const T&)>& predicate) const {
+    return trie.visit(predicate);
+}
+
+template <class T>
+bool PersistentList<T>::forAll(const function<bool (const T&)>& predicate) const {
+    return !trie.visit([&predicate](const T& elem) -> bool {
+        return !predicate(elem);
+    });
+}
+
+template <class T>
+void PersistentList<T>::each(const function<void (const T&)>& lambda) const {
+    trie.visit([&lambda](const T& elem) -> bool {
+        lambda(elem);
+        return false;
+    });
+}
+
+template <class T>
+void PersistentList<T>::each(const function<void (T&)>& lambda) {
+    Transient builder;
+
+    trie.visit([&builder, &lambda](const T& elem) -> bool {
+        T copy(elem);
+
+        lambda(copy);
+        builder.add(std::move(copy));
+        return false;
+    });
+    trie= builder.persistent().trie;
+}
+
+template <class T>
+void PersistentList<T>::eachReverse(const function<void (const T&)>& lambda) const {
+    for(int start= (trie.count - 1) & ~MASK; start >= 0; start-= WIDTH) {
+        const vector<T>& values= trie.leafAt(start).values;
+
+        for(int i= values.size() - 1; i >= 0; i--) {
+            lambda(values[i]);
+        }
+    }
+}
+
+template <class T>
+bool PersistentList<T>::remove(const T& elem) {
+    int index= 0;
+
+    bool found= trie.visit([&elem, &index](const T& current) -> bool {
+        if (current == elem) {
+            return true;
+        }
+        index++;
+        return false;
+    });
+
+    if (found) {
+        minus(index);
+        return true;
+    }
+    return false;
+}
+
+template <class T>
+bool PersistentList<T>::add(const T& elem) {
+    trie.push(elem, 0);
+    return true;
+}
+
+template <class T>
+bool PersistentList<T>::add(T&& elem) {
+    trie.push(std::move(elem), 0);
+    return true;
+}
+
+template <class T>
+bool PersistentList<T>::add(int index, const T& elem) {
+    if (index < 0) {
+        stringstream msg;
+        msg << "Index (" << index << ") cannot be negative";
+        throw out_of_range(msg.str());
+    } else if (index >= trie.count) {
+        Transient builder(*this);
+
+        while(builder.size() < index) {
+            builder.add(T());
+        }
+        builder.add(elem);
+        trie= builder.persistent().trie;
+    } else {
+        rebuild(index, &elem, 0);
+    }
+    return true;
+}
+
+template <class T>
+void PersistentList<T>::clear() {
+    trie= Trie();
+}
+
+template <class T>
+PersistentList<T>* PersistentList<T>::reverse() const {
+    Transient builder;
+
+    eachReverse([&builder](const T& elem) -> void {
+        builder.add(elem);
+    });
+    return new PersistentList<T>(builder.persistent());
+}
+
+template <class T>
+PersistentList<T>* PersistentList<T>::reverse(bool mutate) {
+    PersistentList<T>* reversed= reverse();
+
+    if (mutate) {
+        trie= reversed->trie;
+        delete reversed;
+        return NULL;
+    }
+    return reversed;
+}
+
+template <class T>
+void PersistentList<T>::resize(int newSize) {
+    if (newSize <= 0) {
+        clear();
+    } else if (newSize < trie.count) {
+        Transient builder(*this);
+
+        while(builder.size() > newSize) {
+            builder.pop();
+        }
+        trie= builder.persistent().trie;
+    }
+}
+
+template <class T>
+void PersistentList<T>::set(int index, const T& elem) throw(out_of_range) {
+    this->rangeCheck(index, trie.count);
+    trie.assign(index, elem, 0);
+}
+
+template <class T>
+T PersistentList<T>::minus(int index) throw(out_of_range) {
+    this->rangeCheck(index, trie.count);
+
+    T removed(trie.at(index));
+    if (index == trie.count - 1) {
+        trie.pop(0);
+    } else {
+        rebuild(index, NULL, 1);
+    }
+    return removed;
+}
+
+template <class T>
+T PersistentList<T>::get(int index) const throw(out_of_range) {
+    return at(index);
+}
+
+template <class T>
+const T& PersistentList<T>::at(int index) const throw(out_of_range) {
+    this->rangeCheck(index, trie.count);
+    return trie.at(index);
+}
+
+template <class T>
+PersistentList<T>* PersistentList<T>::subList(int startIndex, int endIndex) const throw(out_of_range, invalid_argument) {
+    if (startIndex < 0 || startIndex >= trie.count || endIndex < 0 || endIndex >= trie.count) {
+        stringstream msg;
+        msg << "Indices (" << startIndex << ", " << endIndex << ") lay outside the range [0, " << trie.count - 1 << "]";
+        throw out_of_range(msg.str());
+    } else if (endIndex < startIndex) {
+        stringstream msg;
+        msg << "End index < start index (" << endIndex << " < " << startIndex << ")";
+        throw invalid_argument(msg.str());
+    }
+
+    Transient builder;
+    if (startIndex == 0) {
+        builder= Transient(*this);
+        while(builder.size() > endIndex + 1) {
+            builder.pop();
+        }
+    } else {
+        for(int i= startIndex; i <= endIndex; i++) {
+            builder.add(trie.at(i));
+        }
+    }
+    return new PersistentList<T>(builder.persistent());
+}
+
+template <class T>
+PersistentList<T> PersistentList<T>::appended(const T& elem) const {
+    PersistentList<T> next(*this);
+
+    next.trie.push(elem, 0);
+    return next;
+}
+
+template <class T>
+PersistentList<T> PersistentList<T>::updated(int index, const T& elem) const {
+    PersistentList<T> next(*this);
+
+    next.set(index, elem);
+    return next;
+}
+
+template <class T>
+typename PersistentList<T>::Transient PersistentList<T>::transient() const {
+    return Transient(*this);
+}
+
+template <class T> template <class U>
+typename PersistentList<T>::template rebind<U>::other PersistentList<T>::map(const function<U (const T&)>& transform) const {
+    typename rebind<U>::other::Transient builder;
+
+    each([&builder, &transform](const T& elem) -> void {
+        builder.add(transform(elem));
+    });
+    return builder.persistent();
+}
+
+template <class T>
+const shared_ptr<typename PersistentList<T>::Branch>& PersistentList<T>::emptyBranch() {
+    static const shared_ptr<Branch> branch= make_shared<Branch>(0);
+
+    return branch;
+}
+
+template <class T>
+const shared_ptr<typename PersistentList<T>::Leaf>& PersistentList<T>::emptyLeaf() {
+    static const shared_ptr<Leaf> leaf= make_shared<Leaf>(0);
+
+    return leaf;
+}
+
+template <class T>
+long PersistentList<T>::nextOwner() {
+    static std::atomic<long> owners(0);
+
+    return ++owners;
+}
+
+template <class T>
+shared_ptr<typename PersistentList<T>::Branch> PersistentList<T>::editable(const shared_ptr<Branch>& branch, long owner) {
+    if (owner != 0 && branch->owner == owner) {
+        return branch;
+    }
+    return make_shared<Branch>(*branch, owner);
+}
+
+template <class T>
+shared_ptr<typename PersistentList<T>::Leaf> PersistentList<T>::editable(const shared_ptr<Leaf>& leaf, long owner) {
+    if (owner != 0 && leaf->owner == owner) {
+        return leaf;
+    }
+    return make_shared<Leaf>(*leaf, owner);
+}
+
+template <class T>
+void PersistentList<T>::rebuild(int index, const T* elem, int skip) {
+    Transient builder(*this);
+    vector<T> moved;
+
+    while(builder.size() > index) {
+        moved.push_back(builder.at(builder.size() - 1));
+        builder.pop();
+    }
+    if (elem != NULL) {
+        builder.add(*elem);
+    }
+    for(int i= moved.size() - 1 - skip; i >= 0; i--) {
+        builder.add(std::move(moved[i]));
+    }
+    trie= builder.persistent().trie;
+}
+
+}   //namespace list
+}   //namespace collections
+}   //namespace etsai
+
+#endif
@@ -0,0 +1,541 @@
+#ifndef ETSAI_COLLECTIONS_LIST_SEGMENTEDARRAYLIST_H
+#define ETSAI_COLLECTIONS_LIST_SEGMENTEDARRAYLIST_H
+
+#include "List.h"
+#include "src/Segments.h"
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+namespace etsai {
+namespace collections {
+namespace list {
+
+using std::initializer_list;
+using std::invalid_argument;
+using std::length_error;
+using std::out_of_range;
+using std::stringstream;
+
+/**
+ * Implements the List abstract class with a directory of arrays that double in size.  Growing the list allocates
+ * one more array and never copies or moves the elements already stored, so the cost of an add does not depend on
+ * the size of the list and memory use never spikes to hold two copies of it.  The index of an element is split
+ * into its array and its position in the array with a shift and a mask, so get and at are O(1).
+ *
+ * Elements stay at the same address until they are shifted by an insertion or removal before them, or dropped by
+ * resize.  Appending and growing never invalidate references returned by at.
+ * @author etsai
+ */
+template <class T>
+class SegmentedArrayList : public collections::List<T> {
+public:
+    /**
+     * Gives the SegmentedArrayList type holding elements of type U
+     */
+    template <class U>
+    struct rebind {
+        typedef SegmentedArrayList<U> other;
+    };
+
+    /**
+     * Constructs an empty list that has not allocated any arrays
+     */
+    SegmentedArrayList();
+    /**
+     * Copy constructor.  The copy allocates only the arrays needed to hold the list's elements.
+     */
+    SegmentedArrayList(const SegmentedArrayList<T>& list);
+    /**
+     * Move constructor.  The moved from list is left empty with 0 capacity.
+     */
+    SegmentedArrayList(SegmentedArrayList<T>&& list);
+    /**
+     * Constructs a list with the elements of the initializer list
+     * @param   collection  Initial values for the list
+     */
+    SegmentedArrayList(initializer_list<T> collection);
+    /**
+     * Frees every array
+     */
+    ~SegmentedArrayList();
+    /**
+     * Move assignment.  The moved from list is left empty with 0 capacity.
+     */
+    SegmentedArrayList<T>& operator =(SegmentedArrayList<T>&& list);
+
+    virtual SegmentedArrayList<T>* clone() const;
+    virtual bool equals(initializer_list<T> collection) const;
+    virtual bool equals(const Collection<T>* collection) const;
+    virtual int size() const;
+    /**
+     * Get the number of slots in the allocated arrays
+     */
+    virtual int capacity() const;
+    /**
+     * Get the heap bytes of the allocated arrays, counting the directory as overhead
+     */
+    virtual MemoryUsage memoryUsage() const;
+    virtual bool isEmpty() const;
+    virtual bool contains(const T& elem) const;
+    virtual bool exists(const function<bool (const T&)>& predicate) const;
+    virtual bool forAll(const function<bool (const T&)>& predicate) const;
+    virtual void each(const function<void (const T&)>& lambda) const;
+    virtual void each(const function<void (T&)>& lambda);
+    virtual void eachReverse(const function<void (const T&)>& lambda) const;
+    virtual bool remove(const T& elem);
+    /**
+     * Appends the element, allocating a new array twice the size of the last one if the list is full
+     * @throws  length_error    If the list already holds the maximum number of elements
+     */
+    virtual bool add(const T& elem);
+    virtual bool add(T&& elem);
+    /**
+     * Inserts the element at the index, shifting the elements after it back by one.  If the index is past the end,
+     * the gap is filled with default constructed elements.
+     */
+    virtual bool add(int index, const T& elem);
+    virtual bool add(int index, T&& elem);
+    /**
+     * Removes every element.  The arrays are kept for reuse; call resize to free them.
+     */
+    virtual void clear();
+    virtual SegmentedArrayList<T>* reverse() const;
+    virtual SegmentedArrayList<T>* reverse(bool mutate);
+    /**
+     * Allocates arrays until the capacity is at least the new size, or frees the arrays not needed to hold the new
+     * size.  The capacity only changes by whole arrays, so it may stay larger than the new size.
+     */
+    virtual void resize(int newSize);
+    virtual void set(int index, const T& elem) throw(out_of_range);
+    virtual void set(int index, T&& elem) throw(out_of_range);
+    virtual T minus(int index) throw(out_of_range);
+    virtual T get(int index) const throw(out_of_range);
+    /**
+     * Get a reference to the element at the index.  The reference stays valid as the list grows.
+     */
+    virtual const T& at(int index) const throw(out_of_range);
+    virtual SegmentedArrayList<T>* subList(int startIndex, int endIndex) const throw(out_of_range, invalid_argument);
+    /**
+     * Transforms the list from T list -> U list.  Evaluates [f(a0), f(a1), ..., f(an)].
+     * @param   transform   Lambda that maps T -> U
+     * @return  List of the transformed values
+     */
+    template <class U>
+    typename rebind<U>::other map(const function<U (const T&)>& transform) const;
+
+private:
+    template <class U>
+    friend class SegmentedArrayList;
+
+    /**
+     * Get the element slot for the index, which must be below the capacity
+     */
+    T& slot(int index) const;
+    /**
+     * Allocates arrays until the capacity is at least the given number of elements
+     */
+    void reserve(long count);
+    template <class U>
+    bool insert(int index, U&& elem);
+    /**
+     * Applies the lambda to each element in order, one array at a time, stopping when the lambda returns true
+     * @return  True if the lambda stopped the scan
+     */
+    bool scan(const function<bool (T&)>& lambda) const;
+
+    T* segments[segmented::SEGMENTS];
+    /** Number of allocated arrays, which are always the first ones in the directory */
+    int segmentCount;
+    int listSize;
+};
+
+
+template <class T>
+SegmentedArrayList<T>::SegmentedArrayList() : segmentCount(0), listSize(0) {
+    std::fill(segments, segments + segmented::SEGMENTS, (T*) NULL);
+}
+
+template <class T>
+SegmentedArrayList<T>::SegmentedArrayList(const SegmentedArrayList<T>& list) : SegmentedArrayList() {
+    reserve(list.listSize);
+    for(int i= 0, copied= 0; copied < list.listSize; i++) {
+        int count= std::min<long>(segmented::slotsIn(i + 1) - copied, list.listSize - copied);
+
+        std::copy(list.segments[i], list.segments[i] + count, segments[i]);
+        copied+= count;
+    }
+    listSize= list.listSize;
+}
+
+template <class T>
+SegmentedArrayList<T>::SegmentedArrayList(SegmentedArrayList<T>&& list) : segmentCount(list.segmentCount), listSize(list.listSize) {
+    std::copy(list.segments, list.segments + segmented::SEGMENTS, segments);
+    std::fill(list.segments, list.segments + segmented::SEGMENTS, (T*) NULL);
+    list.segmentCount= 0;
+    list.listSize= 0;
+}
+
+template <class T>
+SegmentedArrayList<T>::SegmentedArrayList(initializer_list<T> collection) : SegmentedArrayList() {
+    reserve(collection.size());
+    for(const T& elem: collection) {
+        slot(listSize)= elem;
+        listSize++;
+    }
+}
+
+template <class T>
+SegmentedArrayList<T>::~SegmentedArrayList() {
+    for(int i= 0; i < segmentCount; i++) {
+        delete[] segments[i];
+    }
+}
+
+template <class T>
+SegmentedArrayList<T>& SegmentedArrayList<T>::operator =(SegmentedArrayList<T>&& list) {
+    if (this != &list) {
+        for(int i= 0; i < segmentCount; i++) {
+            delete[] segments[i];
+        }
+        std::copy(list.segments, list.segments + segmented::SEGMENTS, segments);
+        std::fill(list.segments, list.segments + segmented::SEGMENTS, (T*) NULL);
+        segmentCount= list.segmentCount;
+        listSize= list.listSize;
+        list.segmentCount= 0;
+        list.listSize= 0;
+    }
+    return *this;
+}
+
+template <class T>
+SegmentedArrayList<T>* SegmentedArrayList<T>::clone() const {
+    return new SegmentedArrayList<T>(*this);
+}
+
+template <class T>
+bool SegmentedArrayList<T>::equals(initializer_list<T> collection) const {
+    int index= 0;
+
+    if ((int) collection.size() != listSize) {
+        return false;
+    }
+    for(const T& elem: collection) {
+        if (!(slot(index) == elem)) {
+            return false;
+        }
+        index++;
+    }
+    return true;
+}
+
+template <class T>
+bool SegmentedArrayList<T>::equals(const Collection<T>* collection) const {
+    int index= 0;
+    bool equal= true;
+
+    if (collection->size() != listSize) {
+        return false;
+    }
+    collection->each([&equal, &index, this](const T& elem) -> void {
+        equal= equal && (slot(index) == elem);
+        index++;
+    });
+    return equal;
+}
+
+template <class T>
+int SegmentedArrayList<T>::size() const {
+    return listSize;
+}
+
+template <class T>
+int SegmentedArrayList<T>::capacity() const {
+    return std::min<long>(segmented::slotsIn(segmentCount), std::numeric_limits<int>::max());
+}
+
+template <class T>
+MemoryUsage SegmentedArrayList<T>::memoryUsage() const {
+    long slots= segmented::slotsIn(segmentCount);
+
+    return MemoryUsage(listSize * sizeof(T), (slots - listSize) * sizeof(T), segmentCount * sizeof(T*));
+}
+
+template <class T>
+bool SegmentedArrayList<T>::isEmpty() const {
+    return listSize == 0;
+}
+
+template <class T>
+bool SegmentedArrayList<T>::contains(const T& elem) const {
+    return scan([&elem](T& current) -> bool {
+        return current == elem;
+    });
+}
+
+template <class T>
+bool SegmentedArrayList<T>::exists(const function<bool (const T&)>& predicate) const {
+    return scan([&predicate](T& elem) -> bool {
+        return predicate(elem);
+    });
+}
+
+template <class T>
+bool SegmentedArrayList<T>::forAll(const function<bool (const T&)>& predicate) const {
+    return !scan([&predicate](T& elem) -> bool {
+        return !predicate(elem);
+    });
+}
+
+template <class T>
+void SegmentedArrayList<T>::each(const function<void (const T&)>& lambda) const {
+    scan([&lambda](T& elem) -> bool {
+        lambda(elem);
+        return false;
+    });
+}
+
+template <class T>
+void SegmentedArrayList<T>::each(const function<void (T&)>& lambda) {
+    scan([&lambda](T& elem) -> bool {
+        lambda(elem);
+        return false;
+    });
+}
+
+template <class T>
+void SegmentedArrayList<T>::eachReverse(const function<void (const T&)>& lambda) const {
+    for(int i= listSize - 1; i >= 0; i--) {
+        lambda(slot(i));
+    }
+}
+
+template <class T>
+bool SegmentedArrayList<T>::remove(const T& elem) {
+    int index= 0;
+
+    bool found= scan([&elem, &index](T& current) -> bool {
+        if (current == elem) {
+            return true;
+        }
+        index++;
+        return false;
+    });
+
+    if (found) {
+        minus(index);
+    }
+    return found;
+}
+
+template <class T>
+bool SegmentedArrayList<T>::add(const T& elem) {
+    return insert(listSize, elem);
+}
+
+template <class T>
+bool SegmentedArrayList<T>::add(T&& elem) {
+    return insert(listSize, std::move(elem));
+}
+
+template <class T>
+bool SegmentedArrayList<T>::add(int index, const T& elem) {
+    if (index < listSize) {
+        T copy(elem);
+        return insert(index, std::move(copy));
+    }
+    return insert(index, elem);
+}
+
+template <class T>
+bool SegmentedArrayList<T>::add(int index, T&& elem) {
+    return insert(index, std::move(elem));
+}
+
+template <class T>
+void SegmentedArrayList<T>::clear() {
+    listSize= 0;
+}
+
+template <class T>
+SegmentedArrayList<T>* SegmentedArrayList<T>::reverse() const {
+    SegmentedArrayList<T>* reversed= new SegmentedArrayList<T>();
+
+    reversed->reserve(listSize);
+    eachReverse([reversed](const T& elem) -> void {
+        reversed->slot(reversed->listSize)= elem;
+        reversed->listSize++;
+    });
+    return reversed;
+}
+
+template <class T>
+SegmentedArrayList<T>* SegmentedArrayList<T>::reverse(bool mutate) {
+    if (mutate) {
+        for(int left= 0, right= listSize - 1; left < right; left++, right--) {
+            std::swap(slot(left), slot(right));
+        }
+        return NULL;
+    }
+    return reverse();
+}
+
+template <class T>
+void SegmentedArrayList<T>::resize(int newSize) {
+    int needed= 0;
+
+    if (newSize < 0) {
+        return;
+    }
+    while(segmented::slotsIn(needed) < newSize) {
+        needed++;
+    }
+    if (needed > segmentCount) {
+        reserve(newSize);
+    } else {
+        while(segmentCount > needed) {
+            segmentCount--;
+            delete[] segments[segmentCount];
+            segments[segmentCount]= NULL;
+        }
+        listSize= std::min(listSize, newSize);
+    }
+}
+
+template <class T>
+void SegmentedArrayList<T>::set(int index, const T& elem) throw(out_of_range) {
+    this->rangeCheck(index, listSize);
+    slot(index)= elem;
+}
+
+template <class T>
+void SegmentedArrayList<T>::set(int index, T&& elem) throw(out_of_range) {
+    this->rangeCheck(index, listSize);
+    slot(index)= std::move(elem);
+}
+
+template <class T>
+T SegmentedArrayList<T>::minus(int index) throw(out_of_range) {
+    this->rangeCheck(index, listSize);
+
+    T elem(std::move(slot(index)));
+    for(int i= index + 1; i < listSize; i++) {
+        slot(i - 1)= std::move(slot(i));
+    }
+    listSize--;
+    return elem;
+}
+
+template <class T>
+T SegmentedArrayList<T>::get(int index) const throw(out_of_range) {
+    return at(index);
+}
+
+template <class T>
+const T& SegmentedArrayList<T>::at(int index) const throw(out_of_range) {
+    this->rangeCheck(index, listSize);
+    return slot(index);
+}
+
+template <class T>
+SegmentedArrayList<T>* SegmentedArrayList<T>::subList(int startIndex, int endIndex) const throw(out_of_range, invalid_argument) {
+    if (startIndex < 0 || startIndex >= listSize || endIndex < 0 || endIndex >= listSize) {
+        stringstream msg;
+        msg << "Indices (" << startIndex << ", " << endIndex << ") lay outside the range [0, " << listSize - 1 << "]";
+        throw out_of_range(msg.str());
+    } else if (endIndex < startIndex) {
+        stringstream msg;
+        msg << "End index < start index (" << endIndex << " < " << startIndex << ")";
+        throw invalid_argument(msg.str());
+    }
+
+    SegmentedArrayList<T>* newList= new SegmentedArrayList<T>();
+    newList->reserve(endIndex - startIndex + 1);
+    for(int i= startIndex; i <= endIndex; i++) {
+        newList->slot(newList->listSize)= slot(i);
+        newList->listSize++;
+    }
+    return newList;
+}
+
+template <class T> template <class U>
+typename SegmentedArrayList<T>::template rebind<U>::other SegmentedArrayList<T>::map(const function<U (const T&)>& transform) const {
+    typename rebind<U>::other mapped;
+
+    mapped.reserve(listSize);
+    each([&mapped, &transform](const T& elem) -> void {
+        mapped.slot(mapped.listSize)= transform(elem);
+        mapped.listSize++;
+    });
+    return mapped;
+}
+
+template <class T>
+T& SegmentedArrayList<T>::slot(int index) const {
+    segmented::Location location= segmented::locate(index);
+
+    return segments[location.segment][location.offset];
+}
+
+template <class T>
+void SegmentedArrayList<T>::reserve(long count) {
+    while(segmented::slotsIn(segmentCount) < count) {
+        segments[segmentCount]= new T[segmented::length(segmentCount)];
+        segmentCount++;
+    }
+}
+
+template <class T> template <class U>
+bool SegmentedArrayList<T>::insert(int index, U&& elem) {
+    if (index < 0) {
+        stringstream msg;
+        msg << "Index (" << index << ") cannot be negative";
+        throw out_of_range(msg.str());
+    } else if (index == std::numeric_limits<int>::max() || listSize == std::numeric_limits<int>::max()) {
+        throw length_error("SegmentedArrayList cannot hold more elements");
+    }
+
+    if (index >= listSize) {
+        reserve(index + 1L);
+        for(int i= listSize; i < index; i++) {
+            slot(i)= T();
+        }
+        slot(index)= std::forward<U>(elem);
+        listSize= index + 1;
+    } else {
+        reserve(listSize + 1L);
+        for(int i= listSize; i > index; i--) {
+            slot(i)= std::move(slot(i - 1));
+        }
+        slot(index)= std::forward<U>(elem);
+        listSize++;
+    }
+    return true;
+}
+
+template <class T>
+bool SegmentedArrayList<T>::scan(const function<bool (T&)>& lambda) const {
+    for(int i= 0, visited= 0; visited < listSize; i++) {
+        int count= std::min<long>(segmented::slotsIn(i + 1) - visited, listSize - visited);
+        T* segment= segments[i];
+
+        for(int j= 0; j < count; j++) {
+            if (lambda(segment[j])) {
+                return true;
+            }
+        }
+        visited+= count;
+    }
+    return false;
+}
+
+}   //namespace list
+}   //namespace collections
+}   //namespace etsai
+
+#endif
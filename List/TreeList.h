@@ -0,0 +1,698 @@
+#ifndef ETSAI_COLLECTIONS_LIST_TREELIST_H
+#define ETSAI_COLLECTIONS_LIST_TREELIST_H
+
+#include "List.h"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <initializer_list>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace etsai {
+namespace collections {
+namespace list {
+
+using std::initializer_list;
+using std::invalid_argument;
+using std::out_of_range;
+using std::stringstream;
+using std::vector;
+
+/**
+ * Implements the List abstract class with a treap keyed by position.  Every node stores the number of nodes in its
+ * subtree, so the node at an index is found by walking down from the root, and carries a random priority that keeps
+ * the tree balanced with high probability.  get, set, at, add at any index, and minus are all O(log n).
+ *
+ * A list can be cut in two with split, or have another list joined to its end with concat, in O(log n) without
+ * copying any elements.  Copies, subList, reverse, and map build the new tree from the elements in order in O(n).
+ * @author etsai
+ */
+template <class T>
+class TreeList : public collections::List<T> {
+public:
+    /**
+     * Gives the TreeList type holding elements of type U
+     */
+    template <class U>
+    struct rebind {
+        typedef TreeList<U> other;
+    };
+
+    /**
+     * Constructs an empty list
+     */
+    TreeList();
+    /**
+     * Copy constructor
+     */
+    TreeList(const TreeList<T>& list);
+    /**
+     * Move constructor.  The moved from list is left empty.
+     */
+    TreeList(TreeList<T>&& list);
+    /**
+     * Constructs a list with the elements of the initializer list
+     * @param   collection  Initial values for the list
+     */
+    TreeList(initializer_list<T> collection);
+    /**
+     * Frees every node
+     */
+    ~TreeList();
+    /**
+     * Move assignment.  The moved from list is left empty.
+     */
+    TreeList<T>& operator =(TreeList<T>&& list);
+
+    virtual TreeList<T>* clone() const;
+    virtual bool equals(initializer_list<T> collection) const;
+    virtual bool equals(const Collection<T>* collection) const;
+    virtual int size() const;
+    /**
+     * Get the number of elements, since the list allocates a node per element and has no spare capacity
+     */
+    virtual int capacity() const;
+    /**
+     * Get the heap bytes of the nodes, counting the links, subtree sizes, and priorities as overhead
+     */
+    virtual MemoryUsage memoryUsage() const;
+    virtual bool isEmpty() const;
+    virtual bool contains(const T& elem) const;
+    virtual bool exists(const function<bool (const T&)>& predicate) const;
+    virtual bool forAll(const function<bool (const T&)>& predicate) const;
+    virtual void each(const function<void (const T&)>& lambda) const;
+    virtual void each(const function<void (T&)>& lambda);
+    virtual void eachReverse(const function<void (const T&)>& lambda) const;
+    virtual bool remove(const T& elem);
+    virtual bool add(const T& elem);
+    virtual bool add(T&& elem);
+    /**
+     * Inserts the element at the index in O(log n).  If the index is past the end, the gap is filled with default
+     * constructed elements.
+     */
+    virtual bool add(int index, const T& elem);
+    virtual bool add(int index, T&& elem);
+    virtual void clear();
+    virtual TreeList<T>* reverse() const;
+    /**
+     * Reverses the list.  Reversing in place swaps the children of every node, in O(n) without moving any element.
+     */
+    virtual TreeList<T>* reverse(bool mutate);
+    /**
+     * Shrinks the list to the new size by dropping elements from the end, in O(log n) plus the time to free them.
+     * A larger size leaves the list unchanged, since the list has no capacity to reserve.
+     */
+    virtual void resize(int newSize);
+    virtual void set(int index, const T& elem) throw(out_of_range);
+    virtual void set(int index, T&& elem) throw(out_of_range);
+    virtual T minus(int index) throw(out_of_range);
+    virtual T get(int index) const throw(out_of_range);
+    virtual const T& at(int index) const throw(out_of_range);
+    virtual TreeList<T>* subList(int startIndex, int endIndex) const throw(out_of_range, invalid_argument);
+    virtual void accept(Dispatcher<T>& dispatcher) const;
+    /**
+     * Moves the elements from the index to the end into a new list, in O(log n).  This list keeps the elements
+     * before the index.
+     * @param   index   Index of the first element to move, which may be the list size to move none
+     * @return  List of the elements from the index on
+     * @throws  out_of_range    If the index is outside [0, size]
+     */
+    TreeList<T> split(int index);
+    /**
+     * Moves every element of the given list to the end of this list, in O(log n).  The given list is left empty.
+     * @param   list    List whose elements to append
+     */
+    void concat(TreeList<T>& list);
+    /**
+     * Transforms the list from T list -> U list.  Evaluates [f(a0), f(a1), ..., f(an)].
+     * @param   transform   Lambda that maps T -> U
+     * @return  List of the transformed values
+     */
+    template <class U>
+    typename rebind<U>::other map(const function<U (const T&)>& transform) const;
+
+private:
+    template <class U>
+    friend class TreeList;
+
+    struct Node {
+        template <class U>
+        Node(U&& value, unsigned priority) : value(std::forward<U>(value)), priority(priority), count(1), left(NULL), right(NULL) {
+        }
+
+        T value;
+        /** Nodes have a higher priority than every node below them */
+        unsigned priority;
+        /** Number of nodes in the subtree rooted at this node */
+        int count;
+        Node* left;
+        Node* right;
+    };
+
+    /**
+     * Builds a tree from elements given in order in O(n), keeping the right spine of the tree on a stack.  A new
+     * node becomes the right child of the last spine node with a higher priority, and adopts the nodes it pops as
+     * its left subtree.
+     */
+    class Builder {
+    public:
+        explicit Builder(TreeList<T>& list);
+        /**
+         * Frees the nodes of a tree that was never finished
+         */
+        ~Builder();
+
+        template <class U>
+        void add(U&& elem);
+        /**
+         * Gives the tree to the list, replacing its elements
+         */
+        void finish();
+
+    private:
+        TreeList<T>& list;
+        vector<Node*> spine;
+    };
+
+    static int count(const Node* node);
+    static void update(Node* node);
+    static void destroy(Node* node);
+    /**
+     * Splits the tree into its first index nodes and the rest
+     */
+    static void split(Node* node, int index, Node*& left, Node*& right);
+    /**
+     * Joins two trees, with every node of the left tree before every node of the right
+     */
+    static Node* merge(Node* left, Node* right);
+    static void mirror(Node* node);
+    /**
+     * Applies the lambda to the nodes in order, stopping when it returns true
+     * @return  True if the lambda stopped the traversal
+     */
+    static bool visit(Node* node, const function<bool (T&)>& lambda);
+    static void visitReverse(const Node* node, const function<void (const T&)>& lambda);
+    /**
+     * Get a new priority from a generator shared by all lists, so trees split off from or joined to each other
+     * stay balanced
+     */
+    static unsigned nextPriority();
+
+    Node* node(int index) const;
+    template <class U>
+    bool insert(int index, U&& elem);
+
+    Node* root;
+};
+
+template <class T>
+TreeList<T>::Builder::Builder(TreeList<T>& list) : list(list) {
+}
+
+template <class T>
+TreeList<T>::Builder::~Builder() {
+    if (!spine.empty()) {
+        spine.back()->right= NULL;
+        destroy(spine.front());
+    }
+}
+
+template <class T> template <class U>
+void TreeList<T>::Builder::add(U&& elem) {
+    Node* added= new Node(std::forward<U>(elem), nextPriority());
+    Node* popped= NULL;
+
+    while(!spine.empty() && spine.back()->priority < added->priority) {
+        popped= spine.back();
+        spine.pop_back();
+        update(popped);
+    }
+    added->left= popped;
+    if (!spine.empty()) {
+        spine.back()->right= added;
+    }
+    spine.push_back(added);
+}
+
+template <class T>
+void TreeList<T>::Builder::finish() {
+    for(int i= spine.size() - 1; i >= 0; i--) {
+        update(spine[i]);
+    }
+    destroy(list.root);
+    list.root= spine.empty() ? NULL : spine.front();
+    spine.clear();
+}
+
+template <class T>
+TreeList<T>::TreeList() : root(NULL) {
+}
+
+template <class T>
+TreeList<T>::TreeList(const TreeList<T>& list) : root(NULL) {
+    Builder builder(*this);
+
+    list.each([&builder](const T& elem) -> void {
+        builder.add(elem);
+    });
+    builder.finish();
+}
+
+template <class T>
+TreeList<T>::TreeList(TreeList<T>&& list) : root(list.root) {
+    list.root= NULL;
+}
+
+template <class T>
+TreeList<T>::TreeList(initializer_list<T> collection) : root(NULL) {
+    Builder builder(*this);
+
+    for(const T& elem: collection) {
+        builder.add(elem);
+    }
+    builder.finish();
+}
+
+template <class T>
+TreeList<T>::~TreeList() {
+    destroy(root);
+}
+
+template <class T>
+TreeList<T>& TreeList<T>::operator =(TreeList<T>&& list) {
+    if (this != &list) {
+        destroy(root);
+        root= list.root;
+        list.root= NULL;
+    }
+    return *this;
+}
+
+template <class T>
+TreeList<T>* TreeList<T>::clone() const {
+    return new TreeList<T>(*this);
+}
+
+template <class T>
+bool TreeList<T>::equals(initializer_list<T> collection) const {
+    const T* next= collection.begin();
+
+    if ((int) collection.size() != size()) {
+        return false;
+    }
+    return !visit(root, [&next](T& elem) -> bool {
+        return !(elem == *(next++));
+    });
+}
+
+template <class T>
+bool TreeList<T>::equals(const Collection<T>* collection) const {
+    vector<const T*> values;
+    int index= 0;
+    bool equal= true;
+
+    if (collection->size() != size()) {
+        return false;
+    }
+    values.reserve(size());
+    each([&values](const T& elem) -> void {
+        values.push_back(&elem);
+    });
+    collection->each([&equal, &index, &values](const T& elem) -> void {
+        equal= equal && (*values[index] == elem);
+        index++;
+    });
+    return equal;
+}
+
+template <class T>
+int TreeList<T>::size() const {
+    return count(root);
+}
+
+template <class T>
+int TreeList<T>::capacity() const {
+    return count(root);
+}
+
+template <class T>
+MemoryUsage TreeList<T>::memoryUsage() const {
+    int nodes= count(root);
+
+    return MemoryUsage(nodes * sizeof(T), 0, nodes * (sizeof(Node) - sizeof(T)));
+}
+
+template <class T>
+bool TreeList<T>::isEmpty() const {
+    return root == NULL;
+}
+
+template <class T>
+bool TreeList<T>::contains(const T& elem) const {
+    return visit(root, [&elem](T& current) -> bool {
+        return current == elem;
+    });
+}
+
+template <class T>
+bool TreeList<T>::exists(const function<bool (const T&)>& predicate) const {
+    return visit(root, [&predicate](T& elem) -> bool {
+        return predicate(elem);
+    });
+}
+
+template <class T>
+bool TreeList<T>::forAll(const function<bool (const T&)>& predicate) const {
+    return !visit(root, [&predicate](T& elem) -> bool {
+        return !predicate(elem);
+    });
+}
+
+template <class T>
+void TreeList<T>::each(const function<void (const T&)>& lambda) const {
+    visit(root, [&lambda](T& elem) -> bool {
+        lambda(elem);
+        return false;
+    });
+}
+
+template <class T>
+void TreeList<T>::each(const function<void (T&)>& lambda) {
+    visit(root, [&lambda](T& elem) -> bool {
+        lambda(elem);
+        return false;
+    });
+}
+
+template <class T>
+void TreeList<T>::eachReverse(const function<void (const T&)>& lambda) const {
+    visitReverse(root, lambda);
+}
+
+template <class T>
+bool TreeList<T>::remove(const T& elem) {
+    int index= 0;
+
+    bool found= visit(root, [&elem, &index](T& current) -> bool {
+        if (current == elem) {
+            return true;
+        }
+        index++;
+        return false;
+    });
+
+    if (found) {
+        minus(index);
+    }
+    return found;
+}
+
+template <class T>
+bool TreeList<T>::add(const T& elem) {
+    return insert(size(), elem);
+}
+
+template <class T>
+bool TreeList<T>::add(T&& elem) {
+    return insert(size(), std::move(elem));
+}
+
+template <class T>
+bool TreeList<T>::add(int index, const T& elem) {
+    return insert(index, elem);
+}
+
+template <class T>
+bool TreeList<T>::add(int index, T&& elem) {
+    return insert(index, std::move(elem));
+}
+
+template <class T>
+void TreeList<T>::clear() {
+    destroy(root);
+    root= NULL;
+}
+
+template <class T>
+TreeList<T>* TreeList<T>::reverse() const {
+    TreeList<T>* reversed= new TreeList<T>();
+    Builder builder(*reversed);
+
+    eachReverse([&builder](const T& elem) -> void {
+        builder.add(elem);
+    });
+    builder.finish();
+    return reversed;
+}
+
+template <class T>
+TreeList<T>* TreeList<T>::reverse(bool mutate) {
+    if (!mutate) {
+        return reverse();
+    }
+    mirror(root);
+    return NULL;
+}
+
+template <class T>
+void TreeList<T>::resize(int newSize) {
+    if (newSize <= 0) {
+        clear();
+    } else if (newSize < size()) {
+        Node *dropped;
+
+        split(root, newSize, root, dropped);
+        destroy(dropped);
+    }
+}
+
+template <class T>
+void TreeList<T>::set(int index, const T& elem) throw(out_of_range) {
+    this->rangeCheck(index, size());
+    node(index)->value= elem;
+}
+
+template <class T>
+void TreeList<T>::set(int index, T&& elem) throw(out_of_range) {
+    this->rangeCheck(index, size());
+    node(index)->value= std::move(elem);
+}
+
+template <class T>
+T TreeList<T>::minus(int index) throw(out_of_range) {
+    this->rangeCheck(index, size());
+
+    Node *left, *middle, *right;
+    split(root, index, left, right);
+    split(right, 1, middle, right);
+    root= merge(left, right);
+
+    T elem(std::move(middle->value));
+    delete middle;
+    return elem;
+}
+
+template <class T>
+T TreeList<T>::get(int index) const throw(out_of_range) {
+    return at(index);
+}
+
+template <class T>
+const T& TreeList<T>::at(int index) const throw(out_of_range) {
+    this->rangeCheck(index, size());
+    return node(index)->value;
+}
+
+template <class T>
+TreeList<T>* TreeList<T>::subList(int startIndex, int endIndex) const throw(out_of_range, invalid_argument) {
+    int listSize= size();
+
+    if (startIndex < 0 || startIndex >= listSize || endIndex < 0 || endIndex >= listSize) {
+        stringstream msg;
+        msg << "Indices (" << startIndex << ", " << endIndex << ") lay outside the range [0, " << listSize - 1 << "]";
+        throw out_of_range(msg.str());
+    } else if (endIndex < startIndex) {
+        stringstream msg;
+        msg << "End index < start index (" << endIndex << " < " << startIndex << ")";
+        throw invalid_argument(msg.str());
+    }
+
+    TreeList<T>* newList= new TreeList<T>();
+    Builder builder(*newList);
+    int index= 0;
+    visit(root, [&builder, &index, startIndex, endIndex](T& elem) -> bool {
+        if (index >= startIndex) {
+            builder.add(elem);
+        }
+        return ++index > endIndex;
+    });
+    builder.finish();
+    return newList;
+}
+
+template <class T>
+void TreeList<T>::accept(Dispatcher<T>& dispatcher) const {
+    dispatcher.dispatch(*this);
+}
+
+template <class T>
+TreeList<T> TreeList<T>::split(int index) {
+    TreeList<T> rest;
+
+    if (index < 0 || index > size()) {
+        stringstream msg;
+        msg << "Index (" << index << ") out of range [0, " << size() << "]";
+        throw out_of_range(msg.str());
+    }
+    split(root, index, root, rest.root);
+    return rest;
+}
+
+template <class T>
+void TreeList<T>::concat(TreeList<T>& list) {
+    if (this != &list) {
+        root= merge(root, list.root);
+        list.root= NULL;
+    }
+}
+
+template <class T> template <class U>
+typename TreeList<T>::template rebind<U>::other TreeList<T>::map(const function<U (const T&)>& transform) const {
+    typename rebind<U>::other mapped;
+    typename rebind<U>::other::Builder builder(mapped);
+
+    each([&builder, &transform](const T& elem) -> void {
+        builder.add(transform(elem));
+    });
+    builder.finish();
+    return mapped;
+}
+
+template <class T>
+int TreeList<T>::count(const Node* node) {
+    return node == NULL ? 0 : node->count;
+}
+
+template <class T>
+void TreeList<T>::update(Node* node) {
+    node->count= 1 + count(node->left) + count(node->right);
+}
+
+template <class T>
+void TreeList<T>::destroy(Node* node) {
+    if (node != NULL) {
+        destroy(node->left);
+        destroy(node->right);
+        delete node;
+    }
+}
+
+template <class T>
+void TreeList<T>::split(Node* node, int index, Node*& left, Node*& right) {
+    if (node == NULL) {
+        left= right= NULL;
+    } else if (count(node->left) < index) {
+        split(node->right, index - count(node->left) - 1, node->right, right);
+        left= node;
+        update(node);
+    } else {
+        split(node->left, index, left, node->left);
+        right= node;
+        update(node);
+    }
+}
+
+template <class T>
+typename TreeList<T>::Node* TreeList<T>::merge(Node* left, Node* right) {
+    if (left == NULL) {
+        return right;
+    } else if (right == NULL) {
+        return left;
+    } else if (left->priority > right->priority) {
+        left->right= merge(left->right, right);
+        update(left);
+        return left;
+    }
+    right->left= merge(left, right->left);
+    update(right);
+    return right;
+}
+
+template <class T>
+void TreeList<T>::mirror(Node* node) {
+    if (node != NULL) {
+        std::swap(node->left, node->right);
+        mirror(node->left);
+        mirror(node->right);
+    }
+}
+
+template <class T>
+bool TreeList<T>::visit(Node* node, const function<bool (T&)>& lambda) {
+    return node != NULL && (visit(node->left, lambda) || lambda(node->value) || visit(node->right, lambda));
+}
+
+template <class T>
+void TreeList<T>::visitReverse(const Node* node, const function<void (const T&)>& lambda) {
+    if (node != NULL) {
+        visitReverse(node->right, lambda);
+        lambda(node->value);
+        visitReverse(node->left, lambda);
+    }
+}
+
+template <class T>
+unsigned TreeList<T>::nextPriority() {
+    static std::atomic<unsigned> state(0x9e3779b9);
+    unsigned value= state.fetch_add(0x9e3779b9, std::memory_order_relaxed);
+
+    value^= value >> 16;
+    value*= 0x45d9f3b;
+    value^= value >> 16;
+    return value;
+}
+
+template <class T>
+typename TreeList<T>::Node* TreeList<T>::node(int index) const {
+    Node* current= root;
+
+    while(count(current->left) != index) {
+        if (index < count(current->left)) {
+            current= current->left;
+        } else {
+            index-= count(current->left) + 1;
+            current= current->right;
+        }
+    }
+    return current;
+}
+
+template <class T> template <class U>
+bool TreeList<T>::insert(int index, U&& elem) {
+    int listSize= size();
+
+    if (index < 0) {
+        stringstream msg;
+        msg << "Index (" << index << ") cannot be negative";
+        throw out_of_range(msg.str());
+    }
+    while(listSize < index) {
+        root= merge(root, new Node(T(), nextPriority()));
+        listSize++;
+    }
+
+    Node *added= new Node(std::forward<U>(elem), nextPriority()), *left, *right;
+    split(root, index, left, right);
+    root= merge(merge(left, added), right);
+    return true;
+}
+
+}   //namespace list
+}   //namespace collections
+}   //namespace etsai
+
+#endif
@@ -1,19 +1,34 @@
 
+#include <atomic>
+#include <cstdio>
 #include <functional>
 #include <iostream>
+#include <map>
 #include <memory>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "Collection.h"
 #include "List.h"
 #include "List/ArrayList.h"
+#include "test/AllocationCounter.h"
 
 using etsai::collections::Collection;
+using etsai::collections::CountingInstrumentation;
 using etsai::collections::List;
+using etsai::collections::MemoryRegistry;
+using etsai::collections::MemoryUsage;
+using etsai::collections::OperationCounters;
+using etsai::collections::TextFormat;
+using etsai::collections::WorkStealingPool;
 using etsai::collections::list::ArrayList;
+using etsai::collections::test::AllocationCounter;
+using std::initializer_list;
+using std::map;
+using std::atomic;
 using std::cout;
 using std::endl;
 using std::function;
@@ -23,6 +38,8 @@ using std::out_of_range;
 using std::shared_ptr;
 using std::stringstream;
 using std::string;
+using std::to_string;
+using std::unique_ptr;
 using std::vector;
 
 class Integer {
@@ -62,6 +79,50 @@ ostream& operator <<(ostream& os, const Integer& r) {
     return os;
 }
 
+/**
+ * Counts how many times values are copied, to check that moves are used where possible
+ */
+class Tracked {
+public:
+    static int copies;
+
+    Tracked() : value(0) {
+    }
+    Tracked(int value) : value(value) {
+    }
+    Tracked(int left, int right) : value(left * right) {
+    }
+    Tracked(const Tracked& r) : value(r.value) {
+        copies++;
+    }
+    Tracked(Tracked&& r) : value(r.value) {
+        r.value= -1;
+    }
+    Tracked& operator =(const Tracked& r) {
+        value= r.value;
+        copies++;
+        return *this;
+    }
+    Tracked& operator =(Tracked&& r) {
+        value= r.value;
+        r.value= -1;
+        return *this;
+    }
+
+    int value;
+};
+
+int Tracked::copies= 0;
+
+bool operator ==(const Tracked& l, const Tracked& r) {
+    return l.value == r.value;
+}
+
+ostream& operator <<(ostream& os, const Tracked& r) {
+    os << r.value;
+    return os;
+}
+
 typedef function<void (void)> UnitTest;
 
 #define RESULT_HANDLER(result)\
@@ -476,7 +537,568 @@ int main(int argc, char **argv) {
         cout << l->toString() << endl;
         delete m;
     });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        ArrayList<Integer> l({0, 1, 2, 3, 4});
+        index++;
+        cout << "Test " << index << ": Map 2= ";
+        ArrayList<int> m= l.map<int>([](const Integer& elem) -> int {
+            return elem.get() * 2;
+        });
+        RESULT_HANDLER(m.equals({0, 2, 4, 6, 8}) && m.size() == 5 && m.capacity() == 5);
+        cout << m.toString() << endl;
+    });
+
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        ArrayList<int> l;
+        int transforms= 0;
+        index++;
+        cout << "Test " << index << ": View 1= ";
+        for(int i= 0; i < 100; i++) {
+            l.add(i);
+        }
+        ArrayList<int> m= l.view().map([&transforms](const int& elem) -> int {
+            transforms++;
+            return elem * elem;
+        }).filter([](const int& elem) -> bool {
+            return elem % 2 == 0;
+        }).take(3).toArrayList();
+        RESULT_HANDLER(m.equals({0, 4, 16}) && transforms == 5);
+        cout << m.toString() << endl;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        ArrayList<Integer> l({0, 1, 2, 3, 4, 5});
+        ArrayList<string> names({"zero", "one", "two"});
+        index++;
+        cout << "Test " << index << ": View 2= ";
+        ArrayList<string> m= l.view().zip(names).map([](const std::pair<Integer, string>& elem) -> string {
+            stringstream stream;
+            stream << elem.first.get() << "=" << elem.second;
+            return stream.str();
+        }).toArrayList();
+        RESULT_HANDLER(m.equals({"0=zero", "1=one", "2=two"}) && l.view().take(0).count() == 0 && l.view().take(10).count() == 6);
+        cout << m.toString() << endl;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        ArrayList<int> l({3, 1, 4, 1, 5, 9, 2, 6});
+        int evaluated= 0;
+        index++;
+        cout << "Test " << index << ": View 3= ";
+        bool found= l.view().filter([&evaluated](const int& elem) -> bool {
+            evaluated++;
+            return elem > 2;
+        }).exists([](const int& elem) -> bool {
+            return elem == 4;
+        });
+        RESULT_HANDLER(found && evaluated == 3 && l.view().forAll([](const int& elem) -> bool { return elem > 0; }) && 
+                !l.view().filter([](const int& elem) -> bool { return elem > 4; }).forAll([](const int& elem) -> bool { return elem > 5; }));
+        cout << l.toString() << endl;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        WorkStealingPool pool(4);
+        ArrayList<int> l;
+        index++;
+        cout << "Test " << index << ": Parallel Map= ";
+        for(int i= 0; i < 100000; i++) {
+            l.add(i);
+        }
+        ArrayList<long> m= l.parMap<long>([](const int& elem) -> long {
+            return (long) elem * elem;
+        }, 1000, &pool);
+        bool ordered= true;
+        for(int i= 0; i < m.size(); i++) {
+            ordered= ordered && m.get(i) == (long) i * i;
+        }
+        RESULT_HANDLER(m.size() == l.size() && ordered);
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        WorkStealingPool pool(4);
+        ArrayList<int> l;
+        const ArrayList<int>& constList= l;
+        atomic<long> sum(0);
+        index++;
+        cout << "Test " << index << ": Parallel Each= ";
+        for(int i= 0; i < 50000; i++) {
+            l.add(i);
+        }
+        l.parEach([](int& elem) -> void {
+            elem*= 2;
+        }, 512, &pool);
+        constList.parEach([&sum](const int& elem) -> void {
+            sum+= elem;
+        }, 512, &pool);
+        RESULT_HANDLER(sum.load() == 2L * (49999L * 50000L / 2) && l.get(123) == 246);
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        WorkStealingPool pool(4);
+        ArrayList<int> l;
+        atomic<int> evaluated(0);
+        index++;
+        cout << "Test " << index << ": Parallel Exists/ForAll/Count= ";
+        for(int i= 0; i < 100000; i++) {
+            l.add(i % 1000);
+        }
+        bool found= l.parExists([&evaluated](const int& elem) -> bool {
+            evaluated++;
+            return elem == 999;
+        }, 1000, &pool);
+        RESULT_HANDLER(found && evaluated.load() < l.size() && 
+                !l.parExists([](const int& elem) -> bool { return elem < 0; }, 1000, &pool) && 
+                l.parForAll([](const int& elem) -> bool { return elem < 1000; }, 1000, &pool) && 
+                !l.parForAll([](const int& elem) -> bool { return elem < 999; }, 1000, &pool) && 
+                l.parCount([](const int& elem) -> bool { return elem % 10 == 0; }, 1000, &pool) == 10000);
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        WorkStealingPool pool(4);
+        ArrayList<int> l({1, 2, 3, 4, 5});
+        std::thread::id caller= std::this_thread::get_id();
+        bool sameThread= true;
+        bool thrown= false;
+        index++;
+        cout << "Test " << index << ": Parallel Small Input and Errors= ";
+        l.parExists([&sameThread, caller](const int& elem) -> bool {
+            sameThread= sameThread && std::this_thread::get_id() == caller;
+            return false;
+        }, 0, &pool);
+        for(int i= 0; i < 10000; i++) {
+            l.add(i);
+        }
+        try {
+            l.parCount([](const int& elem) -> bool {
+                if (elem == 5000) {
+                    throw out_of_range("5000");
+                }
+                return true;
+            }, 100, &pool);
+        } catch (out_of_range& ex) {
+            thrown= true;
+        }
+        RESULT_HANDLER(sameThread && thrown);
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        shared_ptr<List<Integer>> l(new ArrayList<Integer>());
+        index++;
+        cout << "Test " << index << ": Fold empty= ";
+        int left= l->foldLeft<int>(7, [](const int& l, const Integer& r) -> int {
+            return l + r.get();
+        });
+        int right= l->foldRight<int>(7, [](const Integer& l, const int& r) -> int {
+            return l.get() + r;
+        });
+        RESULT_HANDLER(left == 7 && right == 7);
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        shared_ptr<List<string>> l(new ArrayList<string>({"a", "b", "c", "d"}));
+        index++;
+        cout << "Test " << index << ": Fold right 2= ";
+        string folded= l->foldRight<string>("|", [](const string& l, const string& r) -> string {
+            return l + r;
+        });
+        RESULT_HANDLER(folded == "abcd|");
+        cout << folded << endl;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        WorkStealingPool pool(4);
+        ArrayList<int> l;
+        index++;
+        cout << "Test " << index << ": Reduce= ";
+        for(int i= 0; i < 200000; i++) {
+            l.add(i % 10);
+        }
+        function<string (const string&, const int&)> append= [](const string& accum, const int& elem) -> string {
+            return accum + (char) ('0' + elem);
+        };
+        string sequential= l.foldLeft<string>("", append);
+        string parallel= l.reduce<string>("", append, [](const string& left, const string& right) -> string {
+            return left + right;
+        }, 1000, &pool);
+        long sum= l.reduce<long>(0, [](const long& accum, const int& elem) -> long {
+            return accum + elem;
+        }, [](const long& left, const long& right) -> long {
+            return left + right;
+        });
+        RESULT_HANDLER(parallel == sequential && parallel.size() == 200000 && sum == 900000);
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        ArrayList<Tracked> l;
+        index++;
+        cout << "Test " << index << ": Move 1= ";
+        Tracked::copies= 0;
+        l.add(Tracked(1));
+        l.emplace(2, 3);
+        l.emplaceAt(0, 4);
+        l.add(1, Tracked(5));
+        l.set(2, Tracked(7));
+        Tracked removed= l.minus(0);
+        RESULT_HANDLER(Tracked::copies == 0 && removed.value == 4 && l.size() == 3 && l.at(0).value == 5 && 
+                l.at(1).value == 7 && l.at(2).value == 6 && &l.at(2) == &l.at(2));
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        ArrayList<string> l({"alpha", "beta"});
+        string gamma("gamma");
+        index++;
+        cout << "Test " << index << ": Move 2= ";
+        l.add(std::move(gamma));
+        l.add(l.at(0));
+        l.add(0, l.at(3));
+        RESULT_HANDLER(gamma.empty() && l.equals({"alpha", "alpha", "beta", "gamma", "alpha"}) && l.minus(3) == "gamma" && 
+                l.equals({"alpha", "alpha", "beta", "alpha"}));
+        cout << l.toString() << endl;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        const char* path= "ArrayListTest.snapshot";
+        ArrayList<long> l;
+        index++;
+        cout << "Test " << index << ": Snapshot 1= ";
+        for(long i= 0; i < 10000; i++) {
+            l.add(i * i);
+        }
+        l.save(path);
+        ArrayList<long> loaded= ArrayList<long>::load(path);
+        ArrayList<long> mapped= ArrayList<long>::loadMapped(path);
+        bool wasMapped= mapped.isMapped() && !loaded.isMapped();
+        bool same= loaded.equals(&l) && mapped.equals(&l) && mapped.at(9999) == 9999L * 9999L;
+        mapped.set(0, mapped.at(1));
+        mapped.add(-1);
+        ArrayList<long> remapped= ArrayList<long>::loadMapped(path, true);
+        RESULT_HANDLER(wasMapped && same && !mapped.isMapped() && mapped.get(0) == 1 && mapped.size() == 10001 && remapped.equals(&l));
+        remove(path);
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        const char* path= "ArrayListTest.snapshot";
+        ArrayList<int> l({1, 2, 3, 4});
+        int errors= 0;
+        index++;
+        cout << "Test " << index << ": Snapshot 2= ";
+        l.save(path);
+        try {
+            ArrayList<double>::load(path);
+        } catch (std::runtime_error& ex) {
+            errors++;
+        }
+        FILE* file= fopen(path, "r+b");
+        fseek(file, -(long) sizeof(int), SEEK_END);
+        fputc(9, file);
+        fclose(file);
+        ArrayList<int> unverified= ArrayList<int>::loadMapped(path);
+        try {
+            ArrayList<int>::load(path);
+        } catch (std::runtime_error& ex) {
+            errors++;
+        }
+        try {
+            ArrayList<int>::loadMapped("ArrayListTest.missing");
+        } catch (std::runtime_error& ex) {
+            errors++;
+        }
+        RESULT_HANDLER(errors == 3 && unverified.equals({1, 2, 3, 9}));
+        remove(path);
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        ArrayList<long long> l({0, -7, 42, 1000000007LL, -9223372036854775807LL - 1, 9223372036854775807LL});
+        stringstream output;
+        index++;
+        cout << "Test " << index << ": Write 1= ";
+        l.writeTo(output);
+        RESULT_HANDLER(output.str() == "[0, -7, 42, 1000000007, -9223372036854775808, 9223372036854775807]" && l.toString() == output.str());
+        cout << output.str() << endl;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        ArrayList<int> l;
+        TextFormat format;
+        stringstream both, head, tail, all;
+        index++;
+        cout << "Test " << index << ": Write 2= ";
+        for(int i= 0; i < 100; i++) {
+            l.add(i);
+        }
+        format.open= "<";
+        format.separator= "|";
+        format.close= ">";
+        format.head= 2;
+        format.tail= 3;
+        l.writeTo(both, format);
+        format.tail= -1;
+        l.writeTo(head, format);
+        format.head= -1;
+        format.tail= 1;
+        l.writeTo(tail, format);
+        format.head= 60;
+        format.tail= 60;
+        l.writeTo(all, format);
+        RESULT_HANDLER(both.str() == "<0|1|...|97|98|99>" && head.str() == "<0|1|...>" && tail.str() == "<...|99>" && 
+                all.str().size() == 190 + 99 + 2 && all.str().find("...") == string::npos);
+        cout << both.str() << " " << head.str() << " " << tail.str() << endl;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        ArrayList<double> l;
+        TextFormat format;
+        string text;
+        int chunks= 0;
+        size_t largest= 0;
+        index++;
+        cout << "Test " << index << ": Write 3= ";
+        for(int i= 0; i < 1000; i++) {
+            l.add(i + 0.5);
+        }
+        format.chunkSize= 64;
+        l.writeTo([&text, &chunks, &largest](const char* data, size_t length) -> void {
+            text.append(data, length);
+            chunks++;
+            largest= largest < length ? length : largest;
+        }, format);
+        RESULT_HANDLER(text == l.toString() && largest <= 64 && chunks == (int) ((text.size() + 63) / 64) && 
+                text.substr(0, 16) == "[0.5, 1.5, 2.5, ");
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        ArrayList<int, CountingInstrumentation> l;
+        ArrayList<int> plain;
+        OperationCounters counters, global;
+        index++;
+        cout << "Test " << index << ": Counters 1= ";
+        CountingInstrumentation::resetGlobalCounters();
+        for(int i= 0; i < 100; i++) {
+            l.add(i);
+            plain.add(i);
+        }
+        l.add(0, -1);
+        l.minus(0);
+        l.add(50, -1);
+        counters= l.counters();
+        global= CountingInstrumentation::globalCounters();
+        RESULT_HANDLER(counters.reallocations == 6 && counters.reallocatedElements == 8 + 13 + 21 + 33 + 51 + 78 && 
+                counters.shiftedElements == 100 + 100 + 50 && counters.nodeHops == 0 && counters.comparisons == 0 && 
+                global.reallocations == 6 && global.shiftedElements == 250 && plain.counters().reallocations == 0 && 
+                sizeof(plain) < sizeof(l));
+        cout << counters.reallocations << " " << counters.reallocatedElements << " " << counters.shiftedElements << endl;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        OperationCounters counters;
+        stringstream output;
+        index++;
+        cout << "Test " << index << ": Counters 2= ";
+        CountingInstrumentation::resetGlobalCounters();
+        {
+            ArrayList<string, CountingInstrumentation> first, second;
+
+            for(int i= 0; i < 9; i++) {
+                first.add(0, "a");
+                second.add("b");
+            }
+            counters= first.counters();
+            counters+= second.counters();
+        }
+        CountingInstrumentation::globalCounters().dump(output, "arraylist");
+        RESULT_HANDLER(counters.reallocations == 2 && counters.shiftedElements == 36 && output.str() == 
+                "arraylist.reallocations 2\narraylist.reallocated_elements 16\narraylist.shifted_elements 36\n"
+                "arraylist.node_hops 0\narraylist.comparisons 0\n");
+        cout << output.str() << endl;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        ArrayList<int> l;
+        long sum= 0;
+        index++;
+        cout << "Test " << index << ": Allocations 1= ";
+        AllocationCounter growth;
+        for(int i= 0; i < 100; i++) {
+            l.add(i);
+        }
+        bool grew= growth.count() == 7 && growth.bytes() == (8 + 13 + 21 + 33 + 51 + 78 + 118) * (long) sizeof(int) && growth.frees() == 6;
+        AllocationCounter reads;
+        sum+= l.get(50) + l.at(60);
+        sum+= l.contains(99) + l.contains(-1);
+        l.each([&sum](const int& elem) -> void {
+            sum+= elem;
+        });
+        sum+= l.exists([](const int& elem) -> bool {
+            return elem == 75;
+        });
+        RESULT_HANDLER(grew && reads.count() == 0 && sum == 50 + 60 + 1 + 4950 + 1);
+        cout << growth.count() << " " << reads.count() << endl;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        ArrayList<Integer> l= {1, 2, 3};
+        ArrayList<int> ints= {1, 2, 3, 4};
+        initializer_list<Integer> same= {1, 2, 3};
+        Collection<int>* collection= &ints;
+        index++;
+        cout << "Test " << index << ": Allocations 2= ";
+        AllocationCounter equals;
+        bool equal= l.equals(same);
+        long compared= equals.count();
+        AllocationCounter map;
+        ArrayList<int> mapped= ints.map<int>([](const int& elem) -> int {
+            return elem * 2;
+        });
+        long direct= map.count();
+        AllocationCounter dispatched;
+        Collection<int>* converted= collection->map<int>([](const int& elem) -> int {
+            return elem * 2;
+        });
+        long virtualMap= dispatched.count();
+        RESULT_HANDLER(equal && compared == 0 && direct == 1 && virtualMap == 2 && converted->equals(&mapped));
+        cout << compared << " " << direct << " " << virtualMap << endl;
+        delete converted;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        ArrayList<int> l, empty;
+        ArrayList<int> filled(4, -1);
+        MemoryUsage usage;
+        index++;
+        cout << "Test " << index << ": Memory usage= ";
+        for(int i= 0; i < 100; i++) {
+            l.add(i);
+        }
+        usage= l.memoryUsage();
+        RESULT_HANDLER(usage.payload == 100 * sizeof(int) && usage.slack == (l.capacity() - 100) * sizeof(int) && usage.overhead == 0 && 
+                empty.memoryUsage().total() == 0 && filled.memoryUsage().overhead == sizeof(int));
+        cout << usage.payload << " " << usage.slack << " " << usage.overhead << endl;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        ArrayList<int> l;
+        index++;
+        cout << "Test " << index << ": Copy on write clone= ";
+        for(int i= 0; i < 100; i++) {
+            l.add(i);
+        }
+        l.setCopyOnWrite(true);
+        AllocationCounter share;
+        ArrayList<int>* copy= l.clone();
+        long shared= share.count();
+        AllocationCounter detach;
+        l.set(0, -1);
+        long copied= detach.count();
+        AllocationCounter owned;
+        l.set(1, -2);
+        copy->set(2, -3);
+        RESULT_HANDLER(copy->isCopyOnWrite() && shared == 1 && copied == 2 && owned.count() == 0 && l.get(0) == -1 && l.get(1) == -2 && 
+                l.get(2) == 2 && copy->get(0) == 0 && copy->get(1) == 1 && copy->get(2) == -3);
+        cout << shared << " " << copied << " " << owned.count() << endl;
+        delete copy;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        ArrayList<int> l= {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+        index++;
+        cout << "Test " << index << ": Copy on write views= ";
+        l.setCopyOnWrite(true);
+        AllocationCounter views;
+        ArrayList<int>* reversed= l.reverse();
+        ArrayList<int>* sublist= reversed->subList(2, 5);
+        long created= views.count();
+        stringstream before;
+        before << reversed->toString() << " " << sublist->toString();
+        int sum= reversed->foldLeft<int>(0, [](const int& acc, const int& elem) -> int {
+            return acc * 2 + elem;
+        });
+        sublist->add(-1);
+        reversed->set(0, -9);
+        ArrayList<int>* restored= reversed->reverse();
+        RESULT_HANDLER(created == 2 && before.str() == "[9, 8, 7, 6, 5, 4, 3, 2, 1, 0] [7, 6, 5, 4]" && 
+                sum == 9 * 512 + 8 * 256 + 7 * 128 + 6 * 64 + 5 * 32 + 4 * 16 + 3 * 8 + 2 * 4 + 1 * 2 && 
+                sublist->equals({7, 6, 5, 4, -1}) && reversed->at(0) == -9 && reversed->at(9) == 0 && restored->get(9) == -9 && 
+                l.equals({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+        cout << before.str() << " " << created << endl;
+        delete restored;
+        delete sublist;
+        delete reversed;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        ArrayList<string> l;
+        bool ordered= true;
+        index++;
+        cout << "Test " << index << ": Incremental resize= ";
+        l.setIncrementalResize(true);
+        for(int i= 0; i < 8; i++) {
+            l.add(to_string(i));
+        }
+        l.add("8");
+        bool started= l.isResizing() && l.capacity() == 13 && l.memoryUsage().overhead == 8 * sizeof(string);
+        for(int i= 0; i < 9; i++) {
+            ordered= ordered && l.at(i) == to_string(i);
+        }
+        l.set(7, "seven");
+        bool moving= l.isResizing();
+        l.add(l.at(7));
+        for(int i= 10; i < 100; i++) {
+            l.add(to_string(i));
+            for(int j= 0; j <= i; j++) {
+                ordered= ordered && l.at(j) == (j == 7 ? "seven" : j == 9 ? "seven" : to_string(j));
+            }
+        }
+        RESULT_HANDLER(started && moving && ordered && l.size() == 100);
+        cout << l.capacity() << endl;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        ArrayList<int> l;
+        index++;
+        cout << "Test " << index << ": Reads during an incremental resize= ";
+        l.setIncrementalResize(true);
+        for(int i= 0; i < 9; i++) {
+            l.add(i);
+        }
+        bool resizing= l.isResizing();
+        unique_ptr<ArrayList<int>> copy(l.clone()), sublist(l.subList(2, 8)), reversed(l.reverse());
+        int sum= l.reduce<int>(0, [](const int& acc, const int& elem) -> int {
+            return acc + elem;
+        }, [](const int& left, const int& right) -> int {
+            return left + right;
+        });
+        string text= l.toString();
+        l.minus(0);
+        RESULT_HANDLER(resizing && !l.isResizing() && copy->isIncrementalResize() && !copy->isResizing() && 
+                copy->equals({0, 1, 2, 3, 4, 5, 6, 7, 8}) && sublist->equals({2, 3, 4, 5, 6, 7, 8}) && 
+                reversed->equals({8, 7, 6, 5, 4, 3, 2, 1, 0}) && sum == 36 && text == "[0, 1, 2, 3, 4, 5, 6, 7, 8]" && 
+                l.equals({1, 2, 3, 4, 5, 6, 7, 8}) && l.memoryUsage().overhead == 0);
+        cout << text << endl;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        WorkStealingPool pool(4);
+        ArrayList<int> l;
+        long expected= 0;
+        l.setIncrementalResize(true);
+        while(l.size() < 100000 || !l.isResizing()) {
+            expected+= l.size();
+            l.add(l.size());
+        }
+        index++;
+        cout << "Test " << index << ": Parallel reads during an incremental resize= ";
+        const ArrayList<int>& reader= l;
+        atomic<long> eachSum(0);
+        AllocationCounter allocations;
+        reader.parEach([&eachSum](const int& elem) -> void {
+            eachSum.fetch_add(elem);
+        }, 1000, &pool);
+        long sum= reader.reduce<long>(0, [](const long& acc, const int& elem) -> long {
+            return acc + elem;
+        }, [](const long& left, const long& right) -> long {
+            return left + right;
+        }, 1000, &pool);
+        int tens= reader.parCount([](const int& elem) -> bool { return elem % 10 == 0; }, 1000, &pool);
+        bool last= reader.parExists([&l](const int& elem) -> bool { return elem == l.size() - 1; }, 1000, &pool);
+        long bytes= allocations.bytes();
+        ArrayList<int> doubled= reader.parMap<int>([](const int& elem) -> int { return elem * 2; }, 1000, &pool);
+        RESULT_HANDLER(l.isResizing() && eachSum.load() == expected && sum == expected && tens == (l.size() + 9) / 10 && last &&
+                bytes < l.size() * (long) sizeof(int) / 4 && doubled.size() == l.size() && doubled.at(l.size() - 1) == 2 * (l.size() - 1));
+        cout << bytes << endl;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        MemoryRegistry registry;
+        ArrayList<int> first= {1, 2, 3, 4}, second= {5, 6};
+        map<string, MemoryUsage> tracked, untracked;
+        stringstream output;
+        index++;
+        cout << "Test " << index << ": Memory registry= ";
+        {
+            MemoryRegistry::Registration firstEntry= registry.track(first, "int_list");
+            MemoryRegistry::Registration secondEntry= registry.track(second, "int_list");
 
+            tracked= registry.usageByType();
+            registry.dump(output);
+        }
+        untracked= registry.usageByType();
+        RESULT_HANDLER(tracked.size() == 1 && tracked["int_list"].total() == first.memoryUsage().total() + second.memoryUsage().total() && 
+                untracked.empty() && output.str().find("memory.int_list.payload 24\n") == 0);
+        cout << output.str() << endl;
+    });
     for(UnitTest& test: unitTests) {
         test();
     }
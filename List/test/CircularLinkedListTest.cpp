@@ -10,10 +10,15 @@
 #include "Collection.h"
 #include "List.h"
 #include "List/CircularLinkedList.h"
+#include "test/AllocationCounter.h"
 
 using etsai::collections::Collection;
+using etsai::collections::CountingInstrumentation;
 using etsai::collections::List;
+using etsai::collections::MemoryUsage;
+using etsai::collections::OperationCounters;
 using etsai::collections::list::CircularLinkedList;
+using etsai::collections::test::AllocationCounter;
 using std::cout;
 using std::endl;
 using std::function;
@@ -62,6 +67,50 @@ ostream& operator <<(ostream& os, const Integer& r) {
     return os;
 }
 
+/**
+ * Counts how many times values are copied, to check that moves are used where possible
+ */
+class Tracked {
+public:
+    static int copies;
+
+    Tracked() : value(0) {
+    }
+    Tracked(int value) : value(value) {
+    }
+    Tracked(int left, int right) : value(left * right) {
+    }
+    Tracked(const Tracked& r) : value(r.value) {
+        copies++;
+    }
+    Tracked(Tracked&& r) : value(r.value) {
+        r.value= -1;
+    }
+    Tracked& operator =(const Tracked& r) {
+        value= r.value;
+        copies++;
+        return *this;
+    }
+    Tracked& operator =(Tracked&& r) {
+        value= r.value;
+        r.value= -1;
+        return *this;
+    }
+
+    int value;
+};
+
+int Tracked::copies= 0;
+
+bool operator ==(const Tracked& l, const Tracked& r) {
+    return l.value == r.value;
+}
+
+ostream& operator <<(ostream& os, const Tracked& r) {
+    os << r.value;
+    return os;
+}
+
 typedef function<void (void)> UnitTest;
 
 #define RESULT_HANDLER(result)\
@@ -467,7 +516,150 @@ int main(int argc, char **argv) {
         cout << l->toString() << endl;
         delete m;
     });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        CircularLinkedList<Integer> l({0, 1, 2, 3, 4});
+        index++;
+        cout << "Test " << index << ": Map 2= ";
+        CircularLinkedList<int> m= l.map<int>([](const Integer& elem) -> int {
+            return elem.get() * 2;
+        });
+        RESULT_HANDLER(m.equals({0, 2, 4, 6, 8}) && m.size() == 5);
+        cout << m.toString() << endl;
+    });
 
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        CircularLinkedList<Integer> l({0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+        index++;
+        cout << "Test " << index << ": View 1= ";
+        CircularLinkedList<int> m= l.view().filter([](const Integer& elem) -> bool {
+            return elem.get() % 3 == 0;
+        }).map([](const Integer& elem) -> int {
+            return elem.get() + 1;
+        }).toCircularLinkedList();
+        RESULT_HANDLER(m.equals({1, 4, 7, 10}) && m.size() == 4);
+        cout << m.toString() << endl;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        CircularLinkedList<int> l;
+        CircularLinkedList<int, CountingInstrumentation> right;
+        index++;
+        cout << "Test " << index << ": View 2= ";
+        for(int i= 0; i < 1000; i++) {
+            l.add(i);
+            right.add(2 * i);
+        }
+        right.add(-1);
+        bool paired= l.view().zip(right).forAll([](const std::pair<int, int>& elem) -> bool {
+            return elem.second == 2 * elem.first;
+        });
+        AllocationCounter zipping;
+        int taken= l.view().take(5).zip(right).count();
+        bool lazy= zipping.bytes() < 1000;
+        RESULT_HANDLER(paired && lazy && taken == 5 && l.view().zip(right).count() == 1000 && 
+                right.view().zip(l).take(5).count() == 5 && right.counters().nodeHops == 0);
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        shared_ptr<List<string>> l(new CircularLinkedList<string>({"a", "b", "c", "d"}));
+        shared_ptr<List<string>> empty(new CircularLinkedList<string>());
+        index++;
+        cout << "Test " << index << ": Fold right 2= ";
+        function<string (const string&, const string&)> concat= [](const string& l, const string& r) -> string {
+            return l + r;
+        };
+        string right= l->foldRight<string>("|", concat);
+        string left= l->foldLeft<string>("|", concat);
+        RESULT_HANDLER(right == "abcd|" && left == "|abcd" && empty->foldRight<string>("|", concat) == "|" && 
+                l->reduce<string>("", concat, concat) == "abcd");
+        cout << right << endl;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        CircularLinkedList<Tracked> l;
+        index++;
+        cout << "Test " << index << ": Move 1= ";
+        Tracked::copies= 0;
+        l.add(Tracked(1));
+        l.emplace(2, 3);
+        l.emplaceAt(0, 4);
+        l.add(1, Tracked(5));
+        l.set(2, Tracked(7));
+        Tracked removed= l.minus(0);
+        RESULT_HANDLER(Tracked::copies == 0 && removed.value == 4 && l.size() == 3 && l.at(0).value == 5 && 
+                l.at(1).value == 7 && l.at(2).value == 6 && &l.at(2) == &l.at(2));
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        CircularLinkedList<string> l({"alpha", "beta"});
+        string gamma("gamma");
+        index++;
+        cout << "Test " << index << ": Move 2= ";
+        l.add(std::move(gamma));
+        l.add(l.at(0));
+        l.add(0, l.at(3));
+        RESULT_HANDLER(gamma.empty() && l.equals({"alpha", "alpha", "beta", "gamma", "alpha"}) && l.minus(3) == "gamma" && 
+                l.equals({"alpha", "alpha", "beta", "alpha"}));
+        cout << l.toString() << endl;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        CircularLinkedList<int> l({42});
+        index++;
+        cout << "Test " << index << ": Remove single= ";
+        bool removed= l.remove(42);
+        RESULT_HANDLER(removed && l.isEmpty() && !l.contains(42) && l.add(7) && l.equals({7}));
+        cout << l.toString() << endl;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        CircularLinkedList<int, CountingInstrumentation> l;
+        OperationCounters counters;
+        stringstream output;
+        index++;
+        cout << "Test " << index << ": Counters= ";
+        for(int i= 0; i < 10; i++) {
+            l.add(i);
+        }
+        l.get(7);
+        l.set(3, 30);
+        l.add(5, 50);
+        l.minus(9);
+        delete l.subList(2, 4);
+        counters= l.counters();
+        counters.dump(output, "cll");
+        RESULT_HANDLER(counters.nodeHops == 7 + 3 + 5 + 9 + 2 && counters.reallocations == 0 && counters.shiftedElements == 0 && 
+                output.str().find("cll.node_hops 26\n") != string::npos && CircularLinkedList<int>().counters().nodeHops == 0);
+        cout << counters.nodeHops << endl;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        CircularLinkedList<int> l;
+        long sum= 0;
+        index++;
+        cout << "Test " << index << ": Allocations= ";
+        AllocationCounter adds;
+        for(int i= 0; i < 10; i++) {
+            l.add(i);
+        }
+        l.add(5, 50);
+        long added= adds.count();
+        AllocationCounter reads;
+        sum+= l.get(5) + l.at(6);
+        sum+= l.contains(9);
+        l.each([&sum](const int& elem) -> void {
+            sum+= elem;
+        });
+        l.reverse(true);
+        RESULT_HANDLER(added == 11 && reads.count() == 0 && sum == 50 + 5 + 1 + 95 && l.equals({9, 8, 7, 6, 5, 50, 4, 3, 2, 1, 0}));
+        cout << added << " " << reads.count() << " " << l.toString() << endl;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        CircularLinkedList<int> l;
+        MemoryUsage usage;
+        index++;
+        cout << "Test " << index << ": Memory usage= ";
+        AllocationCounter adds;
+        for(int i= 0; i < 10; i++) {
+            l.add(i);
+        }
+        usage= l.memoryUsage();
+        RESULT_HANDLER(usage.payload == 10 * sizeof(int) && usage.slack == 0 && (long) usage.total() == adds.bytes());
+        cout << usage.payload << " " << usage.overhead << " " << adds.bytes() << endl;
+    });
     for(UnitTest& test: unitTests) {
         test();
     }
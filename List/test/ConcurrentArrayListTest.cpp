@@ -0,0 +1,194 @@
+#include "List.h"
+#include "List/ConcurrentArrayList.h"
+#include "test/ListChecks.h"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace etsai::collections;
+using namespace etsai::collections::list;
+using etsai::collections::test::readsSample;
+using namespace std;
+
+typedef function<void (void)> UnitTest;
+
+#define RESULT_HANDLER(result)\
+    if (result) {\
+        pass++; \
+        cout << "Pass" << endl;\
+    } else {\
+        fail++;\
+        cout << "Failed" << endl;\
+    }
+
+struct Fragile {
+    Fragile(int value) : value(value) {
+        if (value < 0) {
+            throw invalid_argument("negative");
+        }
+    }
+
+    int value;
+};
+
+bool operator ==(const Fragile& left, const Fragile& right) {
+    return left.value == right.value;
+}
+
+ostream& operator <<(ostream& os, const Fragile& elem) {
+    return os << elem.value;
+}
+
+int main(int argc, char **argv) {
+    int pass= 0, fail= 0, index= -1;
+    vector<UnitTest> unitTests;
+
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        shared_ptr<List<int>> l(new ConcurrentArrayList<int>({5, 3, 7, 0, 1, 9}));
+        index++;
+        cout << "Test " << index << ": Read APIs= ";
+        RESULT_HANDLER(readsSample(*l));
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        ConcurrentArrayList<string> l;
+        index++;
+        cout << "Test " << index << ": Add and grow= ";
+        l.add("first");
+        const string* first= &l.at(0);
+        for(int i= 1; i < 1000; i++) {
+            l.emplace(3, 'a' + i % 26);
+        }
+        RESULT_HANDLER(l.size() == 1000 && &l.at(0) == first && *first == "first" && l.get(999) == "lll" &&
+                l.capacity() >= 1000 && l.memoryUsage().payload == 1000 * sizeof(string));
+        cout << l.capacity() << endl;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        ConcurrentArrayList<int> l= {0, 1, 2, 3, 4};
+        index++;
+        cout << "Test " << index << ": Copies= ";
+        unique_ptr<ConcurrentArrayList<int>> reversed(l.reverse()), sub(l.subList(1, 3));
+        ConcurrentArrayList<double> halves= l.map<double>([](const int& elem) -> double {
+            return elem / 2.0;
+        });
+        RESULT_HANDLER(reversed->equals({4, 3, 2, 1, 0}) && sub->equals({1, 2, 3}) && halves.equals({0, 0.5, 1, 1.5, 2}));
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        ConcurrentArrayList<int> l= {0, 1, 2};
+        int unsupported= 0;
+        bool removed= false;
+        index++;
+        cout << "Test " << index << ": Unsupported mutations= ";
+        try {
+            l.add(0, 5);
+        } catch (logic_error& ex) {
+            unsupported++;
+        }
+        try {
+            l.remove(1);
+        } catch (logic_error& ex) {
+            unsupported++;
+        }
+        try {
+            l.clear();
+        } catch (logic_error& ex) {
+            unsupported++;
+        }
+        try {
+            l.resize(1);
+        } catch (logic_error& ex) {
+            unsupported++;
+        }
+        try {
+            l.reverse(true);
+        } catch (logic_error& ex) {
+            unsupported++;
+        }
+        try {
+            l.minus(0);
+            removed= true;
+        } catch (logic_error& ex) {
+            unsupported++;
+        }
+        l.set(1, 10);
+        RESULT_HANDLER(unsupported == 6 && !removed && l.equals({0, 10, 2}));
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        ConcurrentArrayList<Fragile> l;
+        bool thrown= false, hole= false;
+        int visited= 0;
+        index++;
+        cout << "Test " << index << ": Failed construction= ";
+        l.emplace(1);
+        try {
+            l.emplace(-1);
+        } catch (invalid_argument& ex) {
+            thrown= true;
+        }
+        l.emplace(3);
+        try {
+            l.at(1);
+        } catch (out_of_range& ex) {
+            hole= true;
+        }
+        l.each([&visited](const Fragile& elem) -> void {
+            visited+= elem.value;
+        });
+        RESULT_HANDLER(thrown && hole && l.size() == 3 && visited == 4 && l.at(2).value == 3);
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        const int THREADS= 4, PER_THREAD= 50000;
+        ConcurrentArrayList<int> l;
+        vector<thread> producers;
+        atomic<bool> done(false);
+        atomic<long> readErrors(0);
+        index++;
+        cout << "Test " << index << ": Concurrent appends= ";
+        thread reader([&l, &done, &readErrors]() -> void {
+            while(!done) {
+                int size= l.size();
+
+                for(int i= size > 100 ? size - 100 : 0; i < size; i++) {
+                    if (l.at(i) < 0) {
+                        readErrors++;
+                    }
+                }
+            }
+        });
+        for(int t= 0; t < THREADS; t++) {
+            producers.push_back(thread([&l, t]() -> void {
+                for(int i= 0; i < PER_THREAD; i++) {
+                    l.add(t * PER_THREAD + i);
+                }
+            }));
+        }
+        for(thread& producer: producers) {
+            producer.join();
+        }
+        done= true;
+        reader.join();
+
+        vector<int> values;
+        l.each([&values](const int& elem) -> void {
+            values.push_back(elem);
+        });
+        sort(values.begin(), values.end());
+        bool complete= (int) values.size() == THREADS * PER_THREAD;
+        for(int i= 0; complete && i < (int) values.size(); i++) {
+            complete= values[i] == i;
+        }
+        RESULT_HANDLER(complete && readErrors == 0 && l.size() == THREADS * PER_THREAD);
+    });
+
+    for(UnitTest& test: unitTests) {
+        test();
+    }
+    cout << "Final result: Pass= " << pass << "\tFail=" << fail << endl;
+    return 0;
+}
@@ -0,0 +1,176 @@
+#include "List.h"
+#include "List/GapBufferList.h"
+#include "test/AllocationCounter.h"
+#include "test/ListChecks.h"
+
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace etsai::collections;
+using namespace etsai::collections::list;
+using etsai::collections::test::AllocationCounter;
+using etsai::collections::test::holdsRange;
+using etsai::collections::test::readsSample;
+using namespace std;
+
+typedef function<void (void)> UnitTest;
+
+#define RESULT_HANDLER(result)\
+    if (result) {\
+        pass++; \
+        cout << "Pass" << endl;\
+    } else {\
+        fail++;\
+        cout << "Failed" << endl;\
+    }
+
+int main(int argc, char **argv) {
+    int pass= 0, fail= 0, index= -1;
+    vector<UnitTest> unitTests;
+
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        shared_ptr<List<int>> l(new GapBufferList<int>({5, 3, 7, 0, 1, 9}));
+        index++;
+        cout << "Test " << index << ": Read APIs= ";
+        RESULT_HANDLER(readsSample(*l));
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        GapBufferList<int> l;
+        index++;
+        cout << "Test " << index << ": Growth= ";
+        for(int i= 0; i < 100; i++) {
+            l.add(i);
+        }
+        RESULT_HANDLER(holdsRange(l, 100) && l.capacity() == 118 && l.gapIndex() == 100);
+        cout << l.capacity() << endl;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        GapBufferList<string> l;
+        string text= "the quick fox";
+        index++;
+        cout << "Test " << index << ": Clustered edits= ";
+        for(int i= 0; i < 1000; i++) {
+            l.add("x");
+        }
+        for(char c: text) {
+            l.add(500 + l.size() - 1000, string(1, c));
+        }
+        l.minus(499 + text.size());
+        l.minus(499 + text.size() - 1);
+        l.minus(499 + text.size() - 2);
+        l.add(500 + 10, "d");
+        l.add(500 + 11, "o");
+        l.add(500 + 12, "g");
+        int gap= l.gapIndex();
+        string typed;
+        for(int i= 500; i < 500 + (int) text.size(); i++) {
+            typed+= l.at(i);
+        }
+        RESULT_HANDLER(typed == "the quick dog" && l.size() == 1000 + (int) text.size() && gap == 513 && l.at(499) == "x" &&
+                l.at(513) == "x");
+        cout << typed << endl;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        GapBufferList<int> l;
+        for(int i= 0; i < 1000; i++) {
+            l.add(i);
+        }
+        l.add(500, -1);
+        l.minus(500);
+        index++;
+        cout << "Test " << index << ": Moves only between edits= ";
+        AllocationCounter allocations;
+        for(int i= 0; i < 10; i++) {
+            l.add(500 + i, -1);
+        }
+        for(int i= 0; i < 10; i++) {
+            l.minus(500);
+        }
+        RESULT_HANDLER(holdsRange(l, 1000) && allocations.count() == 0 && l.gapIndex() == 500);
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        GapBufferList<int> l= {1, 2};
+        index++;
+        cout << "Test " << index << ": Add past the end= ";
+        l.add(0, 0);
+        l.add(5, 6);
+        RESULT_HANDLER(l.equals({0, 1, 2, 0, 0, 6}));
+        cout << l.toString() << endl;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        GapBufferList<int> l;
+        for(int i= 0; i < 50; i++) {
+            l.add(i);
+        }
+        l.add(25, -1);
+        index++;
+        cout << "Test " << index << ": Copies= ";
+        unique_ptr<GapBufferList<int>> reversed(l.reverse()), sublist(l.subList(20, 30)), copy(l.clone());
+        GapBufferList<int> mapped= l.map<int>([](const int& elem) -> int {
+            return elem * 2;
+        });
+        copy->reverse(true);
+        l.minus(25);
+        GapBufferList<int> moved(std::move(mapped));
+        bool backwards= reversed->at(0) == 49 && reversed->at(24) == 25 && reversed->at(25) == -1 && reversed->at(26) == 24 &&
+                reversed->at(50) == 0;
+        RESULT_HANDLER(holdsRange(l, 50) && backwards && reversed->equals(copy.get()) && sublist->size() == 11 && sublist->at(5) == -1 &&
+                sublist->at(0) == 20 && moved.at(25) == -2 && moved.at(50) == 98 && mapped.isEmpty() && mapped.capacity() == 0);
+        cout << sublist->toString() << endl;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        GapBufferList<int> l;
+        MemoryUsage usage;
+        index++;
+        cout << "Test " << index << ": Resize and memory usage= ";
+        for(int i= 0; i < 100; i++) {
+            l.add(i);
+        }
+        l.add(10, -1);
+        l.resize(50);
+        usage= l.memoryUsage();
+        bool truncated= l.size() == 50 && l.at(10) == -1 && l.at(49) == 48;
+        l.minus(10);
+        l.resize(200);
+        RESULT_HANDLER(truncated && usage.payload == 50 * sizeof(int) && usage.slack == 0 && holdsRange(l, 49) && l.capacity() == 200 &&
+                l.memoryUsage().slack == 151 * sizeof(int));
+        cout << usage.payload << " " << usage.slack << endl;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        GapBufferList<int> l= {1, 2, 3};
+        int thrown= 0;
+        index++;
+        cout << "Test " << index << ": Out of range= ";
+        try {
+            l.at(3);
+        } catch (out_of_range& ex) {
+            thrown++;
+        }
+        try {
+            l.add(-1, 0);
+        } catch (out_of_range& ex) {
+            thrown++;
+        }
+        try {
+            l.minus(-1);
+        } catch (out_of_range& ex) {
+            thrown++;
+        }
+        try {
+            l.subList(2, 1);
+        } catch (invalid_argument& ex) {
+            thrown++;
+        }
+        RESULT_HANDLER(thrown == 4 && l.equals({1, 2, 3}));
+    });
+
+    for(UnitTest& test: unitTests) {
+        test();
+    }
+    cout << "Final result: Pass= " << pass << "\tFail=" << fail << endl;
+    return 0;
+}
@@ -0,0 +1,177 @@
+#include "List.h"
+#include "List/PersistentList.h"
+#include "test/AllocationCounter.h"
+#include "test/ListChecks.h"
+
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace etsai::collections;
+using namespace etsai::collections::list;
+using etsai::collections::test::AllocationCounter;
+using etsai::collections::test::holdsRange;
+using etsai::collections::test::readsSample;
+using namespace std;
+
+typedef function<void (void)> UnitTest;
+
+#define RESULT_HANDLER(result)\
+    if (result) {\
+        pass++; \
+        cout << "Pass" << endl;\
+    } else {\
+        fail++;\
+        cout << "Failed" << endl;\
+    }
+
+int main(int argc, char **argv) {
+    int pass= 0, fail= 0, index= -1;
+    vector<UnitTest> unitTests;
+
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        shared_ptr<List<int>> l(new PersistentList<int>({5, 3, 7, 0, 1, 9}));
+        index++;
+        cout << "Test " << index << ": Read APIs= ";
+        RESULT_HANDLER(readsSample(*l));
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        const int SIZE= 40000;
+        PersistentList<int>::Transient builder;
+        index++;
+        cout << "Test " << index << ": Transient build= ";
+        for(int i= 0; i < SIZE; i++) {
+            builder.add(i);
+        }
+        PersistentList<int> l= builder.persistent();
+        PersistentList<int> appended;
+        for(int i= 0; i < 1100; i++) {
+            appended.add(i);
+        }
+        RESULT_HANDLER(holdsRange(l, SIZE) && holdsRange(appended, 1100) && l.capacity() == SIZE && appended.capacity() == 1120);
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        PersistentList<string> l;
+        for(int i= 0; i < 5000; i++) {
+            l.add(to_string(i));
+        }
+        index++;
+        cout << "Test " << index << ": Constant time clone= ";
+        AllocationCounter counter;
+        unique_ptr<PersistentList<string>> snapshot(l.clone());
+        long allocations= counter.count();
+        l.set(10, "ten");
+        l.set(4999, "last");
+        l.add("more");
+        l.minus(0);
+        RESULT_HANDLER(allocations == 1 && snapshot->size() == 5000 && snapshot->at(10) == "10" && snapshot->at(4999) == "4999" &&
+                snapshot->at(0) == "0" && l.size() == 5000 && l.at(9) == "ten" && l.at(4998) == "last" && l.at(4999) == "more");
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        PersistentList<int> base= {0, 1, 2};
+        index++;
+        cout << "Test " << index << ": New versions= ";
+        PersistentList<int> longer= base.appended(3);
+        PersistentList<int> changed= longer.updated(1, 10);
+        bool thrown= false;
+        try {
+            base.updated(3, 0);
+        } catch (out_of_range& ex) {
+            thrown= true;
+        }
+        RESULT_HANDLER(base.equals({0, 1, 2}) && longer.equals({0, 1, 2, 3}) && changed.equals({0, 10, 2, 3}) && thrown);
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        const int SIZE= 1100;
+        PersistentList<int> l= PersistentList<int>().transient().add(0).persistent();
+        for(int i= 1; i < SIZE; i++) {
+            l.add(i);
+        }
+        PersistentList<int> full(l);
+        bool ordered= true;
+        index++;
+        cout << "Test " << index << ": Remove from the end= ";
+        for(int i= SIZE - 1; i >= 0; i--) {
+            ordered= ordered && l.minus(i) == i && holdsRange(l, i);
+        }
+        RESULT_HANDLER(ordered && l.isEmpty() && holdsRange(full, SIZE));
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        PersistentList<int> l= {0, 1, 2, 3, 4};
+        index++;
+        cout << "Test " << index << ": Edits= ";
+        l.add(2, 20);
+        bool inserted= l.equals({0, 1, 20, 2, 3, 4});
+        l.remove(20);
+        l.add(7, 7);
+        bool padded= l.equals({0, 1, 2, 3, 4, 0, 0, 7});
+        l.minus(1);
+        l.resize(4);
+        unique_ptr<PersistentList<int>> sub(l.subList(1, 2)), head(l.subList(0, 2)), reversed(l.reverse());
+        bool mutated= l.reverse(true) == NULL;
+        RESULT_HANDLER(inserted && padded && sub->equals({2, 3}) && head->equals({0, 2, 3}) && reversed->equals({4, 3, 2, 0}) &&
+                mutated && l.equals({4, 3, 2, 0}));
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        PersistentList<int> l= {0, 1, 2};
+        index++;
+        cout << "Test " << index << ": Transient after persistent= ";
+        PersistentList<int>::Transient builder= l.transient();
+        builder.set(0, 10).add(3);
+        PersistentList<int> first= builder.persistent();
+        builder.set(1, 11).pop();
+        PersistentList<int> second= builder.persistent();
+        RESULT_HANDLER(l.equals({0, 1, 2}) && first.equals({10, 1, 2, 3}) && second.equals({10, 11, 2}));
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        PersistentList<int>::Transient a;
+        index++;
+        cout << "Test " << index << ": Copied transients= ";
+        a.add(1).add(2);
+        PersistentList<int>::Transient b= a;
+        b.set(0, 99);
+        bool separate= a.at(0) == 1 && b.at(0) == 99;
+        PersistentList<int> p= b.persistent();
+        PersistentList<int>::Transient c= b;
+        c.set(1, 77);
+        b.set(1, 55);
+        a= c;
+        a.set(0, 11);
+        PersistentList<int>::Transient moved(std::move(c));
+        moved.add(3);
+        RESULT_HANDLER(separate && p.equals({99, 2}) && b.persistent().equals({99, 55}) && a.persistent().equals({11, 77}) && 
+                moved.persistent().equals({99, 77, 3}) && c.size() == 0);
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        PersistentList<int> l= {1, 2, 3};
+        PersistentList<int> snapshot(l);
+        index++;
+        cout << "Test " << index << ": Mutable each and map= ";
+        l.each([](int& elem) -> void {
+            elem*= 2;
+        });
+        PersistentList<double> halves= snapshot.map<double>([](const int& elem) -> double {
+            return elem / 2.0;
+        });
+        RESULT_HANDLER(l.equals({2, 4, 6}) && snapshot.equals({1, 2, 3}) && halves.equals({0.5, 1, 1.5}));
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        PersistentList<int> l;
+        for(int i= 0; i < 40; i++) {
+            l.add(i);
+        }
+        index++;
+        cout << "Test " << index << ": Memory usage= ";
+        MemoryUsage usage= l.memoryUsage();
+        RESULT_HANDLER(usage.payload == 40 * sizeof(int) && usage.slack == 24 * sizeof(int) && usage.overhead > 0);
+    });
+
+    for(UnitTest& test: unitTests) {
+        test();
+    }
+    cout << "Final result: Pass= " << pass << "\tFail=" << fail << endl;
+    return 0;
+}
@@ -0,0 +1,152 @@
+#include "List.h"
+#include "List/SegmentedArrayList.h"
+#include "test/AllocationCounter.h"
+#include "test/ListChecks.h"
+
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace etsai::collections;
+using namespace etsai::collections::list;
+using etsai::collections::test::AllocationCounter;
+using etsai::collections::test::holdsRange;
+using etsai::collections::test::readsSample;
+using namespace std;
+
+typedef function<void (void)> UnitTest;
+
+#define RESULT_HANDLER(result)\
+    if (result) {\
+        pass++; \
+        cout << "Pass" << endl;\
+    } else {\
+        fail++;\
+        cout << "Failed" << endl;\
+    }
+
+int main(int argc, char **argv) {
+    int pass= 0, fail= 0, index= -1;
+    vector<UnitTest> unitTests;
+
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        shared_ptr<List<int>> l(new SegmentedArrayList<int>({5, 3, 7, 0, 1, 9}));
+        index++;
+        cout << "Test " << index << ": Read APIs= ";
+        RESULT_HANDLER(readsSample(*l));
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        SegmentedArrayList<int> l;
+        index++;
+        cout << "Test " << index << ": Growth without copying= ";
+        l.add(0);
+        const int* first= &l.at(0);
+        AllocationCounter growth;
+        for(int i= 1; i < 1000; i++) {
+            l.add(i);
+        }
+        RESULT_HANDLER(holdsRange(l, 1000) && &l.at(0) == first && growth.count() == 6 && growth.frees() == 0 &&
+                growth.bytes() == (16 + 32 + 64 + 128 + 256 + 512) * (long) sizeof(int) && l.capacity() == 1016);
+        cout << growth.count() << " " << l.capacity() << endl;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        SegmentedArrayList<string> l;
+        index++;
+        cout << "Test " << index << ": Insert and remove across arrays= ";
+        for(int i= 0; i < 30; i++) {
+            l.add(to_string(i));
+        }
+        l.add(0, "first");
+        l.add(20, "middle");
+        string removed= l.minus(8);
+        bool found= l.remove("middle");
+        RESULT_HANDLER(l.size() == 30 && l.at(0) == "first" && removed == "7" && found && !l.remove("middle") && l.at(7) == "6" &&
+                l.at(8) == "8" && l.at(29) == "29");
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        SegmentedArrayList<int> l= {1, 2};
+        index++;
+        cout << "Test " << index << ": Add past the end= ";
+        l.add(5, 6);
+        RESULT_HANDLER(l.equals({1, 2, 0, 0, 0, 6}));
+        cout << l.toString() << endl;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        SegmentedArrayList<int> l;
+        index++;
+        cout << "Test " << index << ": Resize= ";
+        l.resize(100);
+        int grown= l.capacity();
+        for(int i= 0; i < 100; i++) {
+            l.add(i);
+        }
+        bool kept= l.capacity() == grown;
+        l.resize(20);
+        int shrunk= l.capacity();
+        l.clear();
+        RESULT_HANDLER(grown == 120 && kept && shrunk == 24 && l.isEmpty() && l.capacity() == 24);
+        cout << grown << " " << shrunk << endl;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        SegmentedArrayList<int> l;
+        for(int i= 0; i < 50; i++) {
+            l.add(i);
+        }
+        index++;
+        cout << "Test " << index << ": Copies= ";
+        unique_ptr<SegmentedArrayList<int>> reversed(l.reverse()), sublist(l.subList(10, 39)), copy(l.clone());
+        SegmentedArrayList<int> mapped= l.map<int>([](const int& elem) -> int {
+            return elem * 2;
+        });
+        copy->reverse(true);
+        copy->set(0, -1);
+        SegmentedArrayList<int> moved(std::move(mapped));
+        RESULT_HANDLER(holdsRange(l, 50) && reversed->at(0) == 49 && reversed->at(49) == 0 && sublist->size() == 30 &&
+                sublist->at(0) == 10 && sublist->at(29) == 39 && copy->at(0) == -1 && copy->at(1) == 48 && moved.at(49) == 98 &&
+                mapped.isEmpty() && mapped.capacity() == 0 && reversed->equals(copy.get()) == false);
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        SegmentedArrayList<int> l, empty;
+        MemoryUsage usage;
+        index++;
+        cout << "Test " << index << ": Memory usage= ";
+        for(int i= 0; i < 100; i++) {
+            l.add(i);
+        }
+        usage= l.memoryUsage();
+        RESULT_HANDLER(usage.payload == 100 * sizeof(int) && usage.slack == 20 * sizeof(int) && usage.overhead == 4 * sizeof(int*) &&
+                empty.memoryUsage().total() == 0);
+        cout << usage.payload << " " << usage.slack << " " << usage.overhead << endl;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        SegmentedArrayList<int> l= {1, 2, 3};
+        int thrown= 0;
+        index++;
+        cout << "Test " << index << ": Out of range= ";
+        try {
+            l.at(3);
+        } catch (out_of_range& ex) {
+            thrown++;
+        }
+        try {
+            l.add(-1, 0);
+        } catch (out_of_range& ex) {
+            thrown++;
+        }
+        try {
+            l.subList(2, 1);
+        } catch (invalid_argument& ex) {
+            thrown++;
+        }
+        RESULT_HANDLER(thrown == 3 && l.equals({1, 2, 3}));
+    });
+
+    for(UnitTest& test: unitTests) {
+        test();
+    }
+    cout << "Final result: Pass= " << pass << "\tFail=" << fail << endl;
+    return 0;
+}
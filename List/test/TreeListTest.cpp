@@ -0,0 +1,174 @@
+#include "List.h"
+#include "List/TreeList.h"
+#include "test/AllocationCounter.h"
+#include "test/ListChecks.h"
+
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace etsai::collections;
+using namespace etsai::collections::list;
+using etsai::collections::test::AllocationCounter;
+using etsai::collections::test::holdsRange;
+using etsai::collections::test::readsSample;
+using namespace std;
+
+typedef function<void (void)> UnitTest;
+
+#define RESULT_HANDLER(result)\
+    if (result) {\
+        pass++; \
+        cout << "Pass" << endl;\
+    } else {\
+        fail++;\
+        cout << "Failed" << endl;\
+    }
+
+int main(int argc, char **argv) {
+    int pass= 0, fail= 0, index= -1;
+    vector<UnitTest> unitTests;
+
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        shared_ptr<List<int>> l(new TreeList<int>({5, 3, 7, 0, 1, 9}));
+        index++;
+        cout << "Test " << index << ": Read APIs= ";
+        RESULT_HANDLER(readsSample(*l));
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        TreeList<int> l;
+        vector<int> expected;
+        index++;
+        cout << "Test " << index << ": Insert and remove anywhere= ";
+        for(int i= 0; i < 2000; i++) {
+            int position= (i * 7919) % (expected.size() + 1);
+            l.add(position, i);
+            expected.insert(expected.begin() + position, i);
+        }
+        for(int i= 0; i < 1000; i++) {
+            int position= (i * 104729) % expected.size();
+            if (l.minus(position) != expected[position]) {
+                expected.clear();
+            }
+            expected.erase(expected.begin() + position);
+        }
+        l.set(10, -1);
+        expected[10]= -1;
+        bool matches= l.size() == (int) expected.size() && expected.size() == 1000;
+        for(int i= 0; matches && i < (int) expected.size(); i++) {
+            matches= l.at(i) == expected[i];
+        }
+        RESULT_HANDLER(matches && l.remove(-1) && !l.contains(-1) && l.size() == 999);
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        TreeList<int> l;
+        for(int i= 0; i < 100; i++) {
+            l.add(i);
+        }
+        index++;
+        cout << "Test " << index << ": Split and concat= ";
+        AllocationCounter allocations;
+        TreeList<int> rest= l.split(60);
+        TreeList<int> middle= l.split(30);
+        bool parts= l.size() == 30 && middle.size() == 30 && rest.size() == 40 && middle.at(0) == 30 && rest.at(39) == 99;
+        l.concat(middle);
+        l.concat(rest);
+        RESULT_HANDLER(parts && holdsRange(l, 100) && middle.isEmpty() && rest.isEmpty() && allocations.count() == 0 &&
+                l.split(100).isEmpty());
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        TreeList<int> l= {1, 2};
+        index++;
+        cout << "Test " << index << ": Add past the end= ";
+        l.add(0, 0);
+        l.add(5, 6);
+        RESULT_HANDLER(l.equals({0, 1, 2, 0, 0, 6}));
+        cout << l.toString() << endl;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        TreeList<int> l;
+        for(int i= 0; i < 50; i++) {
+            l.add(i);
+        }
+        index++;
+        cout << "Test " << index << ": Copies= ";
+        unique_ptr<TreeList<int>> reversed(l.reverse()), sublist(l.subList(10, 39)), copy(l.clone());
+        TreeList<int> mapped= l.map<int>([](const int& elem) -> int {
+            return elem * 2;
+        });
+        copy->reverse(true);
+        copy->set(0, -1);
+        TreeList<int> moved(std::move(mapped));
+        RESULT_HANDLER(holdsRange(l, 50) && reversed->at(0) == 49 && reversed->at(49) == 0 && sublist->size() == 30 &&
+                sublist->at(0) == 10 && sublist->at(29) == 39 && copy->at(0) == -1 && copy->at(1) == 48 && copy->at(49) == 0 &&
+                moved.at(49) == 98 && mapped.isEmpty() && !reversed->equals(copy.get()));
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        TreeList<string> l= {"a", "bb", "ccc"};
+        const Collection<string>& collection= l;
+        index++;
+        cout << "Test " << index << ": Map through the dispatcher= ";
+        unique_ptr<Collection<int>> mapped(collection.map<int>([](const string& elem) -> int {
+            return elem.size();
+        }));
+        TreeList<int>* lengths= dynamic_cast<TreeList<int>*>(mapped.get());
+        RESULT_HANDLER(lengths != NULL && lengths->equals({1, 2, 3}));
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        TreeList<int> l, empty;
+        MemoryUsage usage;
+        index++;
+        cout << "Test " << index << ": Resize and memory usage= ";
+        for(int i= 0; i < 100; i++) {
+            l.add(i);
+        }
+        l.resize(200);
+        bool unchanged= holdsRange(l, 100);
+        l.resize(40);
+        usage= l.memoryUsage();
+        RESULT_HANDLER(unchanged && holdsRange(l, 40) && l.capacity() == 40 && usage.payload == 40 * sizeof(int) && usage.slack == 0 &&
+                usage.overhead > 0 && empty.memoryUsage().total() == 0);
+        cout << usage.payload << " " << usage.overhead << endl;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        TreeList<int> l= {1, 2, 3};
+        int thrown= 0;
+        index++;
+        cout << "Test " << index << ": Out of range= ";
+        try {
+            l.at(3);
+        } catch (out_of_range& ex) {
+            thrown++;
+        }
+        try {
+            l.add(-1, 0);
+        } catch (out_of_range& ex) {
+            thrown++;
+        }
+        try {
+            l.minus(-1);
+        } catch (out_of_range& ex) {
+            thrown++;
+        }
+        try {
+            l.split(4);
+        } catch (out_of_range& ex) {
+            thrown++;
+        }
+        try {
+            l.subList(2, 1);
+        } catch (invalid_argument& ex) {
+            thrown++;
+        }
+        RESULT_HANDLER(thrown == 5 && l.equals({1, 2, 3}));
+    });
+
+    for(UnitTest& test: unitTests) {
+        test();
+    }
+    cout << "Final result: Pass= " << pass << "\tFail=" << fail << endl;
+    return 0;
+}
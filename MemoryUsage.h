@@ -0,0 +1,160 @@
+#ifndef ETSAI_COLLECTIONS_MEMORYUSAGE_H
+#define ETSAI_COLLECTIONS_MEMORYUSAGE_H
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+
+namespace etsai {
+namespace collections {
+
+/**
+ * Heap bytes owned by a collection, split by what they hold.  The collection object itself is not included, nor
+ * is memory owned by the elements, such as the characters of a long string.
+ * @author etsai
+ */
+struct MemoryUsage {
+    MemoryUsage() : payload(0), slack(0), overhead(0) {
+    }
+    MemoryUsage(std::size_t payload, std::size_t slack, std::size_t overhead) : payload(payload), slack(slack), overhead(overhead) {
+    }
+
+    /**
+     * Get the sum of all parts
+     * @return  Total number of bytes
+     */
+    std::size_t total() const {
+        return payload + slack + overhead;
+    }
+    /**
+     * Adds the other usage to this usage
+     * @param   usage   Usage to add
+     * @return  Reference to this object
+     */
+    MemoryUsage& operator +=(const MemoryUsage& usage) {
+        payload+= usage.payload;
+        slack+= usage.slack;
+        overhead+= usage.overhead;
+        return *this;
+    }
+
+    /** Bytes holding the elements */
+    std::size_t payload;
+    /** Bytes reserved for elements that have not been added yet */
+    std::size_t slack;
+    /** Bytes spent on bookkeeping, such as links, reference counts, and indices */
+    std::size_t overhead;
+};
+
+/**
+ * Process wide registry of collections whose memory is reported, for capacity planning.  Collections are tracked
+ * under a type name of the caller's choosing, and stop being tracked when the returned registration is destroyed.
+ * Usage is read from every tracked collection when a report is made, so tracked collections must not be modified
+ * by other threads while the report is built.
+ * @author etsai
+ */
+class MemoryRegistry {
+public:
+    /**
+     * Handle keeping a collection in the registry.  Destroying the handle removes the collection.
+     */
+    class Registration {
+    public:
+        Registration(Registration&& registration) : registry(registration.registry), id(registration.id) {
+            registration.registry= NULL;
+        }
+        ~Registration() {
+            if (registry != NULL) {
+                registry->remove(id);
+            }
+        }
+
+    private:
+        friend class MemoryRegistry;
+
+        Registration(MemoryRegistry* registry, long id) : registry(registry), id(id) {
+        }
+        Registration(const Registration& registration);
+        Registration& operator =(const Registration& registration);
+
+        MemoryRegistry* registry;
+        long id;
+    };
+
+    /**
+     * Get the registry shared by the whole process
+     */
+    static MemoryRegistry& global() {
+        static MemoryRegistry registry;
+
+        return registry;
+    }
+
+    MemoryRegistry() : nextId(0) {
+    }
+
+    /**
+     * Tracks the collection until the registration is destroyed.  The collection must outlive the registration.
+     * @param   collection  Collection to report, which may be any class with a memoryUsage function
+     * @param   type        Name to sum the collection's usage under
+     * @return  Handle keeping the collection in the registry
+     */
+    template <class C>
+    Registration track(const C& collection, const std::string& type) {
+        const C* tracked= &collection;
+        std::lock_guard<std::mutex> lock(entriesLock);
+
+        entries[nextId]= Entry(type, [tracked]() -> MemoryUsage {
+            return tracked->memoryUsage();
+        });
+        return Registration(this, nextId++);
+    }
+    /**
+     * Sums the usage of the tracked collections by type name
+     * @return  Map of type name to total usage
+     */
+    std::map<std::string, MemoryUsage> usageByType() const {
+        std::map<std::string, MemoryUsage> usage;
+        std::lock_guard<std::mutex> lock(entriesLock);
+
+        for(const std::pair<const long, Entry>& entry: entries) {
+            usage[entry.second.first]+= entry.second.second();
+        }
+        return usage;
+    }
+    /**
+     * Writes "memory.type.part bytes" lines for every type, in the format of OperationCounters::dump
+     * @param   output  Stream to write to
+     */
+    void dump(std::ostream& output) const {
+        for(const std::pair<const std::string, MemoryUsage>& type: usageByType()) {
+            output << "memory." << type.first << ".payload " << type.second.payload << "\n";
+            output << "memory." << type.first << ".slack " << type.second.slack << "\n";
+            output << "memory." << type.first << ".overhead " << type.second.overhead << "\n";
+        }
+    }
+
+private:
+    typedef std::pair<std::string, std::function<MemoryUsage ()>> Entry;
+
+    MemoryRegistry(const MemoryRegistry& registry);
+    MemoryRegistry& operator =(const MemoryRegistry& registry);
+
+    void remove(long id) {
+        std::lock_guard<std::mutex> lock(entriesLock);
+
+        entries.erase(id);
+    }
+
+    mutable std::mutex entriesLock;
+    std::map<long, Entry> entries;
+    long nextId;
+};
+
+}   //namespace collections
+}   //namespace etsai
+
+#endif
@@ -0,0 +1,320 @@
+#ifndef ETSAI_COLLECTIONS_QUEUE_MPMCQUEUE_H
+#define ETSAI_COLLECTIONS_QUEUE_MPMCQUEUE_H
+
+#include "MemoryUsage.h"
+
+#include <atomic>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace etsai {
+namespace collections {
+namespace queue {
+
+using std::atomic;
+using std::invalid_argument;
+
+/**
+ * Bounded FIFO queue that any number of threads can push to and pop from without locking.  Elements live in a ring
+ * buffer allocated once by the constructor.  Every slot carries a sequence number telling which lap of the ring it
+ * is ready for: a producer may fill the slot at position p when its sequence is p, and a consumer may empty it when
+ * its sequence is p + 1.  Threads claim positions by advancing the shared enqueue or dequeue position with a
+ * compare and swap, then fill or empty their slots without touching the shared positions again, so producers only
+ * contend with producers and consumers with consumers.
+ *
+ * Batches claim a run of consecutive ready slots with a single compare and swap.  If constructing an element
+ * throws, its slot is published as empty and skipped by consumers.
+ * @author etsai
+ */
+template <class T>
+class MpmcQueue {
+public:
+    /**
+     * Constructs an empty queue
+     * @param   capacity    Minimum number of elements the queue can hold, rounded up to a power of two
+     * @throws  invalid_argument    If the capacity is not positive or too large
+     */
+    explicit MpmcQueue(int capacity);
+    /**
+     * Destroys the elements left in the queue.  No other thread may use the queue while it is destroyed.
+     */
+    ~MpmcQueue();
+
+    /**
+     * Get the number of elements the queue can hold
+     */
+    int capacity() const;
+    /**
+     * Get the number of claimed slots that have not been emptied.  The value is exact only when no thread is
+     * pushing or popping.
+     */
+    int size() const;
+    /**
+     * Get whether the queue is empty.  The value is exact only when no thread is pushing or popping.
+     */
+    bool isEmpty() const;
+    /**
+     * Get the heap bytes used by the ring buffer, counting the sequence numbers as overhead
+     */
+    MemoryUsage memoryUsage() const;
+    /**
+     * Copies the element to the back of the queue.  Safe to call from any number of threads at once.
+     * @param   elem    Element to add
+     * @return  True if the element was added, false if the queue was full
+     */
+    bool tryPush(const T& elem);
+    bool tryPush(T&& elem);
+    /**
+     * Copies as many of the elements as fit to the back of the queue.  The added elements are consecutive in the
+     * queue, with no element from another producer between them.  If copying an element throws, the elements
+     * before it stay in the queue.
+     * @param   elems   Array of elements to add
+     * @param   count   Number of elements in the array
+     * @return  Number of elements added, which is the leading part of the array
+     */
+    int tryPushN(const T* elems, int count);
+    /**
+     * Moves the element at the front of the queue into elem.  Safe to call from any number of threads at once.
+     * @param   elem    Set to the removed element
+     * @return  True if an element was removed, false if the queue was empty
+     */
+    bool tryPop(T& elem);
+    /**
+     * Moves up to count consecutive elements from the front of the queue into the array, in order.  If moving an
+     * element throws, it and the rest of the batch are destroyed before the exception is rethrown.
+     * @param   elems   Array receiving the elements
+     * @param   count   Maximum number of elements to remove
+     * @return  Number of elements removed
+     */
+    int tryPopN(T* elems, int count);
+
+private:
+    struct Cell {
+        /** Position the cell is ready for: p when it may be filled for p, p + 1 when it holds the element of p */
+        atomic<long> sequence;
+        /** False if the producer's constructor threw and the cell holds no element */
+        bool filled;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+
+        T* value() {
+            return reinterpret_cast<T*>(&storage);
+        }
+    };
+    /**
+     * Shared position, padded to a cache line so producers and consumers do not write to the same line
+     */
+    struct alignas(64) Cursor {
+        atomic<long> position;
+    };
+
+    MpmcQueue(const MpmcQueue<T>& queue);
+    MpmcQueue<T>& operator =(const MpmcQueue<T>& queue);
+
+    /**
+     * Claims up to wanted consecutive cells whose sequence is their position plus the offset
+     * @param   cursor      Shared position to advance
+     * @param   offset      0 to claim cells to fill, 1 to claim cells to empty
+     * @param   wanted      Maximum number of cells to claim
+     * @param   position    Set to the first claimed position
+     * @return  Number of cells claimed, 0 if the queue was full or empty
+     */
+    int claim(Cursor& cursor, long offset, int wanted, long& position);
+    template <class U>
+    bool push(U&& elem);
+    /**
+     * Publishes the claimed cells in [begin, end) as empty so consumers skip them
+     */
+    void abandon(long begin, long end);
+
+    long mask;
+    Cell* cells;
+    Cursor enqueue;
+    Cursor dequeue;
+};
+
+template <class T>
+MpmcQueue<T>::MpmcQueue(int capacity) : mask(0), cells(NULL) {
+    if (capacity < 1 || capacity > (1 << 30)) {
+        throw invalid_argument("MpmcQueue capacity must be between 1 and 2^30");
+    }
+
+    long rounded= 1;
+    while(rounded < capacity) {
+        rounded<<= 1;
+    }
+    mask= rounded - 1;
+    cells= new Cell[rounded];
+    for(long i= 0; i < rounded; i++) {
+        cells[i].sequence.store(i, std::memory_order_relaxed);
+        cells[i].filled= false;
+    }
+    enqueue.position= 0;
+    dequeue.position= 0;
+}
+
+template <class T>
+MpmcQueue<T>::~MpmcQueue() {
+    for(long i= dequeue.position.load(); i != enqueue.position.load(); i++) {
+        Cell& cell= cells[i & mask];
+
+        if (cell.filled) {
+            cell.value()->~T();
+        }
+    }
+    delete[] cells;
+}
+
+template <class T>
+int MpmcQueue<T>::capacity() const {
+    return mask + 1;
+}
+
+template <class T>
+int MpmcQueue<T>::size() const {
+    long first= dequeue.position.load(std::memory_order_acquire);
+    long last= enqueue.position.load(std::memory_order_acquire);
+
+    return last > first ? last - first : 0;
+}
+
+template <class T>
+bool MpmcQueue<T>::isEmpty() const {
+    return size() == 0;
+}
+
+template <class T>
+MemoryUsage MpmcQueue<T>::memoryUsage() const {
+    int used= size();
+
+    return MemoryUsage(used * sizeof(T), (capacity() - used) * sizeof(T), capacity() * (sizeof(Cell) - sizeof(T)));
+}
+
+template <class T>
+bool MpmcQueue<T>::tryPush(const T& elem) {
+    return push(elem);
+}
+
+template <class T>
+bool MpmcQueue<T>::tryPush(T&& elem) {
+    return push(std::move(elem));
+}
+
+template <class T>
+int MpmcQueue<T>::tryPushN(const T* elems, int count) {
+    long position;
+    int added= count > 0 ? claim(enqueue, 0, count, position) : 0;
+
+    for(int i= 0; i < added; i++) {
+        Cell& cell= cells[(position + i) & mask];
+
+        try {
+            new(cell.value()) T(elems[i]);
+        } catch (...) {
+            abandon(position + i, position + added);
+            throw;
+        }
+        cell.filled= true;
+        cell.sequence.store(position + i + 1, std::memory_order_release);
+    }
+    return added;
+}
+
+template <class T>
+bool MpmcQueue<T>::tryPop(T& elem) {
+    return tryPopN(&elem, 1) == 1;
+}
+
+template <class T>
+int MpmcQueue<T>::tryPopN(T* elems, int count) {
+    long position;
+    int claimed, removed= 0;
+
+    if (count <= 0) {
+        return 0;
+    }
+    do {
+        claimed= claim(dequeue, 1, count, position);
+        for(int i= 0; i < claimed; i++) {
+            Cell& cell= cells[(position + i) & mask];
+
+            if (cell.filled) {
+                try {
+                    elems[removed]= std::move(*cell.value());
+                } catch (...) {
+                    for(int j= i; j < claimed; j++) {
+                        Cell& rest= cells[(position + j) & mask];
+
+                        if (rest.filled) {
+                            rest.value()->~T();
+                        }
+                        rest.sequence.store(position + j + mask + 1, std::memory_order_release);
+                    }
+                    throw;
+                }
+                removed++;
+                cell.value()->~T();
+            }
+            cell.sequence.store(position + i + mask + 1, std::memory_order_release);
+        }
+    } while(claimed > 0 && removed == 0);
+    return removed;
+}
+
+template <class T>
+int MpmcQueue<T>::claim(Cursor& cursor, long offset, int wanted, long& position) {
+    position= cursor.position.load(std::memory_order_relaxed);
+    while(true) {
+        int ready= 0;
+
+        while(ready < wanted && cells[(position + ready) & mask].sequence.load(std::memory_order_acquire) == position + ready + offset) {
+            ready++;
+        }
+        if (ready == 0) {
+            if (cells[position & mask].sequence.load(std::memory_order_acquire) < position + offset) {
+                return 0;
+            }
+            position= cursor.position.load(std::memory_order_relaxed);
+        } else if (cursor.position.compare_exchange_weak(position, position + ready, std::memory_order_relaxed)) {
+            return ready;
+        }
+    }
+}
+
+template <class T>
+template <class U>
+bool MpmcQueue<T>::push(U&& elem) {
+    long position;
+
+    if (claim(enqueue, 0, 1, position) == 0) {
+        return false;
+    }
+
+    Cell& cell= cells[position & mask];
+    try {
+        new(cell.value()) T(std::forward<U>(elem));
+    } catch (...) {
+        abandon(position, position + 1);
+        throw;
+    }
+    cell.filled= true;
+    cell.sequence.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+template <class T>
+void MpmcQueue<T>::abandon(long begin, long end) {
+    for(long i= begin; i < end; i++) {
+        Cell& cell= cells[i & mask];
+
+        cell.filled= false;
+        cell.sequence.store(i + 1, std::memory_order_release);
+    }
+}
+
+}   //namespace queue
+}   //namespace collections
+}   //namespace etsai
+
+#endif
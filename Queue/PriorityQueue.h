@@ -0,0 +1,422 @@
+#ifndef ETSAI_COLLECTIONS_QUEUE_PRIORITYQUEUE_H
+#define ETSAI_COLLECTIONS_QUEUE_PRIORITYQUEUE_H
+
+#include "Comparator.h"
+#include "MemoryUsage.h"
+#include "List/ArrayList.h"
+
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace etsai {
+namespace collections {
+namespace queue {
+
+using std::invalid_argument;
+using std::out_of_range;
+using std::stringstream;
+using std::vector;
+
+/**
+ * Priority queue stored as a d-ary heap in contiguous arrays owned by the queue.  pop removes the element ordered first by
+ * Compare, so with std::less the smallest element comes out first, the opposite of std::priority_queue.  Equivalent
+ * elements are all kept.  push, pop, and decreaseKey take O(log n) time, and building a queue from a list takes O(n).
+ *
+ * Every element gets a handle when it is pushed, which decreaseKey uses to find it after the heap has moved it.  A
+ * handle is valid until its element is popped or the queue is cleared, and is then reused for a later element.
+ * The elements and their handles are kept in separate arrays, so choosing the smallest of a node's children only
+ * reads elements.  A larger arity makes the heap shallower and keeps more of the children on one cache line, at
+ * the cost of more comparisons per level.
+ * @author etsai
+ */
+template <class T, class Compare>
+class PriorityQueue {
+public:
+    /**
+     * Identifies an element in the queue
+     */
+    typedef int Handle;
+
+    /**
+     * Constructs an empty queue
+     * @param   arity       Number of children of every node in the heap
+     * @param   compare     Comparator deciding which element comes out first
+     * @throws  invalid_argument    If the arity is less than 2
+     */
+    explicit PriorityQueue(int arity= 4, const Compare& compare= Compare());
+    /**
+     * Constructs a queue from the elements of a list in O(n).  The element at index i of the list gets handle i.
+     * @param   elements    Elements of the queue, in any order.  The list is left empty.
+     * @param   arity       Number of children of every node in the heap
+     * @param   compare     Comparator deciding which element comes out first
+     * @throws  invalid_argument    If the arity is less than 2
+     */
+    PriorityQueue(list::ArrayList<T>&& elements, int arity= 4, const Compare& compare= Compare());
+
+    /**
+     * Get the number of children of every node in the heap
+     */
+    int arity() const;
+    int size() const;
+    bool isEmpty() const;
+    /**
+     * Get the heap bytes of the queue, counting the arrays mapping between handles and heap positions as overhead
+     */
+    MemoryUsage memoryUsage() const;
+    /**
+     * Adds the element to the queue
+     * @param   elem    Element to add
+     * @return  Handle of the element
+     */
+    Handle push(const T& elem);
+    Handle push(T&& elem);
+    /**
+     * Adds every element of the collection.  When the collection is larger than the queue, the heap is rebuilt in
+     * O(n + k) instead of sifting up each of the k new elements in O(k log n).  The handles of the new elements are
+     * not returned, so push elements one at a time to decrease them later.
+     * @param   elements    Elements to add
+     */
+    void pushAll(const Collection<T>& elements);
+    /**
+     * Get the element that pop would remove
+     * @throws  out_of_range    If the queue is empty
+     */
+    const T& top() const throw(out_of_range);
+    /**
+     * Removes the element ordered first by the comparator
+     * @return  The removed element
+     * @throws  out_of_range    If the queue is empty
+     */
+    T pop() throw(out_of_range);
+    /**
+     * Get whether the element with the handle is still in the queue
+     */
+    bool isQueued(Handle handle) const;
+    /**
+     * Get the element with the handle
+     * @throws  out_of_range    If the handle does not name an element in the queue
+     */
+    const T& at(Handle handle) const throw(out_of_range);
+    /**
+     * Replaces the element with the handle by one that is not ordered after it, and moves it toward the front
+     * @param   handle  Handle of the element to replace
+     * @param   elem    New value of the element
+     * @throws  out_of_range        If the handle does not name an element in the queue
+     * @throws  invalid_argument    If the new value is ordered after the current one
+     */
+    void decreaseKey(Handle handle, const T& elem) throw(out_of_range, invalid_argument);
+    void decreaseKey(Handle handle, T&& elem) throw(out_of_range, invalid_argument);
+    /**
+     * Removes every element.  All handles become invalid.
+     */
+    void clear();
+
+private:
+    typedef CompareTraits<T, Compare> Traits;
+
+    template <class U>
+    Handle insert(U&& elem);
+    template <class U>
+    void replace(Handle handle, U&& elem);
+    /**
+     * Get a free handle, reusing one whose element was popped if there is one
+     */
+    Handle allocate();
+    /**
+     * Puts the handle on the free list
+     */
+    void release(Handle handle);
+    /**
+     * Get the heap position of the element with the handle
+     * @throws  out_of_range    If the handle does not name an element in the queue
+     */
+    int position(Handle handle) const;
+    /**
+     * Moves the element at the index toward the root until its parent is not ordered after it
+     */
+    void siftUp(int index);
+    /**
+     * Moves the element at the index toward the leaves until none of its children are ordered before it
+     */
+    void siftDown(int index);
+    /**
+     * Rebuilds the heap from arbitrarily ordered arrays, sifting down every node with children from the last one
+     */
+    void heapify();
+
+    int queueArity;
+    Compare compare;
+    /**
+     * Elements in heap order, and the handle of each element at the same index
+     */
+    vector<T> elements;
+    vector<Handle> handles;
+    /**
+     * Heap position of the element with each handle.  A free handle instead holds -2 - h, where h is the next free
+     * handle or -1 at the end of the free list.
+     */
+    vector<int> positions;
+    Handle freeHandle;
+};
+
+template <class T, class Compare>
+PriorityQueue<T, Compare>::PriorityQueue(int arity, const Compare& compare) : queueArity(arity), compare(compare), freeHandle(-1) {
+    if (arity < 2) {
+        throw invalid_argument("PriorityQueue arity must be at least 2");
+    }
+}
+
+template <class T, class Compare>
+PriorityQueue<T, Compare>::PriorityQueue(list::ArrayList<T>&& elements, int arity, const Compare& compare) :
+        queueArity(arity), compare(compare), freeHandle(-1) {
+    if (arity < 2) {
+        throw invalid_argument("PriorityQueue arity must be at least 2");
+    }
+    this->elements.reserve(elements.size());
+    elements.each([this](T& elem) -> void {
+        this->handles.push_back(this->elements.size());
+        this->positions.push_back(this->elements.size());
+        this->elements.push_back(std::move(elem));
+    });
+    elements.clear();
+    heapify();
+}
+
+template <class T, class Compare>
+int PriorityQueue<T, Compare>::arity() const {
+    return queueArity;
+}
+
+template <class T, class Compare>
+int PriorityQueue<T, Compare>::size() const {
+    return (int) elements.size();
+}
+
+template <class T, class Compare>
+bool PriorityQueue<T, Compare>::isEmpty() const {
+    return elements.empty();
+}
+
+template <class T, class Compare>
+MemoryUsage PriorityQueue<T, Compare>::memoryUsage() const {
+    return MemoryUsage(elements.size() * sizeof(T), (elements.capacity() - elements.size()) * sizeof(T), 
+            handles.capacity() * sizeof(Handle) + positions.capacity() * sizeof(int));
+}
+
+template <class T, class Compare>
+typename PriorityQueue<T, Compare>::Handle PriorityQueue<T, Compare>::push(const T& elem) {
+    return insert(elem);
+}
+
+template <class T, class Compare>
+typename PriorityQueue<T, Compare>::Handle PriorityQueue<T, Compare>::push(T&& elem) {
+    return insert(std::move(elem));
+}
+
+template <class T, class Compare>
+void PriorityQueue<T, Compare>::pushAll(const Collection<T>& collection) {
+    int previous= size(), added= collection.size();
+
+    elements.reserve(previous + added);
+    handles.reserve(previous + added);
+    collection.each([this](const T& elem) -> void {
+        Handle handle= allocate();
+
+        positions[handle]= size();
+        elements.push_back(elem);
+        handles.push_back(handle);
+    });
+    if (added > previous) {
+        heapify();
+    } else {
+        for(int i= previous; i < size(); i++) {
+            siftUp(i);
+        }
+    }
+}
+
+template <class T, class Compare>
+const T& PriorityQueue<T, Compare>::top() const throw(out_of_range) {
+    if (isEmpty()) {
+        throw out_of_range("PriorityQueue is empty");
+    }
+    return elements.front();
+}
+
+template <class T, class Compare>
+T PriorityQueue<T, Compare>::pop() throw(out_of_range) {
+    if (isEmpty()) {
+        throw out_of_range("PriorityQueue is empty");
+    }
+
+    int last= size() - 1;
+    T first(std::move(elements[0]));
+
+    release(handles[0]);
+    if (last > 0) {
+        elements[0]= std::move(elements[last]);
+        handles[0]= handles[last];
+    }
+    elements.pop_back();
+    handles.pop_back();
+    if (last > 0) {
+        siftDown(0);
+    }
+    return first;
+}
+
+template <class T, class Compare>
+bool PriorityQueue<T, Compare>::isQueued(Handle handle) const {
+    return handle >= 0 && handle < (int) positions.size() && positions[handle] >= 0;
+}
+
+template <class T, class Compare>
+const T& PriorityQueue<T, Compare>::at(Handle handle) const throw(out_of_range) {
+    return elements[position(handle)];
+}
+
+template <class T, class Compare>
+void PriorityQueue<T, Compare>::decreaseKey(Handle handle, const T& elem) throw(out_of_range, invalid_argument) {
+    replace(handle, elem);
+}
+
+template <class T, class Compare>
+void PriorityQueue<T, Compare>::decreaseKey(Handle handle, T&& elem) throw(out_of_range, invalid_argument) {
+    replace(handle, std::move(elem));
+}
+
+template <class T, class Compare>
+void PriorityQueue<T, Compare>::clear() {
+    elements.clear();
+    handles.clear();
+    positions.clear();
+    freeHandle= -1;
+}
+
+template <class T, class Compare> template <class U>
+typename PriorityQueue<T, Compare>::Handle PriorityQueue<T, Compare>::insert(U&& elem) {
+    Handle handle= allocate();
+
+    positions[handle]= size();
+    elements.push_back(std::forward<U>(elem));
+    handles.push_back(handle);
+    siftUp(size() - 1);
+    return handle;
+}
+
+template <class T, class Compare> template <class U>
+void PriorityQueue<T, Compare>::replace(Handle handle, U&& elem) {
+    int index= position(handle);
+    T* current= &elements[index];
+
+    if (Traits::less(compare, *current, elem)) {
+        stringstream msg;
+        msg << "New value for handle (" << handle << ") is ordered after its current value";
+        throw invalid_argument(msg.str());
+    }
+    *current= std::forward<U>(elem);
+    siftUp(index);
+}
+
+template <class T, class Compare>
+typename PriorityQueue<T, Compare>::Handle PriorityQueue<T, Compare>::allocate() {
+    Handle handle= freeHandle;
+
+    if (handle >= 0) {
+        freeHandle= -2 - positions[handle];
+        return handle;
+    }
+    positions.push_back(-1);
+    return (int) positions.size() - 1;
+}
+
+template <class T, class Compare>
+void PriorityQueue<T, Compare>::release(Handle handle) {
+    positions[handle]= -2 - freeHandle;
+    freeHandle= handle;
+}
+
+template <class T, class Compare>
+int PriorityQueue<T, Compare>::position(Handle handle) const {
+    if (!isQueued(handle)) {
+        stringstream msg;
+        msg << "Handle (" << handle << ") does not name an element in the queue";
+        throw out_of_range(msg.str());
+    }
+    return positions[handle];
+}
+
+template <class T, class Compare>
+void PriorityQueue<T, Compare>::siftUp(int index) {
+    T* heap= elements.data();
+    Handle* order= handles.data();
+    int* where= positions.data();
+    T elem(std::move(heap[index]));
+    Handle handle= order[index];
+
+    while(index > 0) {
+        int parent= (index - 1) / queueArity;
+
+        if (!Traits::less(compare, elem, heap[parent])) {
+            break;
+        }
+        heap[index]= std::move(heap[parent]);
+        order[index]= order[parent];
+        where[order[index]]= index;
+        index= parent;
+    }
+    heap[index]= std::move(elem);
+    order[index]= handle;
+    where[handle]= index;
+}
+
+template <class T, class Compare>
+void PriorityQueue<T, Compare>::siftDown(int index) {
+    T* heap= elements.data();
+    Handle* order= handles.data();
+    int* where= positions.data();
+    long count= size();
+    T elem(std::move(heap[index]));
+    Handle handle= order[index];
+
+    while(true) {
+        long first= (long) index * queueArity + 1, last= first + queueArity, best= first;
+
+        if (first >= count) {
+            break;
+        }
+        if (last > count) {
+            last= count;
+        }
+        for(long child= first + 1; child < last; child++) {
+            if (Traits::less(compare, heap[child], heap[best])) {
+                best= child;
+            }
+        }
+        if (!Traits::less(compare, heap[best], elem)) {
+            break;
+        }
+        heap[index]= std::move(heap[best]);
+        order[index]= order[best];
+        where[order[index]]= index;
+        index= best;
+    }
+    heap[index]= std::move(elem);
+    order[index]= handle;
+    where[handle]= index;
+}
+
+template <class T, class Compare>
+void PriorityQueue<T, Compare>::heapify() {
+    for(int i= (size() - 2) / queueArity; size() > 1 && i >= 0; i--) {
+        siftDown(i);
+    }
+}
+
+}   //namespace queue
+}   //namespace collections
+}   //namespace etsai
+
+#endif
@@ -0,0 +1,270 @@
+#ifndef ETSAI_COLLECTIONS_QUEUE_SPSCQUEUE_H
+#define ETSAI_COLLECTIONS_QUEUE_SPSCQUEUE_H
+
+#include "MemoryUsage.h"
+
+#include <atomic>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace etsai {
+namespace collections {
+namespace queue {
+
+using std::atomic;
+using std::invalid_argument;
+
+/**
+ * Bounded FIFO queue for passing elements from exactly one producer thread to exactly one consumer thread.  The
+ * elements live in a ring buffer allocated once by the constructor, so pushing and popping never allocate or lock,
+ * and every call finishes in a bounded number of steps.  The producer owns the tail index and the consumer owns
+ * the head index; the two sit on separate cache lines, and each side keeps a private copy of the other side's
+ * index so it only reads the shared one when the queue looks full or empty.
+ *
+ * Only one thread may push and only one thread may pop at any time.  Use MpmcQueue when more threads share a side.
+ * @author etsai
+ */
+template <class T>
+class SpscQueue {
+public:
+    /**
+     * Constructs an empty queue
+     * @param   capacity    Minimum number of elements the queue can hold, rounded up to a power of two
+     * @throws  invalid_argument    If the capacity is not positive or too large
+     */
+    explicit SpscQueue(int capacity);
+    /**
+     * Destroys the elements left in the queue.  Neither thread may use the queue while it is destroyed.
+     */
+    ~SpscQueue();
+
+    /**
+     * Get the number of elements the queue can hold
+     */
+    int capacity() const;
+    /**
+     * Get the number of elements in the queue.  The value is exact only when neither side is running.
+     */
+    int size() const;
+    /**
+     * Get whether the queue is empty.  The value is exact only when neither side is running.
+     */
+    bool isEmpty() const;
+    /**
+     * Get the heap bytes used by the ring buffer
+     */
+    MemoryUsage memoryUsage() const;
+    /**
+     * Copies the element to the back of the queue.  May only be called by the producer.
+     * @param   elem    Element to add
+     * @return  True if the element was added, false if the queue was full
+     */
+    bool tryPush(const T& elem);
+    bool tryPush(T&& elem);
+    /**
+     * Copies as many of the elements as fit to the back of the queue, in order, and publishes them together.  May
+     * only be called by the producer.  If copying an element throws, the elements before it stay in the queue.
+     * @param   elems   Array of elements to add
+     * @param   count   Number of elements in the array
+     * @return  Number of elements added, which is the leading part of the array
+     */
+    int tryPushN(const T* elems, int count);
+    /**
+     * Moves the element at the front of the queue into elem.  May only be called by the consumer.
+     * @param   elem    Set to the removed element
+     * @return  True if an element was removed, false if the queue was empty
+     */
+    bool tryPop(T& elem);
+    /**
+     * Moves up to count elements from the front of the queue into the array, in order, and releases their slots
+     * together.  May only be called by the consumer.
+     * @param   elems   Array receiving the elements
+     * @param   count   Maximum number of elements to remove
+     * @return  Number of elements removed
+     */
+    int tryPopN(T* elems, int count);
+
+private:
+    typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type Slot;
+
+    /**
+     * Index owned by one side, padded to a cache line so the two sides do not write to the same line
+     */
+    struct alignas(64) Side {
+        /** Next position the side will use */
+        atomic<long> position;
+        /** Last value read from the other side's position */
+        long otherPosition;
+    };
+
+    SpscQueue(const SpscQueue<T>& queue);
+    SpscQueue<T>& operator =(const SpscQueue<T>& queue);
+
+    T* slot(long position);
+    /**
+     * Get how many elements the producer can add, rereading the head only if the cached copy says there is no room
+     */
+    int freeSlots(long position, int wanted);
+    /**
+     * Get how many elements the consumer can remove, rereading the tail only if the cached copy says there are none
+     */
+    int usedSlots(long position, int wanted);
+
+    long mask;
+    Slot* slots;
+    Side head;
+    Side tail;
+};
+
+template <class T>
+SpscQueue<T>::SpscQueue(int capacity) : mask(0), slots(NULL) {
+    if (capacity < 1 || capacity > (1 << 30)) {
+        throw invalid_argument("SpscQueue capacity must be between 1 and 2^30");
+    }
+
+    long rounded= 1;
+    while(rounded < capacity) {
+        rounded<<= 1;
+    }
+    mask= rounded - 1;
+    slots= new Slot[rounded];
+    head.position= 0;
+    head.otherPosition= 0;
+    tail.position= 0;
+    tail.otherPosition= 0;
+}
+
+template <class T>
+SpscQueue<T>::~SpscQueue() {
+    for(long i= head.position.load(); i != tail.position.load(); i++) {
+        slot(i)->~T();
+    }
+    delete[] slots;
+}
+
+template <class T>
+int SpscQueue<T>::capacity() const {
+    return mask + 1;
+}
+
+template <class T>
+int SpscQueue<T>::size() const {
+    long first= head.position.load(std::memory_order_acquire);
+    long last= tail.position.load(std::memory_order_acquire);
+
+    return last > first ? last - first : 0;
+}
+
+template <class T>
+bool SpscQueue<T>::isEmpty() const {
+    return size() == 0;
+}
+
+template <class T>
+MemoryUsage SpscQueue<T>::memoryUsage() const {
+    int used= size();
+
+    return MemoryUsage(used * sizeof(Slot), (capacity() - used) * sizeof(Slot), 0);
+}
+
+template <class T>
+bool SpscQueue<T>::tryPush(const T& elem) {
+    return tryPushN(&elem, 1) == 1;
+}
+
+template <class T>
+bool SpscQueue<T>::tryPush(T&& elem) {
+    long position= tail.position.load(std::memory_order_relaxed);
+
+    if (freeSlots(position, 1) == 0) {
+        return false;
+    }
+    new(slot(position)) T(std::move(elem));
+    tail.position.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+template <class T>
+int SpscQueue<T>::tryPushN(const T* elems, int count) {
+    if (count <= 0) {
+        return 0;
+    }
+
+    long position= tail.position.load(std::memory_order_relaxed);
+    int added= freeSlots(position, count);
+
+    for(int i= 0; i < added; i++) {
+        try {
+            new(slot(position + i)) T(elems[i]);
+        } catch (...) {
+            tail.position.store(position + i, std::memory_order_release);
+            throw;
+        }
+    }
+    tail.position.store(position + added, std::memory_order_release);
+    return added;
+}
+
+template <class T>
+bool SpscQueue<T>::tryPop(T& elem) {
+    return tryPopN(&elem, 1) == 1;
+}
+
+template <class T>
+int SpscQueue<T>::tryPopN(T* elems, int count) {
+    if (count <= 0) {
+        return 0;
+    }
+
+    long position= head.position.load(std::memory_order_relaxed);
+    int removed= usedSlots(position, count);
+
+    for(int i= 0; i < removed; i++) {
+        T* current= slot(position + i);
+
+        try {
+            elems[i]= std::move(*current);
+        } catch (...) {
+            head.position.store(position + i, std::memory_order_release);
+            throw;
+        }
+        current->~T();
+    }
+    head.position.store(position + removed, std::memory_order_release);
+    return removed;
+}
+
+template <class T>
+T* SpscQueue<T>::slot(long position) {
+    return reinterpret_cast<T*>(&slots[position & mask]);
+}
+
+template <class T>
+int SpscQueue<T>::freeSlots(long position, int wanted) {
+    long available= mask + 1 - (position - tail.otherPosition);
+
+    if (available < wanted) {
+        tail.otherPosition= head.position.load(std::memory_order_acquire);
+        available= mask + 1 - (position - tail.otherPosition);
+    }
+    return available < wanted ? available : wanted;
+}
+
+template <class T>
+int SpscQueue<T>::usedSlots(long position, int wanted) {
+    long available= head.otherPosition - position;
+
+    if (available < wanted) {
+        head.otherPosition= tail.position.load(std::memory_order_acquire);
+        available= head.otherPosition - position;
+    }
+    return available < wanted ? available : wanted;
+}
+
+}   //namespace queue
+}   //namespace collections
+}   //namespace etsai
+
+#endif
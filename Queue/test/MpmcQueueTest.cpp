@@ -0,0 +1,175 @@
+#include "Queue/MpmcQueue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace etsai::collections::queue;
+using namespace std;
+
+typedef function<void (void)> UnitTest;
+
+#define RESULT_HANDLER(result)\
+    if (result) {\
+        pass++; \
+        cout << "Pass" << endl;\
+    } else {\
+        fail++;\
+        cout << "Failed" << endl;\
+    }
+
+struct Fragile {
+    Fragile() : value(0) {
+    }
+    Fragile(int value) : value(value) {
+    }
+    Fragile(const Fragile& fragile) : value(fragile.value) {
+        if (value < 0) {
+            throw invalid_argument("negative");
+        }
+    }
+
+    int value;
+};
+
+int main(int argc, char **argv) {
+    int pass= 0, fail= 0, index= -1;
+    vector<UnitTest> unitTests;
+
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        MpmcQueue<string> q(3);
+        string popped;
+        bool ordered= true, rejected= false;
+        index++;
+        cout << "Test " << index << ": Full and empty= ";
+        try {
+            MpmcQueue<int> invalid(0);
+        } catch (invalid_argument& ex) {
+            rejected= true;
+        }
+        bool emptyPop= q.tryPop(popped);
+        for(int i= 0; i < 4; i++) {
+            q.tryPush(to_string(i));
+        }
+        bool fullPush= q.tryPush(string("4"));
+        int fullSize= q.size();
+        for(int i= 0; i < 4; i++) {
+            ordered= ordered && q.tryPop(popped) && popped == to_string(i);
+        }
+        RESULT_HANDLER(rejected && q.capacity() == 4 && !emptyPop && !fullPush && fullSize == 4 && ordered && q.isEmpty() &&
+                !q.tryPop(popped));
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        MpmcQueue<int> q(8);
+        int in[10]= {0, 1, 2, 3, 4, 5, 6, 7, 8, 9}, out[10];
+        index++;
+        cout << "Test " << index << ": Batches= ";
+        int first= q.tryPushN(in, 6), firstOut= q.tryPopN(out, 4);
+        int second= q.tryPushN(in + 6, 4), secondOut= q.tryPopN(out + 4, 10);
+        bool ordered= true;
+        for(int i= 0; i < 10; i++) {
+            ordered= ordered && out[i] == i;
+        }
+        int third= q.tryPushN(in, 10);
+        RESULT_HANDLER(first == 6 && firstOut == 4 && second == 4 && secondOut == 6 && ordered && third == 8 &&
+                q.tryPushN(in, 1) == 0 && q.tryPushN(in, 0) == 0 && q.tryPopN(out, -1) == 0);
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        MpmcQueue<Fragile> q(8);
+        Fragile in[4]= {1, 2, -3, 4}, out[4];
+        bool thrown= false;
+        index++;
+        cout << "Test " << index << ": Failed construction= ";
+        try {
+            q.tryPushN(in, 4);
+        } catch (invalid_argument& ex) {
+            thrown= true;
+        }
+        q.tryPush(Fragile(5));
+        int removed= q.tryPopN(out, 4);
+        bool popped= q.tryPop(out[2]);
+        RESULT_HANDLER(thrown && removed == 2 && popped && out[0].value == 1 && out[1].value == 2 && out[2].value == 5 &&
+                q.isEmpty());
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        shared_ptr<int> value(new int(7));
+        index++;
+        cout << "Test " << index << ": Destroys leftovers= ";
+        {
+            MpmcQueue<shared_ptr<int>> q(4);
+            q.tryPush(value);
+            q.tryPush(value);
+            shared_ptr<int> popped;
+            q.tryPop(popped);
+        }
+        RESULT_HANDLER(value.use_count() == 1);
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        const int THREADS= 4, PER_THREAD= 50000, BATCH= 8;
+        MpmcQueue<int> q(64);
+        vector<thread> threads;
+        vector<vector<int>> received(THREADS);
+        atomic<int> remaining(THREADS * PER_THREAD);
+        index++;
+        cout << "Test " << index << ": Producers and consumers= ";
+        for(int t= 0; t < THREADS; t++) {
+            threads.push_back(thread([&q, t]() -> void {
+                int batch[BATCH];
+                for(int next= 0; next < PER_THREAD;) {
+                    int size= PER_THREAD - next < BATCH ? PER_THREAD - next : BATCH;
+                    for(int i= 0; i < size; i++) {
+                        batch[i]= t * PER_THREAD + next + i;
+                    }
+                    int added= q.tryPushN(batch, size);
+                    next+= added;
+                    if (added == 0) {
+                        this_thread::yield();
+                    }
+                }
+            }));
+            threads.push_back(thread([&q, &received, &remaining, t]() -> void {
+                int batch[BATCH];
+                while(remaining > 0) {
+                    int removed= t % 2 ? q.tryPopN(batch, BATCH) : q.tryPop(batch[0]);
+                    received[t].insert(received[t].end(), batch, batch + removed);
+                    remaining-= removed;
+                    if (removed == 0) {
+                        this_thread::yield();
+                    }
+                }
+            }));
+        }
+        for(thread& worker: threads) {
+            worker.join();
+        }
+
+        vector<int> values;
+        bool perProducerOrder= true;
+        for(vector<int>& consumer: received) {
+            vector<int> last(THREADS, -1);
+            for(int value: consumer) {
+                perProducerOrder= perProducerOrder && value > last[value / PER_THREAD];
+                last[value / PER_THREAD]= value;
+            }
+            values.insert(values.end(), consumer.begin(), consumer.end());
+        }
+        sort(values.begin(), values.end());
+        bool complete= (int) values.size() == THREADS * PER_THREAD;
+        for(int i= 0; complete && i < (int) values.size(); i++) {
+            complete= values[i] == i;
+        }
+        RESULT_HANDLER(complete && perProducerOrder && q.isEmpty());
+    });
+
+    for(UnitTest& test: unitTests) {
+        test();
+    }
+    cout << "Final result: Pass= " << pass << "\tFail=" << fail << endl;
+    return 0;
+}
@@ -0,0 +1,195 @@
+#include "Queue/PriorityQueue.h"
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace etsai::collections;
+using namespace etsai::collections::queue;
+using etsai::collections::list::ArrayList;
+using namespace std;
+
+typedef function<void (void)> UnitTest;
+
+#define RESULT_HANDLER(result)\
+    if (result) {\
+        pass++; \
+        cout << "Pass" << endl;\
+    } else {\
+        fail++;\
+        cout << "Failed" << endl;\
+    }
+
+/**
+ * Pops every element and checks they come out in the order given by the comparator
+ */
+template <class T, class Compare>
+bool drainsInOrder(PriorityQueue<T, Compare>& q, const vector<T>& expected) {
+    bool ordered= q.size() == (int) expected.size();
+
+    for(int i= 0; ordered && i < (int) expected.size(); i++) {
+        ordered= q.top() == expected[i] && q.pop() == expected[i];
+    }
+    return ordered && q.isEmpty();
+}
+
+int main(int argc, char **argv) {
+    int pass= 0, fail= 0, index= -1;
+    vector<UnitTest> unitTests;
+
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        int rejected= 0;
+        index++;
+        cout << "Test " << index << ": Arity= ";
+        for(int arity: {1, 0, -2}) {
+            try {
+                PriorityQueue<int> q(arity);
+            } catch (invalid_argument& ex) {
+                rejected++;
+            }
+        }
+        PriorityQueue<int> binary(2), quaternary;
+        RESULT_HANDLER(rejected == 3 && binary.arity() == 2 && quaternary.arity() == 4 && quaternary.isEmpty());
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        bool ordered= true;
+        index++;
+        cout << "Test " << index << ": Push and pop with duplicates= ";
+        for(int arity= 2; arity <= 8; arity++) {
+            PriorityQueue<int> q(arity);
+            vector<int> expected;
+            for(int i= 0; i < 1000; i++) {
+                int value= (i * 7919) % 300;
+                q.push(value);
+                expected.push_back(value);
+            }
+            sort(expected.begin(), expected.end());
+            ordered= ordered && drainsInOrder(q, expected);
+        }
+        RESULT_HANDLER(ordered);
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        PriorityQueue<string, greater<string>> q(3);
+        index++;
+        cout << "Test " << index << ": Comparator= ";
+        q.push("b");
+        q.push(string("d"));
+        q.push("a");
+        q.push("c");
+        RESULT_HANDLER(drainsInOrder(q, vector<string>({"d", "c", "b", "a"})));
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        ArrayList<int> elements;
+        vector<int> expected;
+        for(int i= 0; i < 500; i++) {
+            elements.add((i * 104729) % 1000);
+            expected.push_back((i * 104729) % 1000);
+        }
+        index++;
+        cout << "Test " << index << ": Heapify a list= ";
+        PriorityQueue<int> q(std::move(elements), 4);
+        bool handles= q.isQueued(0) && q.at(0) == 0 && q.at(499) == expected[499] && !q.isQueued(500);
+        sort(expected.begin(), expected.end());
+        RESULT_HANDLER(elements.isEmpty() && handles && drainsInOrder(q, expected));
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        PriorityQueue<int> q;
+        ArrayList<int> small= {7, 3}, large;
+        vector<int> expected= {10, 20, 30, 7, 3};
+        index++;
+        cout << "Test " << index << ": Push all= ";
+        q.push(10);
+        q.push(20);
+        q.push(30);
+        q.pushAll(small);
+        for(int i= 0; i < 20; i++) {
+            large.add(100 - i);
+            expected.push_back(100 - i);
+        }
+        q.pushAll(large);
+        sort(expected.begin(), expected.end());
+        RESULT_HANDLER(drainsInOrder(q, expected));
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        PriorityQueue<int> q(2);
+        vector<PriorityQueue<int>::Handle> handles;
+        index++;
+        cout << "Test " << index << ": Decrease key= ";
+        for(int i= 0; i < 100; i++) {
+            handles.push_back(q.push(1000 + i));
+        }
+        q.decreaseKey(handles[50], 5);
+        q.decreaseKey(handles[99], 1);
+        q.decreaseKey(handles[0], 1000);
+        int rejected= 0;
+        try {
+            q.decreaseKey(handles[10], 2000);
+        } catch (invalid_argument& ex) {
+            rejected++;
+        }
+        int first= q.pop(), second= q.pop();
+        bool freed= !q.isQueued(handles[99]) && !q.isQueued(handles[50]) && q.isQueued(handles[10]) && q.at(handles[10]) == 1010;
+        try {
+            q.decreaseKey(handles[99], 0);
+        } catch (out_of_range& ex) {
+            rejected++;
+        }
+        PriorityQueue<int>::Handle reused= q.push(3);
+        RESULT_HANDLER(first == 1 && second == 5 && freed && rejected == 2 && reused == handles[50] && q.top() == 3 &&
+                q.size() == 99);
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        PriorityQueue<int> q;
+        int thrown= 0;
+        index++;
+        cout << "Test " << index << ": Empty queue= ";
+        try {
+            q.top();
+        } catch (out_of_range& ex) {
+            thrown++;
+        }
+        try {
+            q.pop();
+        } catch (out_of_range& ex) {
+            thrown++;
+        }
+        PriorityQueue<int>::Handle handle= q.push(1);
+        q.clear();
+        try {
+            q.at(handle);
+        } catch (out_of_range& ex) {
+            thrown++;
+        }
+        RESULT_HANDLER(thrown == 3 && q.isEmpty() && !q.isQueued(handle) && !q.isQueued(-1));
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        PriorityQueue<shared_ptr<int>, function<bool (const shared_ptr<int>&, const shared_ptr<int>&)>> q(4,
+                [](const shared_ptr<int>& left, const shared_ptr<int>& right) -> bool {
+                    return *left < *right;
+                });
+        shared_ptr<int> value(new int(7));
+        index++;
+        cout << "Test " << index << ": Moves elements= ";
+        for(int i= 0; i < 10; i++) {
+            q.push(shared_ptr<int>(new int(10 - i)));
+        }
+        q.push(value);
+        bool shared= value.use_count() == 2;
+        while(!q.isEmpty() && *q.top() != 7) {
+            q.pop();
+        }
+        shared_ptr<int> popped= q.pop();
+        q.clear();
+        RESULT_HANDLER(shared && popped == value && value.use_count() == 2 && q.memoryUsage().payload == 0);
+    });
+
+    for(UnitTest& test: unitTests) {
+        test();
+    }
+    cout << "Final result: Pass= " << pass << "\tFail=" << fail << endl;
+    return 0;
+}
@@ -0,0 +1,127 @@
+#include "Queue/SpscQueue.h"
+
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace etsai::collections::queue;
+using namespace std;
+
+typedef function<void (void)> UnitTest;
+
+#define RESULT_HANDLER(result)\
+    if (result) {\
+        pass++; \
+        cout << "Pass" << endl;\
+    } else {\
+        fail++;\
+        cout << "Failed" << endl;\
+    }
+
+int main(int argc, char **argv) {
+    int pass= 0, fail= 0, index= -1;
+    vector<UnitTest> unitTests;
+
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        int rejected= 0;
+        index++;
+        cout << "Test " << index << ": Capacity= ";
+        for(int capacity: {0, -4, (1 << 30) + 1}) {
+            try {
+                SpscQueue<int> q(capacity);
+            } catch (invalid_argument& ex) {
+                rejected++;
+            }
+        }
+        SpscQueue<int> one(1), five(5), eight(8);
+        RESULT_HANDLER(rejected == 3 && one.capacity() == 1 && five.capacity() == 8 && eight.capacity() == 8 && five.isEmpty());
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        SpscQueue<string> q(4);
+        string popped;
+        bool ordered= true;
+        index++;
+        cout << "Test " << index << ": Full and empty= ";
+        bool emptyPop= q.tryPop(popped);
+        for(int i= 0; i < 4; i++) {
+            q.tryPush(to_string(i));
+        }
+        bool fullPush= q.tryPush(string("4"));
+        int fullSize= q.size();
+        for(int i= 0; i < 4; i++) {
+            ordered= ordered && q.tryPop(popped) && popped == to_string(i);
+        }
+        RESULT_HANDLER(!emptyPop && !fullPush && fullSize == 4 && ordered && q.isEmpty() && !q.tryPop(popped));
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        SpscQueue<int> q(8);
+        int in[10]= {0, 1, 2, 3, 4, 5, 6, 7, 8, 9}, out[10];
+        index++;
+        cout << "Test " << index << ": Batches= ";
+        int first= q.tryPushN(in, 6), firstOut= q.tryPopN(out, 4);
+        int second= q.tryPushN(in + 6, 4), secondOut= q.tryPopN(out + 4, 10);
+        bool ordered= true;
+        for(int i= 0; i < 10; i++) {
+            ordered= ordered && out[i] == i;
+        }
+        int third= q.tryPushN(in, 10);
+        RESULT_HANDLER(first == 6 && firstOut == 4 && second == 4 && secondOut == 6 && ordered && third == 8 &&
+                q.tryPushN(in, 1) == 0 && q.tryPushN(in, 0) == 0 && q.tryPopN(out, -1) == 0);
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        shared_ptr<int> value(new int(7));
+        index++;
+        cout << "Test " << index << ": Destroys leftovers= ";
+        {
+            SpscQueue<shared_ptr<int>> q(4);
+            q.tryPush(value);
+            q.tryPush(value);
+            shared_ptr<int> popped;
+            q.tryPop(popped);
+        }
+        RESULT_HANDLER(value.use_count() == 1);
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        const int COUNT= 200000, BATCH= 16;
+        SpscQueue<int> q(64);
+        bool ordered= true;
+        index++;
+        cout << "Test " << index << ": Producer and consumer= ";
+        thread producer([&q]() -> void {
+            int batch[BATCH];
+            for(int next= 0; next < COUNT;) {
+                int size= COUNT - next < BATCH ? COUNT - next : BATCH;
+                for(int i= 0; i < size; i++) {
+                    batch[i]= next + i;
+                }
+                int added= q.tryPushN(batch, size);
+                next+= added;
+                if (added == 0) {
+                    this_thread::yield();
+                }
+            }
+        });
+        int expected= 0, popped[BATCH];
+        while(expected < COUNT) {
+            int removed= q.tryPopN(popped, BATCH);
+            for(int i= 0; i < removed; i++) {
+                ordered= ordered && popped[i] == expected++;
+            }
+            if (removed == 0) {
+                this_thread::yield();
+            }
+        }
+        producer.join();
+        RESULT_HANDLER(ordered && q.isEmpty());
+    });
+
+    for(UnitTest& test: unitTests) {
+        test();
+    }
+    cout << "Final result: Pass= " << pass << "\tFail=" << fail << endl;
+    return 0;
+}
@@ -14,13 +14,25 @@ template <class T>
 class Set : public Collection<T> {
 public:
     virtual ~Set()= 0;
+    /**
+     * Dispatches the set as a generic set.  Sets with their own dispatcher overload must override this function.
+     * @param   dispatcher  Dispatcher to pass the set to
+     */
+    virtual void accept(Dispatcher<T>& dispatcher) const;
 };
 
 template <class T>
 Set<T>::~Set() {
 }
 
+template <class T>
+void Set<T>::accept(Dispatcher<T>& dispatcher) const {
+    dispatcher.dispatch(*this);
+}
+
 }
 }
 
+#include "src/DispatcherImpl.h"
+
 #endif
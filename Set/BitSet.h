@@ -0,0 +1,357 @@
+#ifndef ETSAI_COLLECTIONS_SET_BITSET_H
+#define ETSAI_COLLECTIONS_SET_BITSET_H
+
+#include "Set.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace etsai {
+namespace collections {
+namespace set {
+
+using std::out_of_range;
+using std::uint64_t;
+using std::unique_ptr;
+
+/**
+ * A set of non-negative integers backed by a dense bit array, where bit i of the array is set if i is in the set.
+ * Adding, removing, and searching for elements take constant time, and the set only uses one bit per value in the
+ * domain [0, capacity).  Elements are visited in ascending order.  Union, intersection, and difference are computed
+ * a word at a time, and with AVX2 instructions when the compiler targets them.
+ * @author etsai
+ */
+class BitSet : public collections::Set<int> {
+public:
+    /**
+     * Constructs an empty set with a domain of [0, 0).  The domain grows as elements are added.
+     */
+    BitSet();
+    /**
+     * Copy constructor
+     */
+    BitSet(const BitSet& set);
+    /**
+     * Constructs an empty set that can hold the values [0, universe) without allocating more memory
+     * @param   universe    Size of the initial domain
+     */
+    explicit BitSet(int universe);
+    /**
+     * Constructs a set containing the elements in the initializer list
+     * @param   elements    Initial values for the set, which must be non-negative
+     */
+    BitSet(initializer_list<int> elements);
+    ~BitSet();
+
+    virtual BitSet* clone() const;
+    virtual bool equals(initializer_list<int> collection) const;
+    virtual bool equals(const Collection<int>* collection) const;
+    /**
+     * Get the number of elements in the set.  The count is maintained by add and remove, and recomputed with
+     * population counts after the bulk set operations.
+     * @return  Number of elements
+     */
+    virtual int size() const;
+    /**
+     * Get the size of the domain the set can hold without allocating more memory
+     * @return  Size of the domain
+     */
+    virtual int capacity() const;
+    /**
+     * Get the heap bytes owned by the set.  The whole word array is reported as payload, since every bit of it 
+     * encodes the membership of one value in the domain.
+     * @return  Bytes owned by the set
+     */
+    virtual MemoryUsage memoryUsage() const;
+
+    virtual bool isEmpty() const;
+    virtual bool contains(const int& elem) const;
+    virtual bool exists(const function<bool (const int&)>& predicate) const;
+    virtual bool forAll(const function<bool (const int&)>& predicate) const;
+
+    virtual void each(const function<void (const int&)>& lambda) const;
+    /**
+     * Applies the lambda to each element in the collection.  Modified values are moved to their new position in
+     * the set, merging with any value that is already present.
+     * @param   lambda      Lambda function to evaluate each element with
+     */
+    virtual void each(const function<void (int&)>& lambda);
+    virtual bool remove(const int& elem);
+    /**
+     * Adds the element to the set, growing the domain if the element lies beyond the current capacity
+     * @param   elem    Element to add
+     * @return  True if the set was modified
+     * @throws  out_of_range    If the element is negative
+     */
+    virtual bool add(const int& elem);
+    /**
+     * Removes all elements from the set, keeping the domain size
+     */
+    virtual void clear();
+
+    /**
+     * Adds all elements of the other set to this set
+     * @param   set     Set to union with
+     */
+    void unionWith(const BitSet& set);
+    /**
+     * Removes all elements from this set that are not in the other set
+     * @param   set     Set to intersect with
+     */
+    void intersectWith(const BitSet& set);
+    /**
+     * Removes all elements from this set that are in the other set
+     * @param   set     Set to subtract
+     */
+    void differenceWith(const BitSet& set);
+
+private:
+    static const int WORD_BITS= 64;
+
+    struct Or {
+        static inline uint64_t apply(uint64_t left, uint64_t right) {
+            return left | right;
+        }
+#ifdef __AVX2__
+        static inline __m256i apply(__m256i left, __m256i right) {
+            return _mm256_or_si256(left, right);
+        }
+#endif
+    };
+    struct And {
+        static inline uint64_t apply(uint64_t left, uint64_t right) {
+            return left & right;
+        }
+#ifdef __AVX2__
+        static inline __m256i apply(__m256i left, __m256i right) {
+            return _mm256_and_si256(left, right);
+        }
+#endif
+    };
+    struct AndNot {
+        static inline uint64_t apply(uint64_t left, uint64_t right) {
+            return left & ~right;
+        }
+#ifdef __AVX2__
+        static inline __m256i apply(__m256i left, __m256i right) {
+            return _mm256_andnot_si256(right, left);
+        }
+#endif
+    };
+
+    /**
+     * Combines the first length words of this set with the other set's words, then recounts the elements
+     * @param   set     Set whose words are the right operand
+     * @param   length  Number of words to combine
+     */
+    template <class Op>
+    void combine(const BitSet& set, int length);
+    /**
+     * Grows the word array so it holds at least the given number of words
+     * @param   minWords    Minimum number of words to hold
+     */
+    void reserveWords(int minWords);
+    /**
+     * Recomputes the element count with population counts
+     */
+    void recount();
+
+    int wordCount, setSize;
+    unique_ptr<uint64_t[]> words;
+};
+
+inline BitSet::BitSet() : BitSet(0) {
+}
+
+inline BitSet::BitSet(const BitSet& set) : wordCount(set.wordCount), setSize(set.setSize) {
+    if (wordCount > 0) {
+        words.reset(new uint64_t[wordCount]);
+        std::copy(set.words.get(), set.words.get() + wordCount, words.get());
+    }
+}
+
+inline BitSet::BitSet(int universe) : wordCount((int) ((std::max(universe, 0) + (long) WORD_BITS - 1) / WORD_BITS)), setSize(0) {
+    if (wordCount > 0) {
+        words.reset(new uint64_t[wordCount]());
+    }
+}
+
+inline BitSet::BitSet(initializer_list<int> elements) : BitSet() {
+    for(int elem: elements) {
+        add(elem);
+    }
+}
+
+inline BitSet::~BitSet() {
+}
+
+inline BitSet* BitSet::clone() const {
+    return new BitSet(*this);
+}
+
+inline bool BitSet::equals(initializer_list<int> collection) const {
+    BitSet copy(collection);
+
+    return equals(&copy);
+}
+
+inline bool BitSet::equals(const Collection<int>* collection) const {
+    return collection->size() == setSize && collection->forAll([this](const int& elem) -> bool {
+        return this->contains(elem);
+    });
+}
+
+inline int BitSet::size() const {
+    return setSize;
+}
+
+inline int BitSet::capacity() const {
+    return (int) std::min((long) wordCount * WORD_BITS, (long) INT_MAX);
+}
+
+inline MemoryUsage BitSet::memoryUsage() const {
+    return MemoryUsage(wordCount * sizeof(uint64_t), 0, 0);
+}
+
+inline bool BitSet::isEmpty() const {
+    return setSize == 0;
+}
+
+inline bool BitSet::contains(const int& elem) const {
+    return elem >= 0 && elem / WORD_BITS < wordCount && (words[elem / WORD_BITS] >> (elem % WORD_BITS) & 1);
+}
+
+inline bool BitSet::exists(const function<bool (const int&)>& predicate) const {
+    for(int i= 0; i < wordCount; i++) {
+        for(uint64_t word= words[i]; word != 0; word&= word - 1) {
+            if (predicate(i * WORD_BITS + __builtin_ctzll(word))) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+inline bool BitSet::forAll(const function<bool (const int&)>& predicate) const {
+    return !exists([&predicate](const int& elem) -> bool {
+        return !predicate(elem);
+    });
+}
+
+inline void BitSet::each(const function<void (const int&)>& lambda) const {
+    for(int i= 0; i < wordCount; i++) {
+        for(uint64_t word= words[i]; word != 0; word&= word - 1) {
+            lambda(i * WORD_BITS + __builtin_ctzll(word));
+        }
+    }
+}
+
+inline void BitSet::each(const function<void (int&)>& lambda) {
+    BitSet modified(capacity());
+
+    static_cast<const BitSet*>(this)->each([&modified, &lambda](const int& elem) -> void {
+        int value= elem;
+        lambda(value);
+        modified.add(value);
+    });
+    wordCount= modified.wordCount;
+    setSize= modified.setSize;
+    words.swap(modified.words);
+}
+
+inline bool BitSet::remove(const int& elem) {
+    if (!contains(elem)) {
+        return false;
+    }
+    words[elem / WORD_BITS]&= ~(uint64_t(1) << (elem % WORD_BITS));
+    setSize--;
+    return true;
+}
+
+inline bool BitSet::add(const int& elem) {
+    if (elem < 0) {
+        throw out_of_range("BitSet can only hold non-negative integers");
+    }
+    if (contains(elem)) {
+        return false;
+    }
+    if (elem / WORD_BITS >= wordCount) {
+        reserveWords(std::max(elem / WORD_BITS + 1, (int) (wordCount * 1.5)));
+    }
+    words[elem / WORD_BITS]|= uint64_t(1) << (elem % WORD_BITS);
+    setSize++;
+    return true;
+}
+
+inline void BitSet::clear() {
+    std::fill(words.get(), words.get() + wordCount, 0);
+    setSize= 0;
+}
+
+inline void BitSet::unionWith(const BitSet& set) {
+    reserveWords(set.wordCount);
+    combine<Or>(set, set.wordCount);
+}
+
+inline void BitSet::intersectWith(const BitSet& set) {
+    int common= std::min(wordCount, set.wordCount);
+
+    std::fill(words.get() + common, words.get() + wordCount, 0);
+    combine<And>(set, common);
+}
+
+inline void BitSet::differenceWith(const BitSet& set) {
+    combine<AndNot>(set, std::min(wordCount, set.wordCount));
+}
+
+template <class Op>
+void BitSet::combine(const BitSet& set, int length) {
+    uint64_t *left= words.get();
+    const uint64_t *right= set.words.get();
+    int i= 0;
+
+#ifdef __AVX2__
+    for(; i + 4 <= length; i+= 4) {
+        __m256i result= Op::apply(_mm256_loadu_si256((const __m256i*) (left + i)), _mm256_loadu_si256((const __m256i*) (right + i)));
+        _mm256_storeu_si256((__m256i*) (left + i), result);
+    }
+#endif
+    for(; i < length; i++) {
+        left[i]= Op::apply(left[i], right[i]);
+    }
+    recount();
+}
+
+inline void BitSet::reserveWords(int minWords) {
+    if (minWords > wordCount) {
+        uint64_t *newWords= new uint64_t[minWords]();
+
+        if (wordCount > 0) {
+            std::copy(words.get(), words.get() + wordCount, newWords);
+        }
+        words.reset(newWords);
+        wordCount= minWords;
+    }
+}
+
+inline void BitSet::recount() {
+    setSize= 0;
+    for(int i= 0; i < wordCount; i++) {
+        setSize+= __builtin_popcountll(words[i]);
+    }
+}
+
+}   //namespace set
+}   //namespace collections
+}   //namespace etsai
+
+#endif
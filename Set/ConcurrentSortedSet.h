@@ -0,0 +1,396 @@
+#ifndef ETSAI_COLLECTIONS_SET_CONCURRENTSORTEDSET_H
+#define ETSAI_COLLECTIONS_SET_CONCURRENTSORTEDSET_H
+
+#include "Set.h"
+#include "Set/SortedSet.h"
+#include "src/AlignedArray.h"
+
+#include <atomic>
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace etsai {
+namespace collections {
+namespace set {
+
+using std::atomic;
+using std::lock_guard;
+using std::mutex;
+using std::vector;
+
+/**
+ * A sorted set that can be shared across threads.  Readers never lock; they take an immutable snapshot of the
+ * current version with an atomic pointer load and read from it.  Writers are serialized, copy the current
+ * version, apply their mutations, and atomically publish the result.  Several mutations can be batched into one
+ * published version with the update function.
+ *
+ * Old versions are reclaimed with a two phase epoch scheme: readers announce themselves in one of a fixed number
+ * of cache line sized slots under the parity of the current epoch, and each publish flips the epoch.  A reader may
+ * load a version under either parity, since an epoch can change between its announcement and its load, so a
+ * replaced version is retired and freed by a later writer only once both parities have been seen empty since it
+ * was retired.  Flipping the epoch lets each parity drain while new readers enter under the other.  Writers
+ * never wait for readers, so a thread may keep a snapshot while updating the set.  Readers on different threads
+ * usually land in different slots, so reads scale with the number of cores.  The set must not be destroyed while
+ * snapshots of it are alive.
+ * @author etsai
+ */
+template <class T, class Compare= std::less<T>>
+class ConcurrentSortedSet : public collections::Set<T> {
+private:
+    struct ReaderSlot;
+
+public:
+    /**
+     * Read-only handle to one published version of the set.  The version is guaranteed to stay alive, and
+     * unchanged, for the lifetime of the snapshot.  Snapshots should be short lived, since no retired version
+     * can be freed while a snapshot keeps its reader slot occupied.
+     */
+    class Snapshot {
+    public:
+        Snapshot(Snapshot&& snapshot);
+        /**
+         * Leaves the read side, allowing the version to be reclaimed
+         */
+        ~Snapshot();
+
+        const SortedSet<T, Compare>& operator*() const;
+        const SortedSet<T, Compare>* operator->() const;
+
+    private:
+        friend class ConcurrentSortedSet<T, Compare>;
+
+        Snapshot(atomic<long>* readers, const SortedSet<T, Compare>* version);
+        Snapshot(const Snapshot& snapshot);
+
+        atomic<long>* readers;
+        const SortedSet<T, Compare>* version;
+    };
+
+    /**
+     * Constructs an empty set ordered by the given comparator
+     * @param   compare     Comparator defining the ordering of the set
+     */
+    ConcurrentSortedSet(const Compare& compare= Compare());
+    /**
+     * Copy constructor.  The new set starts with the current version of the given set.
+     */
+    ConcurrentSortedSet(const ConcurrentSortedSet<T, Compare>& set);
+    /**
+     * Constructs a set containing the elements in the initializer list, ordered by the given comparator
+     * @param   elements    Initial values for the set
+     * @param   compare     Comparator defining the ordering of the set
+     */
+    ConcurrentSortedSet(const initializer_list<T>& elements, const Compare& compare= Compare());
+    /**
+     * Frees the current version.  No snapshots may be alive when the set is destroyed.
+     */
+    ~ConcurrentSortedSet();
+
+    /**
+     * Takes a snapshot of the current version.  This is lock free and does not block writers from publishing
+     * new versions.
+     * @return  Handle to the current version
+     */
+    Snapshot snapshot() const;
+    /**
+     * Applies a batch of mutations to a private copy of the current version, then publishes the copy as the new
+     * version.  Readers see either none or all of the mutations.
+     * @param   mutation    Lambda that modifies the new version
+     */
+    void update(const function<void (SortedSet<T, Compare>&)>& mutation);
+
+    virtual ConcurrentSortedSet* clone() const;
+    virtual bool equals(initializer_list<T> collection) const;
+    virtual bool equals(const Collection<T>* collection) const;
+    virtual int size() const;
+    virtual int capacity() const;
+    /**
+     * Get the heap bytes owned by the current version, including the version object itself, and by the reader
+     * slots.  Retired versions waiting for readers to leave are not included.
+     * @return  Bytes owned by the set
+     */
+    virtual MemoryUsage memoryUsage() const;
+
+    virtual bool isEmpty() const;
+    virtual bool contains(const T& elem) const;
+    virtual bool exists(const function<bool (const T&)>& predicate) const;
+    virtual bool forAll(const function<bool (const T&)>& predicate) const;
+
+    virtual void each(const function<void (const T&)>& lambda) const;
+    /**
+     * Applies the lambda to each element of a new version.  The modified elements must keep their relative
+     * ordering, otherwise the set is left in an undefined state.
+     */
+    virtual void each(const function<void (T&)>& lambda);
+    virtual bool remove(const T& elem);
+    virtual bool add(const T& elem);
+    virtual void clear();
+
+private:
+    static const int READER_SLOTS= 64;
+
+    /**
+     * Reader counts for both epoch parities, padded to its own cache line
+     */
+    struct alignas(64) ReaderSlot {
+        atomic<long> readers[2];
+    };
+
+    /**
+     * Replaced version waiting for the readers that may have loaded it to leave
+     */
+    struct Retired {
+        SortedSet<T, Compare>* version;
+        /** Whether each parity has been seen with no readers since the version was retired */
+        bool drained[2];
+    };
+
+    /**
+     * Replaces the current version and retires the old one.  Must be called with the writer lock held.
+     * @param   version     New version to publish
+     */
+    void publish(SortedSet<T, Compare>* version);
+    /**
+     * Frees the retired versions that no reader can see anymore.  Must be called with the writer lock held.
+     */
+    void reclaim();
+    /**
+     * Get the reader slot assigned to the calling thread
+     */
+    ReaderSlot& slot() const;
+
+    Compare compare;
+    atomic<SortedSet<T, Compare>*> current;
+    atomic<unsigned long> epoch;
+    mutex writerLock;
+    vector<Retired> retired;
+    AlignedArray<ReaderSlot> slots;
+};
+
+template <class T, class Compare>
+ConcurrentSortedSet<T, Compare>::Snapshot::Snapshot(atomic<long>* readers, const SortedSet<T, Compare>* version) :
+        readers(readers), version(version) {
+}
+
+template <class T, class Compare>
+ConcurrentSortedSet<T, Compare>::Snapshot::Snapshot(Snapshot&& snapshot) : readers(snapshot.readers), version(snapshot.version) {
+    snapshot.readers= NULL;
+    snapshot.version= NULL;
+}
+
+template <class T, class Compare>
+ConcurrentSortedSet<T, Compare>::Snapshot::~Snapshot() {
+    if (readers != NULL) {
+        readers->fetch_sub(1);
+    }
+}
+
+template <class T, class Compare>
+const SortedSet<T, Compare>& ConcurrentSortedSet<T, Compare>::Snapshot::operator*() const {
+    return *version;
+}
+
+template <class T, class Compare>
+const SortedSet<T, Compare>* ConcurrentSortedSet<T, Compare>::Snapshot::operator->() const {
+    return version;
+}
+
+template <class T, class Compare>
+ConcurrentSortedSet<T, Compare>::ConcurrentSortedSet(const Compare& compare) : compare(compare), current(new SortedSet<T, Compare>(compare)), epoch(0),
+        slots(READER_SLOTS) {
+    for(ReaderSlot& slot: slots) {
+        slot.readers[0]= 0;
+        slot.readers[1]= 0;
+    }
+}
+
+template <class T, class Compare>
+ConcurrentSortedSet<T, Compare>::ConcurrentSortedSet(const ConcurrentSortedSet<T, Compare>& set) : ConcurrentSortedSet(set.compare) {
+    Snapshot version(set.snapshot());
+    delete current.exchange(new SortedSet<T, Compare>(*version));
+}
+
+template <class T, class Compare>
+ConcurrentSortedSet<T, Compare>::ConcurrentSortedSet(const initializer_list<T>& elements, const Compare& compare) : ConcurrentSortedSet(compare) {
+    delete current.exchange(new SortedSet<T, Compare>(elements, compare));
+}
+
+template <class T, class Compare>
+ConcurrentSortedSet<T, Compare>::~ConcurrentSortedSet() {
+    for(Retired& version: retired) {
+        delete version.version;
+    }
+    delete current.load();
+}
+
+template <class T, class Compare>
+typename ConcurrentSortedSet<T, Compare>::ReaderSlot& ConcurrentSortedSet<T, Compare>::slot() const {
+    static atomic<unsigned int> nextSlot(0);
+    static thread_local unsigned int slotIndex= nextSlot.fetch_add(1) % READER_SLOTS;
+
+    return slots[slotIndex];
+}
+
+template <class T, class Compare>
+typename ConcurrentSortedSet<T, Compare>::Snapshot ConcurrentSortedSet<T, Compare>::snapshot() const {
+    ReaderSlot& readerSlot= slot();
+    atomic<long>* readers;
+
+    while(true) {
+        unsigned long readEpoch= epoch.load();
+
+        readers= &readerSlot.readers[readEpoch & 1];
+        readers->fetch_add(1);
+        if (epoch.load() == readEpoch) {
+            break;
+        }
+        readers->fetch_sub(1);
+    }
+    return Snapshot(readers, current.load());
+}
+
+template <class T, class Compare>
+void ConcurrentSortedSet<T, Compare>::publish(SortedSet<T, Compare>* version) {
+    Retired old= {current.exchange(version), {false, false}};
+
+    epoch.fetch_add(1);
+    retired.push_back(old);
+    reclaim();
+}
+
+template <class T, class Compare>
+void ConcurrentSortedSet<T, Compare>::reclaim() {
+    bool drained[2]= {true, true};
+
+    for(ReaderSlot& slot: slots) {
+        drained[0]= drained[0] && slot.readers[0].load() == 0;
+        drained[1]= drained[1] && slot.readers[1].load() == 0;
+    }
+
+    auto end= retired.begin();
+    for(auto it= retired.begin(); it != retired.end(); it++) {
+        it->drained[0]= it->drained[0] || drained[0];
+        it->drained[1]= it->drained[1] || drained[1];
+        if (it->drained[0] && it->drained[1]) {
+            delete it->version;
+        } else {
+            *end= *it;
+            end++;
+        }
+    }
+    retired.erase(end, retired.end());
+}
+
+template <class T, class Compare>
+void ConcurrentSortedSet<T, Compare>::update(const function<void (SortedSet<T, Compare>&)>& mutation) {
+    lock_guard<mutex> lock(writerLock);
+    SortedSet<T, Compare>* version= new SortedSet<T, Compare>(*current.load());
+
+    try {
+        mutation(*version);
+    } catch (...) {
+        delete version;
+        throw;
+    }
+    publish(version);
+}
+
+template <class T, class Compare>
+ConcurrentSortedSet<T, Compare>* ConcurrentSortedSet<T, Compare>::clone() const {
+    return new ConcurrentSortedSet<T, Compare>(*this);
+}
+
+template <class T, class Compare>
+bool ConcurrentSortedSet<T, Compare>::equals(initializer_list<T> collection) const {
+    return snapshot()->equals(collection);
+}
+
+template <class T, class Compare>
+bool ConcurrentSortedSet<T, Compare>::equals(const Collection<T>* collection) const {
+    return snapshot()->equals(collection);
+}
+
+template <class T, class Compare>
+int ConcurrentSortedSet<T, Compare>::size() const {
+    return snapshot()->size();
+}
+
+template <class T, class Compare>
+int ConcurrentSortedSet<T, Compare>::capacity() const {
+    return snapshot()->capacity();
+}
+
+template <class T, class Compare>
+MemoryUsage ConcurrentSortedSet<T, Compare>::memoryUsage() const {
+    MemoryUsage usage= snapshot()->memoryUsage();
+
+    usage.overhead+= sizeof(SortedSet<T, Compare>) + READER_SLOTS * sizeof(ReaderSlot);
+    return usage;
+}
+
+template <class T, class Compare>
+bool ConcurrentSortedSet<T, Compare>::isEmpty() const {
+    return snapshot()->isEmpty();
+}
+
+template <class T, class Compare>
+bool ConcurrentSortedSet<T, Compare>::contains(const T& elem) const {
+    return snapshot()->contains(elem);
+}
+
+template <class T, class Compare>
+bool ConcurrentSortedSet<T, Compare>::exists(const function<bool (const T&)>& predicate) const {
+    return snapshot()->exists(predicate);
+}
+
+template <class T, class Compare>
+bool ConcurrentSortedSet<T, Compare>::forAll(const function<bool (const T&)>& predicate) const {
+    return snapshot()->forAll(predicate);
+}
+
+template <class T, class Compare>
+void ConcurrentSortedSet<T, Compare>::each(const function<void (const T&)>& lambda) const {
+    snapshot()->each(lambda);
+}
+
+template <class T, class Compare>
+void ConcurrentSortedSet<T, Compare>::each(const function<void (T&)>& lambda) {
+    update([&lambda](SortedSet<T, Compare>& version) -> void {
+        version.each(lambda);
+    });
+}
+
+template <class T, class Compare>
+bool ConcurrentSortedSet<T, Compare>::remove(const T& elem) {
+    bool modified= false;
+
+    update([&modified, &elem](SortedSet<T, Compare>& version) -> void {
+        modified= version.remove(elem);
+    });
+    return modified;
+}
+
+template <class T, class Compare>
+bool ConcurrentSortedSet<T, Compare>::add(const T& elem) {
+    bool modified= false;
+
+    update([&modified, &elem](SortedSet<T, Compare>& version) -> void {
+        modified= version.add(elem);
+    });
+    return modified;
+}
+
+template <class T, class Compare>
+void ConcurrentSortedSet<T, Compare>::clear() {
+    lock_guard<mutex> lock(writerLock);
+    publish(new SortedSet<T, Compare>(compare));
+}
+
+}   //namespace set
+}   //namespace collections
+}   //namespace etsai
+
+#endif
@@ -0,0 +1,779 @@
+#ifndef ETSAI_COLLECTIONS_SET_ROARINGSET_H
+#define ETSAI_COLLECTIONS_SET_ROARINGSET_H
+
+#include "Set.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <istream>
+#include <iterator>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+
+namespace etsai {
+namespace collections {
+namespace set {
+
+using std::runtime_error;
+using std::size_t;
+using std::uint16_t;
+using std::uint32_t;
+using std::uint64_t;
+using std::vector;
+
+/**
+ * A compressed set of 32-bit unsigned integers in the style of a roaring bitmap.  Values are partitioned by their
+ * high 16 bits, and the low 16 bits of each partition are stored in a container picked by its density: a sorted
+ * array for sparse partitions, a 65536 bit bitmap for dense ones, and a list of runs for partitions made of
+ * consecutive values.  Partitions are kept sorted by their high bits, so elements are visited in ascending order.
+ *
+ * Adding and removing values switch between array and bitmap containers as needed.  Run containers are only
+ * created by runOptimize, and are converted back to an array or bitmap the first time they are modified.
+ * @author etsai
+ */
+class RoaringSet : public collections::Set<uint32_t> {
+public:
+    /**
+     * Constructs an empty set
+     */
+    RoaringSet();
+    /**
+     * Copy constructor
+     */
+    RoaringSet(const RoaringSet& set);
+    /**
+     * Constructs a set containing the elements in the initializer list
+     * @param   elements    Initial values for the set
+     */
+    RoaringSet(initializer_list<uint32_t> elements);
+    ~RoaringSet();
+
+    virtual RoaringSet* clone() const;
+    virtual bool equals(initializer_list<uint32_t> collection) const;
+    virtual bool equals(const Collection<uint32_t>* collection) const;
+    virtual int size() const;
+    /**
+     * A roaring set has no fixed capacity, so the capacity equals the size
+     */
+    virtual int capacity() const;
+
+    virtual bool isEmpty() const;
+    virtual bool contains(const uint32_t& elem) const;
+    virtual bool exists(const function<bool (const uint32_t&)>& predicate) const;
+    virtual bool forAll(const function<bool (const uint32_t&)>& predicate) const;
+
+    virtual void each(const function<void (const uint32_t&)>& lambda) const;
+    /**
+     * Applies the lambda to each element in the collection.  Modified values are moved to their new position in
+     * the set, merging with any value that is already present.
+     * @param   lambda      Lambda function to evaluate each element with
+     */
+    virtual void each(const function<void (uint32_t&)>& lambda);
+    virtual bool remove(const uint32_t& elem);
+    virtual bool add(const uint32_t& elem);
+    virtual void clear();
+
+    /**
+     * Adds all elements of the other set to this set.  Matching partitions are merged with an algorithm picked by
+     * their container types.
+     * @param   set     Set to union with
+     */
+    void unionWith(const RoaringSet& set);
+    /**
+     * Removes all elements from this set that are not in the other set.  Matching partitions are intersected with
+     * an algorithm picked by their container types.
+     * @param   set     Set to intersect with
+     */
+    void intersectWith(const RoaringSet& set);
+    /**
+     * Converts each container to a run container if that takes less memory than its current representation
+     */
+    void runOptimize();
+    /**
+     * Get the heap bytes owned by the set.  The values and bitmaps of the containers are the payload; the key 
+     * index and the container objects are overhead.
+     * @return  Bytes owned by the set
+     */
+    virtual MemoryUsage memoryUsage() const;
+    /**
+     * Writes the set to the stream in a portable binary format.  All integers are written in little endian byte
+     * order, so the output can be read back on any platform.
+     * @param   output  Stream to write to
+     */
+    void serialize(std::ostream& output) const;
+    /**
+     * Replaces the contents of the set with the set stored in the stream, in the format written by serialize
+     * @param   input   Stream to read from
+     * @throws  runtime_error   If the stream does not hold a valid serialized set
+     */
+    void deserialize(std::istream& input);
+
+private:
+    static const int ARRAY_MAX= 4096;
+    static const int BITMAP_WORDS= 1024;
+    static const uint32_t MAGIC= 0x54455352;
+    static const uint16_t VERSION= 1;
+
+    /**
+     * Holds the low 16 bits of all values in one partition
+     */
+    struct Container {
+        enum Type {
+            ARRAY,
+            BITMAP,
+            RUN
+        };
+
+        Container();
+
+        bool contains(uint16_t value) const;
+        bool add(uint16_t value);
+        bool remove(uint16_t value);
+        /**
+         * Visits the values in ascending order until the visitor returns false
+         * @return  False if the visitor stopped the iteration
+         */
+        template <class Visitor>
+        bool each(Visitor visitor) const;
+        /**
+         * Get the container as a bitmap, regardless of its type
+         */
+        vector<uint64_t> bitmap() const;
+        /**
+         * Converts the container to an array if it is small enough, otherwise to a bitmap
+         */
+        void normalize();
+        void toArray();
+        void toBitmap();
+        void runOptimize();
+        MemoryUsage memoryUsage() const;
+
+        static Container unite(const Container& left, const Container& right);
+        static Container intersect(const Container& left, const Container& right);
+
+        Type type;
+        int cardinality;
+        /**
+         * Sorted values for array containers, or (start, length - 1) pairs for run containers
+         */
+        vector<uint16_t> values;
+        /**
+         * Bits for bitmap containers
+         */
+        vector<uint64_t> words;
+    };
+
+    /**
+     * Finds the position of the partition with the given high bits
+     * @param   key     High 16 bits of the value
+     * @param   found   Set to true if the partition exists
+     * @return  Index of the partition, or the index to insert it at
+     */
+    int find(uint16_t key, bool& found) const;
+    void recount();
+    /**
+     * Counts the values of a container read from a stream, checking that it is well formed
+     * @param   container   Decoded container
+     * @return  Number of values in the container
+     * @throws  runtime_error   If the container is empty, or its array values or runs are not strictly ascending
+     */
+    static int countDecoded(const Container& container);
+
+    static void writeInt(std::ostream& output, uint64_t value, int bytes);
+    static uint64_t readInt(std::istream& input, int bytes);
+
+    int setSize;
+    vector<uint16_t> keys;
+    vector<Container> containers;
+};
+
+inline RoaringSet::Container::Container() : type(ARRAY), cardinality(0) {
+}
+
+inline bool RoaringSet::Container::contains(uint16_t value) const {
+    switch(type) {
+        case ARRAY:
+            return std::binary_search(values.begin(), values.end(), value);
+        case BITMAP:
+            return words[value >> 6] >> (value & 63) & 1;
+        default: {
+            int low= 0, high= values.size() / 2;
+            while(low < high) {
+                int mid= (low + high) / 2;
+                if (values[2 * mid] <= value) {
+                    low= mid + 1;
+                } else {
+                    high= mid;
+                }
+            }
+            return low > 0 && value <= values[2 * (low - 1)] + values[2 * (low - 1) + 1];
+        }
+    }
+}
+
+inline bool RoaringSet::Container::add(uint16_t value) {
+    if (type == RUN) {
+        if (contains(value)) {
+            return false;
+        }
+        normalize();
+    }
+    if (type == ARRAY) {
+        auto it= std::lower_bound(values.begin(), values.end(), value);
+        if (it != values.end() && *it == value) {
+            return false;
+        }
+        if (cardinality < ARRAY_MAX) {
+            values.insert(it, value);
+            cardinality++;
+            return true;
+        }
+        toBitmap();
+    }
+
+    uint64_t mask= uint64_t(1) << (value & 63);
+    if (words[value >> 6] & mask) {
+        return false;
+    }
+    words[value >> 6]|= mask;
+    cardinality++;
+    return true;
+}
+
+inline bool RoaringSet::Container::remove(uint16_t value) {
+    if (!contains(value)) {
+        return false;
+    }
+    if (type == RUN) {
+        normalize();
+    }
+    if (type == ARRAY) {
+        values.erase(std::lower_bound(values.begin(), values.end(), value));
+        cardinality--;
+    } else {
+        words[value >> 6]&= ~(uint64_t(1) << (value & 63));
+        cardinality--;
+        if (cardinality <= ARRAY_MAX) {
+            toArray();
+        }
+    }
+    return true;
+}
+
+template <class Visitor>
+bool RoaringSet::Container::each(Visitor visitor) const {
+    switch(type) {
+        case ARRAY:
+            for(uint16_t value: values) {
+                if (!visitor(value)) {
+                    return false;
+                }
+            }
+            break;
+        case BITMAP:
+            for(int i= 0; i < BITMAP_WORDS; i++) {
+                for(uint64_t word= words[i]; word != 0; word&= word - 1) {
+                    if (!visitor(uint16_t(i * 64 + __builtin_ctzll(word)))) {
+                        return false;
+                    }
+                }
+            }
+            break;
+        default:
+            for(size_t i= 0; i < values.size(); i+= 2) {
+                for(uint32_t value= values[i]; value <= uint32_t(values[i]) + values[i + 1]; value++) {
+                    if (!visitor(uint16_t(value))) {
+                        return false;
+                    }
+                }
+            }
+            break;
+    }
+    return true;
+}
+
+inline vector<uint64_t> RoaringSet::Container::bitmap() const {
+    if (type == BITMAP) {
+        return words;
+    }
+
+    vector<uint64_t> bits(BITMAP_WORDS, 0);
+    each([&bits](uint16_t value) -> bool {
+        bits[value >> 6]|= uint64_t(1) << (value & 63);
+        return true;
+    });
+    return bits;
+}
+
+inline void RoaringSet::Container::normalize() {
+    if (cardinality <= ARRAY_MAX) {
+        toArray();
+    } else {
+        toBitmap();
+    }
+}
+
+inline void RoaringSet::Container::toArray() {
+    if (type != ARRAY) {
+        vector<uint16_t> array;
+
+        array.reserve(cardinality);
+        each([&array](uint16_t value) -> bool {
+            array.push_back(value);
+            return true;
+        });
+        values.swap(array);
+        vector<uint64_t>().swap(words);
+        type= ARRAY;
+    }
+}
+
+inline void RoaringSet::Container::toBitmap() {
+    if (type != BITMAP) {
+        words= bitmap();
+        vector<uint16_t>().swap(values);
+        type= BITMAP;
+    }
+}
+
+inline void RoaringSet::Container::runOptimize() {
+    vector<uint16_t> runs;
+    int previous= -2;
+
+    each([&runs, &previous](uint16_t value) -> bool {
+        if (value == previous + 1) {
+            runs.back()++;
+        } else {
+            runs.push_back(value);
+            runs.push_back(0);
+        }
+        previous= value;
+        return true;
+    });
+
+    size_t runBytes= runs.size() * sizeof(uint16_t);
+    size_t currentBytes= type == ARRAY ? cardinality * sizeof(uint16_t) : BITMAP_WORDS * sizeof(uint64_t);
+    if (type != RUN && runBytes < currentBytes) {
+        runs.shrink_to_fit();
+        values.swap(runs);
+        vector<uint64_t>().swap(words);
+        type= RUN;
+    }
+}
+
+inline MemoryUsage RoaringSet::Container::memoryUsage() const {
+    return MemoryUsage(values.size() * sizeof(uint16_t) + words.size() * sizeof(uint64_t), 
+            (values.capacity() - values.size()) * sizeof(uint16_t) + (words.capacity() - words.size()) * sizeof(uint64_t), 0);
+}
+
+inline RoaringSet::Container RoaringSet::Container::unite(const Container& left, const Container& right) {
+    Container result;
+
+    if (left.type == ARRAY && right.type == ARRAY) {
+        result.values.reserve(left.cardinality + right.cardinality);
+        std::set_union(left.values.begin(), left.values.end(), right.values.begin(), right.values.end(),
+                std::back_inserter(result.values));
+        result.cardinality= result.values.size();
+        if (result.cardinality > ARRAY_MAX) {
+            result.toBitmap();
+        }
+        return result;
+    }
+
+    const Container& other= left.type == BITMAP ? right : left;
+    result.type= BITMAP;
+    result.words= left.type == BITMAP ? left.words : right.bitmap();
+    other.each([&result](uint16_t value) -> bool {
+        result.words[value >> 6]|= uint64_t(1) << (value & 63);
+        return true;
+    });
+    for(uint64_t word: result.words) {
+        result.cardinality+= __builtin_popcountll(word);
+    }
+    result.normalize();
+    return result;
+}
+
+inline RoaringSet::Container RoaringSet::Container::intersect(const Container& left, const Container& right) {
+    Container result;
+
+    if (left.type == ARRAY && right.type == ARRAY) {
+        std::set_intersection(left.values.begin(), left.values.end(), right.values.begin(), right.values.end(),
+                std::back_inserter(result.values));
+    } else if (left.type == ARRAY || right.type == ARRAY) {
+        const Container& array= left.type == ARRAY ? left : right;
+        const Container& other= left.type == ARRAY ? right : left;
+
+        for(uint16_t value: array.values) {
+            if (other.contains(value)) {
+                result.values.push_back(value);
+            }
+        }
+    } else {
+        result.type= BITMAP;
+        result.words= left.bitmap();
+
+        vector<uint64_t> bits(right.bitmap());
+        for(int i= 0; i < BITMAP_WORDS; i++) {
+            result.words[i]&= bits[i];
+            result.cardinality+= __builtin_popcountll(result.words[i]);
+        }
+        result.normalize();
+        return result;
+    }
+    result.cardinality= result.values.size();
+    return result;
+}
+
+inline RoaringSet::RoaringSet() : setSize(0) {
+}
+
+inline RoaringSet::RoaringSet(const RoaringSet& set) : setSize(set.setSize), keys(set.keys), containers(set.containers) {
+}
+
+inline RoaringSet::RoaringSet(initializer_list<uint32_t> elements) : RoaringSet() {
+    for(uint32_t elem: elements) {
+        add(elem);
+    }
+}
+
+inline RoaringSet::~RoaringSet() {
+}
+
+inline RoaringSet* RoaringSet::clone() const {
+    return new RoaringSet(*this);
+}
+
+inline bool RoaringSet::equals(initializer_list<uint32_t> collection) const {
+    RoaringSet copy(collection);
+
+    return equals(&copy);
+}
+
+inline bool RoaringSet::equals(const Collection<uint32_t>* collection) const {
+    return collection->size() == setSize && collection->forAll([this](const uint32_t& elem) -> bool {
+        return this->contains(elem);
+    });
+}
+
+inline int RoaringSet::size() const {
+    return setSize;
+}
+
+inline int RoaringSet::capacity() const {
+    return setSize;
+}
+
+inline bool RoaringSet::isEmpty() const {
+    return setSize == 0;
+}
+
+inline bool RoaringSet::contains(const uint32_t& elem) const {
+    bool found;
+    int index= find(elem >> 16, found);
+
+    return found && containers[index].contains(elem & 0xffff);
+}
+
+inline bool RoaringSet::exists(const function<bool (const uint32_t&)>& predicate) const {
+    for(size_t i= 0; i < keys.size(); i++) {
+        uint32_t high= uint32_t(keys[i]) << 16;
+        bool finished= containers[i].each([high, &predicate](uint16_t value) -> bool {
+            return !predicate(high | value);
+        });
+        if (!finished) {
+            return true;
+        }
+    }
+    return false;
+}
+
+inline bool RoaringSet::forAll(const function<bool (const uint32_t&)>& predicate) const {
+    return !exists([&predicate](const uint32_t& elem) -> bool {
+        return !predicate(elem);
+    });
+}
+
+inline void RoaringSet::each(const function<void (const uint32_t&)>& lambda) const {
+    for(size_t i= 0; i < keys.size(); i++) {
+        uint32_t high= uint32_t(keys[i]) << 16;
+        containers[i].each([high, &lambda](uint16_t value) -> bool {
+            lambda(high | value);
+            return true;
+        });
+    }
+}
+
+inline void RoaringSet::each(const function<void (uint32_t&)>& lambda) {
+    RoaringSet modified;
+
+    static_cast<const RoaringSet*>(this)->each([&modified, &lambda](const uint32_t& elem) -> void {
+        uint32_t value= elem;
+        lambda(value);
+        modified.add(value);
+    });
+    setSize= modified.setSize;
+    keys.swap(modified.keys);
+    containers.swap(modified.containers);
+}
+
+inline bool RoaringSet::remove(const uint32_t& elem) {
+    bool found;
+    int index= find(elem >> 16, found);
+
+    if (!found || !containers[index].remove(elem & 0xffff)) {
+        return false;
+    }
+    if (containers[index].cardinality == 0) {
+        keys.erase(keys.begin() + index);
+        containers.erase(containers.begin() + index);
+    }
+    setSize--;
+    return true;
+}
+
+inline bool RoaringSet::add(const uint32_t& elem) {
+    bool found;
+    int index= find(elem >> 16, found);
+
+    if (!found) {
+        keys.insert(keys.begin() + index, uint16_t(elem >> 16));
+        containers.insert(containers.begin() + index, Container());
+    }
+    if (containers[index].add(elem & 0xffff)) {
+        setSize++;
+        return true;
+    }
+    return false;
+}
+
+inline void RoaringSet::clear() {
+    keys.clear();
+    containers.clear();
+    setSize= 0;
+}
+
+inline void RoaringSet::unionWith(const RoaringSet& set) {
+    vector<uint16_t> newKeys;
+    vector<Container> newContainers;
+    size_t i= 0, j= 0;
+
+    newKeys.reserve(keys.size() + set.keys.size());
+    newContainers.reserve(keys.size() + set.keys.size());
+    while(i < keys.size() || j < set.keys.size()) {
+        if (j >= set.keys.size() || (i < keys.size() && keys[i] < set.keys[j])) {
+            newKeys.push_back(keys[i]);
+            newContainers.push_back(std::move(containers[i]));
+            i++;
+        } else if (i >= keys.size() || set.keys[j] < keys[i]) {
+            newKeys.push_back(set.keys[j]);
+            newContainers.push_back(set.containers[j]);
+            j++;
+        } else {
+            newKeys.push_back(keys[i]);
+            newContainers.push_back(Container::unite(containers[i], set.containers[j]));
+            i++;
+            j++;
+        }
+    }
+    keys.swap(newKeys);
+    containers.swap(newContainers);
+    recount();
+}
+
+inline void RoaringSet::intersectWith(const RoaringSet& set) {
+    vector<uint16_t> newKeys;
+    vector<Container> newContainers;
+    size_t i= 0, j= 0;
+
+    while(i < keys.size() && j < set.keys.size()) {
+        if (keys[i] < set.keys[j]) {
+            i++;
+        } else if (set.keys[j] < keys[i]) {
+            j++;
+        } else {
+            Container result(Container::intersect(containers[i], set.containers[j]));
+            if (result.cardinality > 0) {
+                newKeys.push_back(keys[i]);
+                newContainers.push_back(std::move(result));
+            }
+            i++;
+            j++;
+        }
+    }
+    keys.swap(newKeys);
+    containers.swap(newContainers);
+    recount();
+}
+
+inline void RoaringSet::runOptimize() {
+    for(Container& container: containers) {
+        container.runOptimize();
+    }
+}
+
+inline MemoryUsage RoaringSet::memoryUsage() const {
+    MemoryUsage usage(0, (keys.capacity() - keys.size()) * sizeof(uint16_t) + (containers.capacity() - containers.size()) * sizeof(Container), 
+            keys.size() * sizeof(uint16_t) + containers.size() * sizeof(Container));
+
+    for(const Container& container: containers) {
+        usage+= container.memoryUsage();
+    }
+    return usage;
+}
+
+inline void RoaringSet::serialize(std::ostream& output) const {
+    writeInt(output, MAGIC, 4);
+    writeInt(output, VERSION, 2);
+    writeInt(output, keys.size(), 4);
+    for(size_t i= 0; i < keys.size(); i++) {
+        const Container& container= containers[i];
+
+        writeInt(output, keys[i], 2);
+        writeInt(output, container.type, 1);
+        writeInt(output, container.cardinality, 4);
+        if (container.type == Container::BITMAP) {
+            for(uint64_t word: container.words) {
+                writeInt(output, word, 8);
+            }
+        } else {
+            if (container.type == Container::RUN) {
+                writeInt(output, container.values.size() / 2, 2);
+            }
+            for(uint16_t value: container.values) {
+                writeInt(output, value, 2);
+            }
+        }
+    }
+}
+
+inline void RoaringSet::deserialize(std::istream& input) {
+    if (readInt(input, 4) != MAGIC) {
+        throw runtime_error("Stream does not hold a serialized RoaringSet");
+    }
+    if (readInt(input, 2) != VERSION) {
+        throw runtime_error("Unsupported RoaringSet serialization version");
+    }
+
+    RoaringSet set;
+    uint32_t count= readInt(input, 4);
+    for(uint32_t i= 0; i < count; i++) {
+        Container container;
+        uint16_t key= readInt(input, 2);
+
+        if (!set.keys.empty() && key <= set.keys.back()) {
+            throw runtime_error("RoaringSet partitions are not in ascending order");
+        }
+        container.type= Container::Type(readInt(input, 1));
+        container.cardinality= readInt(input, 4);
+        if (container.cardinality <= 0 || container.cardinality > 65536) {
+            throw runtime_error("Invalid RoaringSet container cardinality");
+        }
+        switch(container.type) {
+            case Container::ARRAY:
+                container.values.resize(container.cardinality);
+                break;
+            case Container::BITMAP:
+                container.words.resize(BITMAP_WORDS);
+                break;
+            case Container::RUN:
+                container.values.resize(2 * readInt(input, 2));
+                break;
+            default:
+                throw runtime_error("Invalid RoaringSet container type");
+        }
+        for(uint64_t& word: container.words) {
+            word= readInt(input, 8);
+        }
+        for(uint16_t& value: container.values) {
+            value= readInt(input, 2);
+        }
+        if (countDecoded(container) != container.cardinality) {
+            throw runtime_error("RoaringSet container cardinality does not match its contents");
+        }
+        set.keys.push_back(key);
+        set.containers.push_back(std::move(container));
+    }
+    set.recount();
+    *this= set;
+}
+
+inline int RoaringSet::find(uint16_t key, bool& found) const {
+    auto it= std::lower_bound(keys.begin(), keys.end(), key);
+
+    found= it != keys.end() && *it == key;
+    return it - keys.begin();
+}
+
+inline void RoaringSet::recount() {
+    setSize= 0;
+    for(const Container& container: containers) {
+        setSize+= container.cardinality;
+    }
+}
+
+inline int RoaringSet::countDecoded(const Container& container) {
+    int count= 0;
+
+    switch(container.type) {
+        case Container::ARRAY:
+            for(size_t i= 1; i < container.values.size(); i++) {
+                if (container.values[i] <= container.values[i - 1]) {
+                    throw runtime_error("RoaringSet array container is not strictly ascending");
+                }
+            }
+            count= container.values.size();
+            break;
+        case Container::BITMAP:
+            for(uint64_t word: container.words) {
+                count+= __builtin_popcountll(word);
+            }
+            break;
+        default:
+            for(size_t i= 0; i < container.values.size(); i+= 2) {
+                uint32_t start= container.values[i], end= start + container.values[i + 1];
+
+                if (end > 0xffff || (i > 0 && start <= uint32_t(container.values[i - 2]) + container.values[i - 1])) {
+                    throw runtime_error("RoaringSet run container has overlapping or out of range runs");
+                }
+                count+= end - start + 1;
+            }
+            break;
+    }
+    if (count == 0) {
+        throw runtime_error("RoaringSet container is empty");
+    }
+    return count;
+}
+
+inline void RoaringSet::writeInt(std::ostream& output, uint64_t value, int bytes) {
+    char buffer[8];
+
+    for(int i= 0; i < bytes; i++) {
+        buffer[i]= char(value >> (8 * i));
+    }
+    output.write(buffer, bytes);
+}
+
+inline uint64_t RoaringSet::readInt(std::istream& input, int bytes) {
+    unsigned char buffer[8];
+    uint64_t value= 0;
+
+    if (!input.read(reinterpret_cast<char*>(buffer), bytes)) {
+        throw runtime_error("Unexpected end of serialized RoaringSet");
+    }
+    for(int i= 0; i < bytes; i++) {
+        value|= uint64_t(buffer[i]) << (8 * i);
+    }
+    return value;
+}
+
+}   //namespace set
+}   //namespace collections
+}   //namespace etsai
+
+#endif
@@ -1,24 +1,66 @@
 #ifndef ETSAI_COLLECTIONS_SET_SORTEDSET_H
 #define ETSAI_COLLECTIONS_SET_SORTEDSET_H
 
+#include "Comparator.h"
 #include "Set.h"
 #include "List/ArrayList.h"
+#include "src/Snapshot.h"
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <string>
 
 namespace etsai {
 namespace collections {
 namespace set {
 
+using std::runtime_error;
+
 /**
  * A sorted set maintains the set in sorted order allowing searches to be 
- * done in logarithmic time.
+ * done in logarithmic time.  The ordering is given by the Compare type, which is 
+ * either a strict weak ordering such as std::less, or a comparator deriving from 
+ * ThreeWayComparator.  Two elements are considered equal if neither is ordered 
+ * before the other.  The Instrumentation policy, NoInstrumentation by default, is 
+ * told about the comparisons made by each search, and is also used by the backing list.
  * @author etsai
  */
-template <class T>
-class SortedSet : public collections::Set<T> {
+template <class T, class Compare, class Instrumentation>
+class SortedSet : public collections::Set<T>, private Instrumentation {
 public:
-    SortedSet();
-    SortedSet(const SortedSet<T> &set);
-    SortedSet(const initializer_list<T> &elements);
+    /**
+     * Gives the SortedSet type holding elements of type U.  Comparators cannot be rebound, so the new set is 
+     * ordered with std::less.
+     */
+    template <class U>
+    struct rebind {
+        typedef SortedSet<U, std::less<U>, Instrumentation> other;
+    };
+
+    /**
+     * Constructs an empty set ordered by the given comparator
+     * @param   compare     Comparator defining the ordering of the set
+     */
+    SortedSet(const Compare& compare= Compare());
+    SortedSet(const SortedSet<T, Compare, Instrumentation> &set);
+    /**
+     * Move constructor.  The moved from set is left empty.
+     */
+    SortedSet(SortedSet<T, Compare, Instrumentation> &&set);
+    /**
+     * Constructs a set containing the elements in the initializer list, ordered by the given comparator
+     * @param   elements    Initial values for the set
+     * @param   compare     Comparator defining the ordering of the set
+     */
+    SortedSet(const initializer_list<T> &elements, const Compare& compare= Compare());
+    /**
+     * Constructs a set from the elements of an unordered list.  The list is sorted and deduplicated once, taking 
+     * O(n log n) time rather than the O(n^2) of adding the elements one at a time.
+     * @param   elements    Elements of the set, in any order.  The list is left empty.
+     * @param   compare     Comparator defining the ordering of the set
+     */
+    SortedSet(list::ArrayList<T, Instrumentation> &&elements, const Compare& compare= Compare());
     ~SortedSet();
 
     virtual SortedSet* clone() const;
@@ -26,6 +68,7 @@ public:
     virtual bool equals(const Collection<T>* collection) const;
     virtual int size() const;
     virtual int capacity() const;
+    virtual MemoryUsage memoryUsage() const;
 
     virtual bool isEmpty() const;
     virtual bool contains(const T& elem) const;
@@ -36,147 +79,454 @@ public:
     virtual void each(const function<void (T&)>& lambda);
     virtual bool remove(const T& elem);
     virtual bool add(const T& elem);
+    virtual bool add(T&& elem);
     virtual void clear();
 
+    /**
+     * Get the index of the first element that is not less than the given element
+     * @param   elem    Element to search for
+     * @return  Index of the first element >= elem, or size() if no such element exists
+     */
+    int lowerBound(const T& elem) const;
+    /**
+     * Get the index of the first element that is greater than the given element
+     * @param   elem    Element to search for
+     * @return  Index of the first element > elem, or size() if no such element exists
+     */
+    int upperBound(const T& elem) const;
+    /**
+     * Get the greatest element that is less than or equal to the given element
+     * @param   elem    Element to search for
+     * @return  Greatest element <= elem
+     * @throws  out_of_range    If every element in the set is greater than elem
+     */
+    T floor(const T& elem) const throw(out_of_range);
+    /**
+     * Get the least element that is greater than or equal to the given element
+     * @param   elem    Element to search for
+     * @return  Least element >= elem
+     * @throws  out_of_range    If every element in the set is less than elem
+     */
+    T ceiling(const T& elem) const throw(out_of_range);
+    /**
+     * Get the smallest element in the set
+     * @return  Smallest element
+     * @throws  out_of_range    If the set is empty
+     */
+    T first() const throw(out_of_range);
+    /**
+     * Get the largest element in the set
+     * @return  Largest element
+     * @throws  out_of_range    If the set is empty
+     */
+    T last() const throw(out_of_range);
+    /**
+     * Counts the number of elements strictly less than the given element
+     * @param   elem    Element to rank
+     * @return  Number of elements < elem
+     */
+    int rank(const T& elem) const;
+    /**
+     * Get the element with the given rank, that is, the element that has exactly k smaller elements in the set
+     * @param   k       Rank of the desired element
+     * @return  Element with rank k
+     * @throws  out_of_range    If k lies outside the range [0, set size - 1]
+     */
+    T select(int k) const throw(out_of_range);
+    /**
+     * Applies the lambda to each element in the half open range [low, high), in ascending order.  Locating the range 
+     * takes logarithmic time and no elements are copied into an intermediate collection.
+     * @param   low     Inclusive lower bound of the range
+     * @param   high    Exclusive upper bound of the range
+     * @param   lambda  Lambda function to evaluate each element with
+     */
+    void range(const T& low, const T& high, const function<void (const T&)>& lambda) const;
+    virtual void accept(Dispatcher<T>& dispatcher) const;
+    /**
+     * Transforms the set from T set -> U set.  Evaluates {f(a0), f(a1), ..., f(an)}.  The transformed values are 
+     * written into a list pre-sized to the set's size, then sorted and deduplicated once, instead of being inserted 
+     * one at a time.
+     * @param   transform   Lambda that maps T -> U
+     * @return  Set of the transformed values
+     */
+    template <class U>
+    typename rebind<U>::other map(const function<U (const T&)>& transform) const;
+
+    /**
+     * Writes the set to a binary snapshot file, in the format used by ArrayList::save.  Only sets of trivially 
+     * copyable types can be saved.
+     * @param   path    Path of the file to write
+     * @throws  runtime_error   If the file cannot be written
+     */
+    void save(const string& path) const;
+    /**
+     * Reads a set from a snapshot file written by save, verifying its checksum and that the elements are in 
+     * ascending order under the comparator
+     * @param   path        Path of the file to read
+     * @param   compare     Comparator defining the ordering of the set, which must match the saved ordering
+     * @return  Set holding the saved elements
+     * @throws  runtime_error   If the file does not hold a valid snapshot of this set type
+     */
+    static SortedSet<T, Compare, Instrumentation> load(const string& path, const Compare& compare= Compare());
+    /**
+     * Maps a snapshot file written by save into memory.  Searches run directly over the mapped pages, so loading 
+     * takes constant time and processes mapping the same file share the page cache.  Neither the checksum nor the 
+     * ordering is checked.  The first modification of the set copies the elements into memory owned by the set.
+     * @param   path        Path of the file to map
+     * @param   compare     Comparator defining the ordering of the set, which must match the saved ordering
+     * @return  Set backed by the mapped file
+     * @throws  runtime_error   If the file cannot be mapped or does not hold a snapshot of this set type
+     */
+    static SortedSet<T, Compare, Instrumentation> loadMapped(const string& path, const Compare& compare= Compare());
+    /**
+     * Returns true if the elements are read from a mapped snapshot file
+     * @return  True if the set is backed by a mapping
+     */
+    bool isMapped() const;
+    /**
+     * Get the operation counts recorded by the instrumentation policy, including those of the backing list
+     * @return  Counters for this set
+     */
+    OperationCounters counters() const;
+
 private:
-    ArrayList<T> elements;
-    int binarySearch(const T& elem) const;
-    inline bool equals(const T& left, const T& right) const;
+    typedef CompareTraits<T, Compare> Traits;
+
+    Compare compare;
+    list::ArrayList<T, Instrumentation> elements;
+    /**
+     * Finds the index of the first element not ordered before the given element.  Each probe uses a single 
+     * comparison; three-way comparators can also stop as soon as the element is found.
+     * @param   elem    Element to search for
+     * @param   found   Set to true if the element at the returned index is equal to elem
+     * @return  Index of the first element >= elem, or size() if no such element exists
+     */
+    int binarySearch(const T& elem, bool& found) const;
+    /**
+     * Sorts the backing list and removes equivalent elements
+     */
+    void sortUnique();
 };  //class SortedSet
 
-template <class T>
-SortedSet<T>::SortedSet() {
+template <class T, class Compare, class Instrumentation>
+SortedSet<T, Compare, Instrumentation>::SortedSet(const Compare& compare) : compare(compare) {
 }
 
-template <class T>
-SortedSet<T>::SortedSet(const SortedSet<T> &set) {
+template <class T, class Compare, class Instrumentation>
+SortedSet<T, Compare, Instrumentation>::SortedSet(const SortedSet<T, Compare, Instrumentation> &set) : compare(set.compare) {
     set.elements.each([this](const T& elem) -> void {
        this-> elements.add(elem);
     });
 }
 
-template <class T>
-SortedSet<T>::SortedSet(const initializer_list<T> &elements) {
+template <class T, class Compare, class Instrumentation>
+SortedSet<T, Compare, Instrumentation>::SortedSet(SortedSet<T, Compare, Instrumentation> &&set) : compare(set.compare), elements(std::move(set.elements)) {
+}
+
+template <class T, class Compare, class Instrumentation>
+SortedSet<T, Compare, Instrumentation>::SortedSet(const initializer_list<T> &elements, const Compare& compare) : compare(compare) {
     for(auto &elem: elements) {
         this->add(elem);
     }
 }
 
-template <class T>
-SortedSet<T>::~SortedSet() {
+template <class T, class Compare, class Instrumentation>
+SortedSet<T, Compare, Instrumentation>::SortedSet(list::ArrayList<T, Instrumentation> &&elements, const Compare& compare) : compare(compare), elements(std::move(elements)) {
+    sortUnique();
 }
 
-template <class T>
-SortedSet<T>* SortedSet<T>::clone() const {
-    return new SortedSet<T>(*this);
+template <class T, class Compare, class Instrumentation>
+SortedSet<T, Compare, Instrumentation>::~SortedSet() {
 }
 
-template <class T>
-bool SortedSet<T>::equals(initializer_list<T> collection) const {
-    SortedSet<T> copy(collection);
+template <class T, class Compare, class Instrumentation>
+SortedSet<T, Compare, Instrumentation>* SortedSet<T, Compare, Instrumentation>::clone() const {
+    return new SortedSet<T, Compare, Instrumentation>(*this);
+}
+
+template <class T, class Compare, class Instrumentation>
+bool SortedSet<T, Compare, Instrumentation>::equals(initializer_list<T> collection) const {
+    int distinct= 0;
 
-    return equals(&copy);
+    for(auto it= collection.begin(); it != collection.end(); it++) {
+        if (!contains(*it)) {
+            return false;
+        }
+        if (std::find_if(collection.begin(), it, [this, it](const T& elem) -> bool {
+            return Traits::equivalent(compare, elem, *it);
+        }) == it) {
+            distinct++;
+        }
+    }
+    return distinct == size();
 }
 
-template <class T>
-bool SortedSet<T>::equals(const Collection<T>* collection) const {
-    return collection->exists([this](const T& elem) -> bool {
-        this->contains(elem);
+template <class T, class Compare, class Instrumentation>
+bool SortedSet<T, Compare, Instrumentation>::equals(const Collection<T>* collection) const {
+    return collection->size() == size() && collection->forAll([this](const T& elem) -> bool {
+        return this->contains(elem);
     });
 }
 
-template <class T>
-int SortedSet<T>::size() const {
+template <class T, class Compare, class Instrumentation>
+int SortedSet<T, Compare, Instrumentation>::size() const {
     return elements.size();
 }
 
-template <class T>
-int SortedSet<T>::capacity() const {
-    return elements.size();
+template <class T, class Compare, class Instrumentation>
+int SortedSet<T, Compare, Instrumentation>::capacity() const {
+    return elements.capacity();
 }
 
-template <class T>
-bool SortedSet<T>::isEmpty() const {
+template <class T, class Compare, class Instrumentation>
+MemoryUsage SortedSet<T, Compare, Instrumentation>::memoryUsage() const {
+    return elements.memoryUsage();
+}
+
+template <class T, class Compare, class Instrumentation>
+bool SortedSet<T, Compare, Instrumentation>::isEmpty() const {
     return elements.isEmpty();
 }
 
-template <class T>
-bool SortedSet<T>::contains(const T& elem) const {
-    int index= binarySearch(elem);
-    return index < elements.size() && equals(elements.get(index), elem);
+template <class T, class Compare, class Instrumentation>
+bool SortedSet<T, Compare, Instrumentation>::contains(const T& elem) const {
+    bool found;
+    binarySearch(elem, found);
+    return found;
 }
 
-template <class T>
-bool SortedSet<T>::exists(const function<bool (const T&)>& predicate) const {
+template <class T, class Compare, class Instrumentation>
+bool SortedSet<T, Compare, Instrumentation>::exists(const function<bool (const T&)>& predicate) const {
     return elements.exists(predicate);
 }
 
-template <class T>
-bool SortedSet<T>::forAll(const function<bool (const T&)>& predicate) const {
+template <class T, class Compare, class Instrumentation>
+bool SortedSet<T, Compare, Instrumentation>::forAll(const function<bool (const T&)>& predicate) const {
     return elements.forAll(predicate);
 }
 
-template <class T>
-void SortedSet<T>::each(const function<void (const T&)>& lambda) const {
+template <class T, class Compare, class Instrumentation>
+void SortedSet<T, Compare, Instrumentation>::each(const function<void (const T&)>& lambda) const {
     elements.each(lambda);
 }
 
-template <class T>
-void SortedSet<T>::each(const function<void (T&)>& lambda) {
+template <class T, class Compare, class Instrumentation>
+void SortedSet<T, Compare, Instrumentation>::each(const function<void (T&)>& lambda) {
     elements.each(lambda);
 }
 
-template <class T>
-bool SortedSet<T>::remove(const T& elem) {
-    int index= binarySearch(elem);
+template <class T, class Compare, class Instrumentation>
+bool SortedSet<T, Compare, Instrumentation>::remove(const T& elem) {
+    bool found;
+    int index= binarySearch(elem, found);
 
-    if (index < elements.size() && equals(elements.get(index), elem)) {
-        elements.remove(index);
+    if (found) {
+        elements.minus(index);
         return true;
     }
     return false;
 }
 
-template <class T>
-bool SortedSet<T>::add(const T& elem) {
-    int index= binarySearch(elem);
+template <class T, class Compare, class Instrumentation>
+bool SortedSet<T, Compare, Instrumentation>::add(const T& elem) {
+    bool found;
+    int index= binarySearch(elem, found);
 
-    if (index < elements.size() && equals(elements.get(index), elem)) {
+    if (found) {
         return false;
     }
     elements.add(index, elem);
     return true;
 }
 
-template <class T>
-void SortedSet<T>::clear() {
+template <class T, class Compare, class Instrumentation>
+bool SortedSet<T, Compare, Instrumentation>::add(T&& elem) {
+    bool found;
+    int index= binarySearch(elem, found);
+
+    if (found) {
+        return false;
+    }
+    elements.add(index, std::move(elem));
+    return true;
+}
+
+template <class T, class Compare, class Instrumentation>
+void SortedSet<T, Compare, Instrumentation>::clear() {
     elements.clear();
 }
 
-template <class T>
-int SortedSet<T>::binarySearch(const T& elem) const {
-    int low, high, mid;
+template <class T, class Compare, class Instrumentation>
+int SortedSet<T, Compare, Instrumentation>::lowerBound(const T& elem) const {
+    bool found;
+    return binarySearch(elem, found);
+}
+
+template <class T, class Compare, class Instrumentation>
+int SortedSet<T, Compare, Instrumentation>::upperBound(const T& elem) const {
+    bool found;
+    int index= binarySearch(elem, found);
+
+    return found ? index + 1 : index;
+}
+
+template <class T, class Compare, class Instrumentation>
+T SortedSet<T, Compare, Instrumentation>::floor(const T& elem) const throw(out_of_range) {
+    int index= upperBound(elem) - 1;
+
+    if (index < 0) {
+        throw out_of_range("No element in the set is less than or equal to the given element");
+    }
+    return elements.at(index);
+}
+
+template <class T, class Compare, class Instrumentation>
+T SortedSet<T, Compare, Instrumentation>::ceiling(const T& elem) const throw(out_of_range) {
+    int index= lowerBound(elem);
+
+    if (index >= elements.size()) {
+        throw out_of_range("No element in the set is greater than or equal to the given element");
+    }
+    return elements.at(index);
+}
+
+template <class T, class Compare, class Instrumentation>
+T SortedSet<T, Compare, Instrumentation>::first() const throw(out_of_range) {
+    return elements.at(0);
+}
+
+template <class T, class Compare, class Instrumentation>
+T SortedSet<T, Compare, Instrumentation>::last() const throw(out_of_range) {
+    return elements.at(elements.size() - 1);
+}
+
+template <class T, class Compare, class Instrumentation>
+int SortedSet<T, Compare, Instrumentation>::rank(const T& elem) const {
+    return lowerBound(elem);
+}
+
+template <class T, class Compare, class Instrumentation>
+T SortedSet<T, Compare, Instrumentation>::select(int k) const throw(out_of_range) {
+    return elements.at(k);
+}
+
+template <class T, class Compare, class Instrumentation>
+void SortedSet<T, Compare, Instrumentation>::range(const T& low, const T& high, const function<void (const T&)>& lambda) const {
+    int end= lowerBound(high);
+
+    for(int i= lowerBound(low); i < end; i++) {
+        lambda(elements.at(i));
+    }
+}
+
+template <class T, class Compare, class Instrumentation>
+void SortedSet<T, Compare, Instrumentation>::accept(Dispatcher<T>& dispatcher) const {
+    dispatcher.dispatch(*this);
+}
+
+template <class T, class Compare, class Instrumentation> template <class U>
+typename SortedSet<T, Compare, Instrumentation>::template rebind<U>::other SortedSet<T, Compare, Instrumentation>::map(const function<U (const T&)>& transform) const {
+    return typename rebind<U>::other(elements.template map<U>(transform));
+}
+
+template <class T, class Compare, class Instrumentation>
+void SortedSet<T, Compare, Instrumentation>::save(const string& path) const {
+    elements.save(path, snapshot::SORTED_SET);
+}
+
+template <class T, class Compare, class Instrumentation>
+SortedSet<T, Compare, Instrumentation> SortedSet<T, Compare, Instrumentation>::load(const string& path, const Compare& compare) {
+    SortedSet<T, Compare, Instrumentation> set(compare);
+    list::ArrayList<T, Instrumentation> mapped(list::ArrayList<T, Instrumentation>::loadMapped(path, snapshot::SORTED_SET, true));
+
+    for(int i= 1; i < mapped.size(); i++) {
+        if (!Traits::less(compare, mapped.at(i - 1), mapped.at(i))) {
+            throw runtime_error("Snapshot " + path + " is not in ascending order");
+        }
+    }
+    mapped.detach();
+    set.elements= std::move(mapped);
+    return set;
+}
+
+template <class T, class Compare, class Instrumentation>
+SortedSet<T, Compare, Instrumentation> SortedSet<T, Compare, Instrumentation>::loadMapped(const string& path, const Compare& compare) {
+    SortedSet<T, Compare, Instrumentation> set(compare);
+
+    set.elements= list::ArrayList<T, Instrumentation>::loadMapped(path, snapshot::SORTED_SET, false);
+    return set;
+}
+
+template <class T, class Compare, class Instrumentation>
+bool SortedSet<T, Compare, Instrumentation>::isMapped() const {
+    return elements.isMapped();
+}
+
+template <class T, class Compare, class Instrumentation>
+OperationCounters SortedSet<T, Compare, Instrumentation>::counters() const {
+    OperationCounters counters= Instrumentation::counters();
+
+    counters+= elements.counters();
+    return counters;
+}
+
+template <class T, class Compare, class Instrumentation>
+int SortedSet<T, Compare, Instrumentation>::binarySearch(const T& elem, bool& found) const {
+    int low, high, mid, comparisons= 0;
 
     low= 0;
     high= elements.size() - 1;
-    mid= 0;
+    found= false;
+
+    if (std::is_base_of<ThreeWayComparator, Compare>::value) {
+        while(low <= high) {
+            mid= (low+high)/2;
+
+            int order= Traits::order(compare, elements.at(mid), elem);
+            comparisons++;
+            if (order < 0) {
+                low= mid + 1;
+            } else if (order > 0) {
+                high= mid - 1;
+            } else {
+                found= true;
+                this->compared(comparisons);
+                return mid;
+            }
+        }
+        this->compared(comparisons);
+        return low;
+    }
 
-    while(low <= high) {
+    high++;
+    while(low < high) {
         mid= (low+high)/2;
-        if (elements.get(mid) < elem) {
+        comparisons++;
+        if (Traits::less(compare, elements.at(mid), elem)) {
             low= mid + 1;
-        } else if (elem < elements.get(mid)) {
-            high= mid - 1;
         } else {
-            return mid;
+            high= mid;
         }
     }
+    found= low < elements.size() && !Traits::less(compare, elem, elements.at(low));
+    this->compared(low < elements.size() ? comparisons + 1 : comparisons);
     return low;
 }
 
-template <class T>
-bool SortedSet<T>::equals(const T& left, const T& right) const {
-    return !(left < right) && !(right < left);
+template <class T, class Compare, class Instrumentation>
+void SortedSet<T, Compare, Instrumentation>::sortUnique() {
+    elements.detach();
+
+    T* begin= elements.elements.get();
+    T* end= begin + elements.listSize;
+
+    std::sort(begin, end, [this](const T& left, const T& right) -> bool {
+        return Traits::less(compare, left, right);
+    });
+    end= std::unique(begin, end, [this](const T& left, const T& right) -> bool {
+        return Traits::equivalent(compare, left, right);
+    });
+    elements.listSize= end - begin;
 }
 
 }   //namespace set
@@ -0,0 +1,157 @@
+#include "Set.h"
+#include "Set/BitSet.h"
+
+#include <climits>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+using namespace etsai::collections;
+using namespace etsai::collections::set;
+using namespace std;
+
+typedef function<void (void)> UnitTest;
+
+#define RESULT_HANDLER(result)\
+    if (result) {\
+        pass++; \
+        cout << "Pass" << endl;\
+    } else {\
+        fail++;\
+        cout << "Failed" << endl;\
+    }
+
+int main(int argc, char **argv) {
+    int pass= 0, fail= 0, index= -1;
+    vector<UnitTest> unitTests;
+
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        shared_ptr<Set<int>> s(new BitSet({0, 1, 2, 3, 4, 5}));
+        index++;
+        cout << "Test " << index << ": Size Test 1= ";
+        RESULT_HANDLER(s->size() == 6);
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        shared_ptr<Set<int>> s(new BitSet(1000));
+        index++;
+        cout << "Test " << index << ": Capacity Test 1= ";
+        RESULT_HANDLER(s->size() == 0 && s->capacity() >= 1000);
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        shared_ptr<Set<int>> s(new BitSet());
+        index++;
+        s->add(500);
+        s->add(3);
+        s->add(64);
+        s->add(63);
+        cout << "Test " << index << ": Add Test 1= ";
+        RESULT_HANDLER(s->equals({3, 63, 64, 500}) && s->toString() == "[3, 63, 64, 500]");
+        cout << s->toString() << endl;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        shared_ptr<Set<int>> s(new BitSet({5, 4, 3, 7, 0, 1, 9, 2, 6, 8}));
+        index++;
+        cout << "Test " << index << ": Duplicates 1= ";
+        RESULT_HANDLER(!s->add(0) && !s->add(9) && s->size() == 10);
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        shared_ptr<Set<int>> s(new BitSet({5, 4, 3, 7, 0, 1, 9, 2, 6, 8}));
+        index++;
+        cout << "Test " << index << ": Contains Test 1= ";
+        RESULT_HANDLER(s->contains(0) && s->contains(9) && !s->contains(-1) && !s->contains(10) && !s->contains(100000));
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        shared_ptr<Set<int>> s(new BitSet({5, 4, 3, 7, 0, 1, 9, 2, 6, 8}));
+        index++;
+        cout << "Test " << index << ": Remove 1= ";
+        RESULT_HANDLER(s->remove(5) && !s->remove(5) && !s->remove(-3) && s->equals({4, 3, 7, 0, 1, 9, 2, 6, 8}));
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        shared_ptr<Set<int>> s(new BitSet({1, 2, 3}));
+        index++;
+        cout << "Test " << index << ": Negative= ";
+        bool exception= false;
+
+        try {
+            s->add(-1);
+        } catch (out_of_range& ex) {
+            exception= true;
+            cout << "Exception! " << ex.what() << endl;
+        }
+        RESULT_HANDLER(exception && s->size() == 3);
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        shared_ptr<Set<int>> s(new BitSet({5, 4, 3, 7, 0, 1, 9, 2, 6, 8}));
+        index++;
+        cout << "Test " << index << ": Clear= ";
+        s->clear();
+        RESULT_HANDLER(s->isEmpty() && !s->contains(5));
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        shared_ptr<Set<int>> s(new BitSet({1, 3, 5}));
+        index++;
+        cout << "Test " << index << ": Each modify= ";
+        s->each([](int& elem) -> void {
+            elem*= 100;
+        });
+        RESULT_HANDLER(s->equals({100, 300, 500}));
+        cout << s->toString() << endl;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        shared_ptr<Set<int>> s(new BitSet({1, 70, 129}));
+        index++;
+        cout << "Test " << index << ": Exists / For All= ";
+        RESULT_HANDLER(s->exists([](const int& elem) -> bool { return elem > 100; }) && 
+                s->forAll([](const int& elem) -> bool { return elem % 2 == 1 || elem == 70; }) &&
+                !s->forAll([](const int& elem) -> bool { return elem < 100; }));
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        BitSet left({1, 2, 3, 300, 1000}), right({3, 4, 300, 2000});
+        index++;
+        cout << "Test " << index << ": Union= ";
+        left.unionWith(right);
+        RESULT_HANDLER(left.equals({1, 2, 3, 4, 300, 1000, 2000}) && left.size() == 7);
+        cout << left.toString() << endl;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        BitSet left({1, 2, 3, 300, 1000}), right({3, 4, 300, 2000});
+        index++;
+        cout << "Test " << index << ": Intersection= ";
+        left.intersectWith(right);
+        RESULT_HANDLER(left.equals({3, 300}) && left.size() == 2);
+        cout << left.toString() << endl;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        BitSet left({1, 2, 3, 300, 1000}), right({3, 4, 300});
+        index++;
+        cout << "Test " << index << ": Difference= ";
+        left.differenceWith(right);
+        RESULT_HANDLER(left.equals({1, 2, 1000}) && left.size() == 3);
+        cout << left.toString() << endl;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        BitSet s({0, 9, 10000});
+        index++;
+        cout << "Test " << index << ": Cloning= ";
+        Collection<int>* copy= s.clone();
+        s.remove(9);
+        RESULT_HANDLER(copy->equals({0, 9, 10000}) && s.equals({0, 10000}));
+        delete copy;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        BitSet s;
+        index++;
+        cout << "Test " << index << ": Largest element= ";
+        bool added= s.add(INT_MAX) && !s.add(INT_MAX);
+        bool found= s.contains(INT_MAX) && !s.contains(INT_MAX - 1) && s.size() == 1 && s.capacity() == INT_MAX;
+        RESULT_HANDLER(added && found && s.remove(INT_MAX) && s.isEmpty());
+    });
+
+    for(UnitTest& test: unitTests) {
+        test();
+    }
+    cout << "Final result: Pass= " << pass << "\tFail=" << fail << endl;
+    return 0;
+}
@@ -0,0 +1,155 @@
+#include "Set.h"
+#include "Set/ConcurrentSortedSet.h"
+
+#include <atomic>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace etsai::collections;
+using namespace etsai::collections::set;
+using namespace std;
+
+typedef function<void (void)> UnitTest;
+
+#define RESULT_HANDLER(result)\
+    if (result) {\
+        pass++; \
+        cout << "Pass" << endl;\
+    } else {\
+        fail++;\
+        cout << "Failed" << endl;\
+    }
+
+int main(int argc, char **argv) {
+    int pass= 0, fail= 0, index= -1;
+    vector<UnitTest> unitTests;
+
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        shared_ptr<Set<int>> s(new ConcurrentSortedSet<int>({5, 3, 7, 0, 1, 9}));
+        index++;
+        cout << "Test " << index << ": Size Test 1= ";
+        RESULT_HANDLER(s->size() == 6);
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        shared_ptr<Set<int>> s(new ConcurrentSortedSet<int>());
+        index++;
+        s->add(5);
+        s->add(3);
+        s->add(7);
+        cout << "Test " << index << ": Add Test 1= ";
+        RESULT_HANDLER(!s->add(3) && s->equals({3, 5, 7}));
+        cout << s->toString() << endl;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        shared_ptr<Set<int>> s(new ConcurrentSortedSet<int>({5, 3, 7, 0, 1, 9}));
+        index++;
+        cout << "Test " << index << ": Remove Test 1= ";
+        RESULT_HANDLER(s->remove(7) && !s->remove(7) && s->equals({0, 1, 3, 5, 9}));
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        shared_ptr<Set<int>> s(new ConcurrentSortedSet<int>({5, 3, 7, 0, 1, 9}));
+        index++;
+        cout << "Test " << index << ": Clear= ";
+        s->clear();
+        RESULT_HANDLER(s->isEmpty() && s->add(1) && s->equals({1}));
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        ConcurrentSortedSet<int> s({1, 2, 3});
+        index++;
+        cout << "Test " << index << ": Snapshot isolation= ";
+        auto before= s.snapshot();
+        s.add(4);
+        s.remove(1);
+        bool unchanged= before->equals({1, 2, 3});
+        RESULT_HANDLER(unchanged && s.equals({2, 3, 4}));
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        ConcurrentSortedSet<int> s({1, 2, 3});
+        index++;
+        cout << "Test " << index << ": Batch update= ";
+        s.update([](SortedSet<int>& version) -> void {
+            for(int i= 10; i < 20; i++) {
+                version.add(i);
+            }
+            version.remove(2);
+        });
+        RESULT_HANDLER(s.size() == 12 && s.contains(15) && !s.contains(2));
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        ConcurrentSortedSet<int> s({0});
+        atomic<bool> done(false);
+        atomic<int> errors(0);
+        vector<thread> readers;
+
+        index++;
+        cout << "Test " << index << ": Concurrent readers= ";
+        for(int i= 0; i < 4; i++) {
+            readers.push_back(thread([&s, &done, &errors]() -> void {
+                while(!done.load()) {
+                    auto version= s.snapshot();
+                    int size= version->size();
+                    if (size == 0 || !version->contains(size - 1) || version->contains(size)) {
+                        errors++;
+                    }
+                }
+            }));
+        }
+        for(int i= 1; i < 500; i++) {
+            s.add(i);
+        }
+        done= true;
+        for(thread& reader: readers) {
+            reader.join();
+        }
+        RESULT_HANDLER(errors.load() == 0 && s.size() == 500);
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        const int WIDTH= 64;
+        ConcurrentSortedSet<int> s;
+        atomic<bool> done(false);
+        atomic<int> errors(0);
+        vector<thread> readers;
+
+        s.update([](SortedSet<int>& version) -> void {
+            for(int i= 0; i < WIDTH; i++) {
+                version.add(i);
+            }
+        });
+        index++;
+        cout << "Test " << index << ": Snapshots held across publishes= ";
+        for(int i= 0; i < 4; i++) {
+            readers.push_back(thread([&s, &done, &errors]() -> void {
+                while(!done.load()) {
+                    auto version= s.snapshot();
+                    for(int j= 0; j < 8; j++) {
+                        int first= version->first();
+                        if (version->size() != WIDTH || version->last() != first + WIDTH - 1 || !version->contains(first + j)) {
+                            errors++;
+                        }
+                        this_thread::yield();
+                    }
+                }
+            }));
+        }
+        for(int i= 1; i <= 2000; i++) {
+            s.update([i](SortedSet<int>& version) -> void {
+                version.remove(i - 1);
+                version.add(i + WIDTH - 1);
+            });
+        }
+        done= true;
+        for(thread& reader: readers) {
+            reader.join();
+        }
+        RESULT_HANDLER(errors.load() == 0 && s.snapshot()->first() == 2000 && s.size() == WIDTH);
+    });
+
+    for(UnitTest& test: unitTests) {
+        test();
+    }
+    cout << "Final result: Pass= " << pass << "\tFail=" << fail << endl;
+    return 0;
+}
@@ -0,0 +1,216 @@
+#include "Set.h"
+#include "Set/RoaringSet.h"
+#include "Set/SortedSet.h"
+
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace etsai::collections;
+using namespace etsai::collections::set;
+using namespace std;
+
+typedef function<void (void)> UnitTest;
+
+#define RESULT_HANDLER(result)\
+    if (result) {\
+        pass++; \
+        cout << "Pass" << endl;\
+    } else {\
+        fail++;\
+        cout << "Failed" << endl;\
+    }
+
+int main(int argc, char **argv) {
+    int pass= 0, fail= 0, index= -1;
+    vector<UnitTest> unitTests;
+
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        shared_ptr<Set<uint32_t>> s(new RoaringSet({0, 1, 2, 3, 4, 5}));
+        index++;
+        cout << "Test " << index << ": Size Test 1= ";
+        RESULT_HANDLER(s->size() == 6);
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        shared_ptr<Set<uint32_t>> s(new RoaringSet());
+        index++;
+        s->add(4000000000u);
+        s->add(70000);
+        s->add(3);
+        s->add(65535);
+        cout << "Test " << index << ": Add Test 1= ";
+        RESULT_HANDLER(!s->add(3) && s->equals({3, 65535, 70000, 4000000000u}) && s->toString() == "[3, 65535, 70000, 4000000000]");
+        cout << s->toString() << endl;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        shared_ptr<Set<uint32_t>> s(new RoaringSet({5, 4, 3, 7, 0, 1, 9, 2, 6, 8, 1u << 20}));
+        index++;
+        cout << "Test " << index << ": Contains Test 1= ";
+        RESULT_HANDLER(s->contains(0) && s->contains(9) && s->contains(1u << 20) && !s->contains(10) && !s->contains((1u << 20) + 1));
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        shared_ptr<Set<uint32_t>> s(new RoaringSet({5, 4, 3, 1u << 20}));
+        index++;
+        cout << "Test " << index << ": Remove 1= ";
+        RESULT_HANDLER(s->remove(1u << 20) && !s->remove(1u << 20) && s->remove(4) && s->equals({5, 3}));
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        RoaringSet s;
+        index++;
+        cout << "Test " << index << ": Dense partition= ";
+        for(uint32_t i= 0; i < 10000; i++) {
+            s.add(i * 3);
+        }
+        bool dense= s.size() == 10000 && s.contains(9999 * 3) && !s.contains(9999 * 3 - 1);
+        for(uint32_t i= 0; i < 10000; i+= 2) {
+            s.remove(i * 3);
+        }
+        RESULT_HANDLER(dense && s.size() == 5000 && s.contains(3) && !s.contains(6));
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        RoaringSet s;
+        index++;
+        cout << "Test " << index << ": Run optimize= ";
+        for(uint32_t i= 100; i < 60000; i++) {
+            s.add(i);
+        }
+        size_t before= s.memoryUsage().total();
+        s.runOptimize();
+        size_t after= s.memoryUsage().total();
+        bool optimized= after < before && s.size() == 59900 && s.contains(100) && s.contains(59999) && !s.contains(60000);
+        s.add(70);
+        s.remove(500);
+        RESULT_HANDLER(optimized && s.size() == 59900 && s.contains(70) && !s.contains(500));
+        cout << before << " -> " << after << " bytes" << endl;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        RoaringSet left({1, 2, 3, 1u << 20, 3u << 20}), right({3, 4, 1u << 20, 5u << 20});
+        index++;
+        cout << "Test " << index << ": Union 1= ";
+        left.unionWith(right);
+        RESULT_HANDLER(left.equals({1, 2, 3, 4, 1u << 20, 3u << 20, 5u << 20}) && left.size() == 7);
+        cout << left.toString() << endl;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        RoaringSet left, right;
+        index++;
+        cout << "Test " << index << ": Union 2= ";
+        for(uint32_t i= 0; i < 6000; i++) {
+            left.add(2 * i);
+            right.add(2 * i + 1);
+        }
+        right.runOptimize();
+        left.unionWith(right);
+        RESULT_HANDLER(left.size() == 12000 && left.contains(11999) && !left.contains(12000));
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        RoaringSet left({1, 2, 3, 1u << 20, 3u << 20}), right({3, 4, 1u << 20, 5u << 20});
+        index++;
+        cout << "Test " << index << ": Intersection 1= ";
+        left.intersectWith(right);
+        RESULT_HANDLER(left.equals({3, 1u << 20}) && left.size() == 2);
+        cout << left.toString() << endl;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        RoaringSet left, right;
+        index++;
+        cout << "Test " << index << ": Intersection 2= ";
+        for(uint32_t i= 0; i < 20000; i++) {
+            left.add(i);
+            if (i % 4 == 0) {
+                right.add(i);
+            }
+        }
+        left.runOptimize();
+        left.intersectWith(right);
+        RESULT_HANDLER(left.size() == 5000 && left.contains(19996) && !left.contains(19997));
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        RoaringSet s, copy;
+        index++;
+        cout << "Test " << index << ": Serialize= ";
+        for(uint32_t i= 0; i < 5000; i++) {
+            s.add(i * 7);
+            s.add((10u << 16) + i);
+        }
+        s.add(4000000000u);
+        s.runOptimize();
+
+        stringstream buffer;
+        s.serialize(buffer);
+        copy.deserialize(buffer);
+        RESULT_HANDLER(copy.equals(&s) && s.equals(&copy));
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        RoaringSet s;
+        index++;
+        cout << "Test " << index << ": Deserialize invalid= ";
+        stringstream buffer("not a roaring set");
+        bool exception= false;
+
+        try {
+            s.deserialize(buffer);
+        } catch (runtime_error& ex) {
+            exception= true;
+            cout << "Exception! " << ex.what() << endl;
+        }
+        RESULT_HANDLER(exception);
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        RoaringSet array({1, 2, 3}), bitmap, runs;
+        stringstream arrayBuffer, bitmapBuffer, runBuffer;
+        index++;
+        cout << "Test " << index << ": Deserialize malformed containers= ";
+        for(uint32_t i= 0; i < 10; i++) {
+            runs.add(i);
+            runs.add(60000 + i);
+        }
+        runs.runOptimize();
+        for(uint32_t i= 0; i < 5000; i++) {
+            bitmap.add(i * 2);
+        }
+        array.serialize(arrayBuffer);
+        bitmap.serialize(bitmapBuffer);
+        runs.serialize(runBuffer);
+
+        auto rejects= [](string bytes, size_t offset, char value) -> bool {
+            RoaringSet s({7});
+            bytes[offset]= value;
+            stringstream buffer(bytes);
+            try {
+                s.deserialize(buffer);
+            } catch (runtime_error& ex) {
+                return s.size() == 1 && s.contains(7);
+            }
+            return false;
+        };
+        bool duplicate= rejects(arrayBuffer.str(), 19, 1), unsorted= rejects(arrayBuffer.str(), 21, 0);
+        bool miscounted= rejects(bitmapBuffer.str(), 13, 1), overlapping= rejects(runBuffer.str(), 22, -1);
+        bool outOfRange= rejects(runBuffer.str(), 26, -1);
+        RESULT_HANDLER(duplicate && unsorted && miscounted && overlapping && outOfRange);
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        RoaringSet roaring;
+        SortedSet<uint32_t> sorted;
+        index++;
+        cout << "Test " << index << ": Memory usage= ";
+        for(uint32_t i= 0; i < 100000; i++) {
+            roaring.add(i * 2);
+            sorted.add(i * 2);
+        }
+        RESULT_HANDLER(roaring.memoryUsage().total() < sorted.memoryUsage().total() && 
+                sorted.memoryUsage().payload == sorted.size() * sizeof(uint32_t));
+        cout << roaring.memoryUsage().total() << " bytes" << endl;
+    });
+
+    for(UnitTest& test: unitTests) {
+        test();
+    }
+    cout << "Final result: Pass= " << pass << "\tFail=" << fail << endl;
+    return 0;
+}
@@ -1,13 +1,53 @@
 #include "Set.h"
 #include "Set/SortedSet.h"
+#include "test/AllocationCounter.h"
 
+#include <cctype>
+#include <functional>
 #include <iostream>
 #include <memory>
+#include <string>
 #include <vector>
 
 using namespace etsai::collections;
 using namespace etsai::collections::set;
 using namespace std;
+using etsai::collections::test::AllocationCounter;
+
+struct CaseInsensitiveCompare : public ThreeWayComparator {
+    int operator()(const string& left, const string& right) const {
+        size_t length= left.size() < right.size() ? left.size() : right.size();
+        for(size_t i= 0; i < length; i++) {
+            int diff= tolower(left[i]) - tolower(right[i]);
+            if (diff != 0) {
+                return diff;
+            }
+        }
+        return (int) left.size() - (int) right.size();
+    }
+};
+
+struct CountingLess {
+    CountingLess(int* count) : count(count) {
+    }
+    bool operator()(const int& left, const int& right) const {
+        (*count)++;
+        return left < right;
+    }
+
+    int* count;
+};
+
+struct CountingThreeWay : public ThreeWayComparator {
+    CountingThreeWay(int* count) : count(count) {
+    }
+    int operator()(const int& left, const int& right) const {
+        (*count)++;
+        return left < right ? -1 : (right < left ? 1 : 0);
+    }
+
+    int* count;
+};
 
 typedef function<void (void)> UnitTest;
 
@@ -183,6 +223,232 @@ int main(int argc, char **argv) {
         s->add(10);
         RESULT_HANDLER(s->size() == 11);
     });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        shared_ptr<SortedSet<int>> s(new SortedSet<int>({10, 20, 30, 40, 50}));
+        index++;
+        cout << "Test " << index << ": Bounds 1= ";
+        RESULT_HANDLER(s->lowerBound(20) == 1 && s->upperBound(20) == 2 && s->lowerBound(25) == 2 && s->upperBound(25) == 2);
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        shared_ptr<SortedSet<int>> s(new SortedSet<int>({10, 20, 30, 40, 50}));
+        index++;
+        cout << "Test " << index << ": Bounds 2= ";
+        RESULT_HANDLER(s->lowerBound(5) == 0 && s->upperBound(50) == 5 && s->lowerBound(60) == 5);
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        shared_ptr<SortedSet<int>> s(new SortedSet<int>({10, 20, 30, 40, 50}));
+        index++;
+        cout << "Test " << index << ": Floor / Ceiling 1= ";
+        RESULT_HANDLER(s->floor(25) == 20 && s->floor(30) == 30 && s->ceiling(25) == 30 && s->ceiling(30) == 30);
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        shared_ptr<SortedSet<int>> s(new SortedSet<int>({10, 20, 30, 40, 50}));
+        index++;
+        cout << "Test " << index << ": Floor / Ceiling 2= ";
+        bool floorException= false, ceilingException= false;
+
+        try {
+            s->floor(5);
+        } catch (out_of_range& ex) {
+            floorException= true;
+            cout << "Exception! " << ex.what() << endl;
+        }
+        try {
+            s->ceiling(55);
+        } catch (out_of_range& ex) {
+            ceilingException= true;
+            cout << "Exception! " << ex.what() << endl;
+        }
+        RESULT_HANDLER(floorException && ceilingException);
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        shared_ptr<SortedSet<int>> s(new SortedSet<int>({5, 4, 3, 7, 0, 1, 9, 2, 6, 8}));
+        index++;
+        cout << "Test " << index << ": First / Last= ";
+        RESULT_HANDLER(s->first() == 0 && s->last() == 9);
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        shared_ptr<SortedSet<int>> s(new SortedSet<int>({10, 20, 30, 40, 50}));
+        index++;
+        cout << "Test " << index << ": Rank / Select= ";
+        RESULT_HANDLER(s->rank(10) == 0 && s->rank(35) == 3 && s->rank(100) == 5 && s->select(3) == 40 && s->select(s->rank(20)) == 20);
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        shared_ptr<SortedSet<int>> s(new SortedSet<int>({5, 4, 3, 7, 0, 1, 9, 2, 6, 8}));
+        index++;
+        cout << "Test " << index << ": Range 1= ";
+        vector<int> visited;
+        s->range(3, 7, [&visited](const int& elem) -> void {
+            visited.push_back(elem);
+        });
+        RESULT_HANDLER(visited == vector<int>({3, 4, 5, 6}));
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        shared_ptr<SortedSet<int>> s(new SortedSet<int>({10, 20, 30, 40, 50}));
+        index++;
+        cout << "Test " << index << ": Range 2= ";
+        int count= 0;
+        s->range(21, 29, [&count](const int& elem) -> void {
+            count++;
+        });
+        s->range(40, 10, [&count](const int& elem) -> void {
+            count++;
+        });
+        RESULT_HANDLER(count == 0);
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        shared_ptr<SortedSet<int, greater<int>>> s(new SortedSet<int, greater<int>>({5, 3, 7, 0, 9}));
+        index++;
+        cout << "Test " << index << ": Comparator descending= ";
+        RESULT_HANDLER(s->toString() == "[9, 7, 5, 3, 0]" && s->contains(3) && !s->contains(4) && s->first() == 9);
+        cout << s->toString() << endl;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        shared_ptr<SortedSet<string, CaseInsensitiveCompare>> s(new SortedSet<string, CaseInsensitiveCompare>({"banana", "Apple", "cherry"}));
+        index++;
+        cout << "Test " << index << ": Comparator three-way= ";
+        RESULT_HANDLER(!s->add("APPLE") && s->contains("BANANA") && s->remove("Cherry") && s->size() == 2 && s->first() == "Apple");
+        cout << s->toString() << endl;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        int count= 0;
+        SortedSet<int, CountingLess> s((CountingLess(&count)));
+        for(int i= 0; i < 1024; i++) {
+            s.add(i);
+        }
+        index++;
+        cout << "Test " << index << ": Comparator probes 1= ";
+        count= 0;
+        bool found= s.contains(517);
+        RESULT_HANDLER(found && count <= 11);
+        cout << count << " comparisons" << endl;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        int count= 0;
+        SortedSet<int, CountingThreeWay> s((CountingThreeWay(&count)));
+        for(int i= 0; i < 1024; i++) {
+            s.add(i);
+        }
+        index++;
+        cout << "Test " << index << ": Comparator probes 2= ";
+        count= 0;
+        bool found= s.contains(517) && !s.contains(2048);
+        RESULT_HANDLER(found && count <= 22);
+        cout << count << " comparisons" << endl;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        shared_ptr<Set<int>> s(new SortedSet<int>({5, 4, 3, -3, -4}));
+        index++;
+        cout << "Test " << index << ": Map 1= ";
+        Collection<int> *m= s->map<int>([](const int& elem) -> int {
+            return elem * elem;
+        });
+        RESULT_HANDLER(dynamic_cast<SortedSet<int>*>(m) != NULL && m->toString() == "[9, 16, 25]");
+        cout << m->toString() << endl;
+        delete m;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        SortedSet<int, greater<int>> s({1, 2, 3, 12});
+        index++;
+        cout << "Test " << index << ": Map 2= ";
+        SortedSet<string> m= s.map<string>([](const int& elem) -> string {
+            return to_string(elem);
+        });
+        RESULT_HANDLER(m.toString() == "[1, 12, 2, 3]" && m.contains("12"));
+        cout << m.toString() << endl;
+    });
+
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        SortedSet<int> s({5, 3, 8, 1, 9, 2});
+        index++;
+        cout << "Test " << index << ": View 1= ";
+        SortedSet<int, greater<int>> m= s.view().map([](const int& elem) -> int {
+            return elem / 2;
+        }).toSortedSet(greater<int>());
+        SortedSet<int> n= s.view().filter([](const int& elem) -> bool {
+            return elem > 2;
+        }).toSortedSet();
+        RESULT_HANDLER(m.toString() == "[4, 2, 1, 0]" && n.toString() == "[3, 5, 8, 9]");
+        cout << m.toString() << endl;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        SortedSet<string> s({"b", "d"});
+        string c("c"), d("d");
+        index++;
+        cout << "Test " << index << ": Move 1= ";
+        bool added= s.add(std::move(c));
+        bool duplicate= s.add(std::move(d));
+        RESULT_HANDLER(added && c.empty() && !duplicate && s.toString() == "[b, c, d]" && s.emplace(3, 'a') && s.first() == "aaa");
+        cout << s.toString() << endl;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        const char* path= "SortedSetTest.snapshot";
+        SortedSet<int> s({40, 10, 30, 20, 50});
+        bool outOfOrder= false;
+        index++;
+        cout << "Test " << index << ": Snapshot 1= ";
+        s.save(path);
+        SortedSet<int> loaded= SortedSet<int>::load(path);
+        SortedSet<int> mapped= SortedSet<int>::loadMapped(path);
+        bool searched= mapped.isMapped() && mapped.contains(30) && !mapped.contains(35) && mapped.lowerBound(35) == 3 && 
+                mapped.floor(49) == 40;
+        try {
+            SortedSet<int, greater<int>>::load(path, greater<int>());
+        } catch (runtime_error& ex) {
+            outOfOrder= true;
+        }
+        mapped.add(35);
+        RESULT_HANDLER(searched && outOfOrder && loaded.equals(&s) && !loaded.isMapped() && !mapped.isMapped() && 
+                mapped.toString() == "[10, 20, 30, 35, 40, 50]" && SortedSet<int>::loadMapped(path).equals(&s));
+        cout << mapped.toString() << endl;
+        remove(path);
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        SortedSet<int, less<int>, CountingInstrumentation> s;
+        unsigned long before;
+        index++;
+        cout << "Test " << index << ": Counters= ";
+        for(int i= 0; i < 1024; i++) {
+            s.add(i);
+        }
+        before= s.counters().comparisons;
+        s.contains(500);
+        OperationCounters counters= s.counters();
+        RESULT_HANDLER(counters.comparisons - before == 11 && counters.reallocations > 0 && counters.shiftedElements == 0 && 
+                SortedSet<int>({1, 2, 3}).counters().comparisons == 0);
+        cout << counters.comparisons - before << " " << counters.reallocations << endl;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        SortedSet<int> s;
+        SortedSet<string, CaseInsensitiveCompare> words({"b", "A", "c"});
+        initializer_list<int> same= {3, 1, 2, 3, 1}, different= {1, 2, 4};
+        initializer_list<string> mixed= {"a", "B", "C", "b"};
+        index++;
+        cout << "Test " << index << ": Allocations= ";
+        AllocationCounter adds;
+        for(int i= 0; i < 20; i++) {
+            s.add(19 - i);
+        }
+        long added= adds.count();
+        SortedSet<int> small({1, 2, 3});
+        AllocationCounter reads;
+        bool found= s.contains(7) && !s.contains(20) && s.floor(30) == 19;
+        bool equal= small.equals(same) && !small.equals(different) && words.equals(mixed);
+        RESULT_HANDLER(added == 4 && reads.count() == 0 && found && equal);
+        cout << added << " " << reads.count() << endl;
+    });
+    unitTests.push_back([&pass, &fail, &index]() -> void {
+        SortedSet<int> s;
+        MemoryUsage usage;
+        index++;
+        cout << "Test " << index << ": Memory usage= ";
+        for(int i= 0; i < 10; i++) {
+            s.add(i);
+        }
+        usage= s.memoryUsage();
+        RESULT_HANDLER(s.capacity() == 13 && usage.payload == 10 * sizeof(int) && usage.slack == 3 * sizeof(int));
+        cout << s.capacity() << " " << usage.total() << endl;
+    });
     for(UnitTest& test: unitTests) {
         test();
     }
@@ -0,0 +1,415 @@
+#ifndef ETSAI_COLLECTIONS_VIEW_H
+#define ETSAI_COLLECTIONS_VIEW_H
+
+#include "Forward.h"
+
+#include <functional>
+#include <type_traits>
+#include <memory>
+#include <utility>
+
+namespace etsai {
+namespace collections {
+
+/**
+ * The stages a view pipeline is built from.  Each stage wraps the stage before it and pushes elements into a
+ * sink, which is any callable taking a const reference to an element and returning false once it does not want
+ * any more elements.  Stages are composed by type, so a whole pipeline is compiled into one loop over the source
+ * collection.
+ */
+namespace view {
+
+/**
+ * First stage of a pipeline, pushing the elements of a collection.  The collection is walked with exists so
+ * a sink refusing more elements stops the walk.
+ * @author etsai
+ */
+template <class T>
+class Source {
+public:
+    typedef T value_type;
+
+    explicit Source(const Collection<T>* collection) : collection(collection) {
+    }
+
+    template <class Sink>
+    void run(Sink& sink) const {
+        collection->exists([&sink](const T& elem) -> bool {
+            return !sink(elem);
+        });
+    }
+
+private:
+    const Collection<T>* collection;
+};
+
+/**
+ * Only passes on the elements satisfying a predicate
+ * @author etsai
+ */
+template <class Upstream, class Predicate>
+class Filter {
+public:
+    typedef typename Upstream::value_type value_type;
+
+    Filter(const Upstream& upstream, const Predicate& predicate) : upstream(upstream), predicate(predicate) {
+    }
+
+    template <class Sink>
+    void run(Sink& sink) const {
+        Stage<Sink> stage= {&predicate, &sink};
+        upstream.run(stage);
+    }
+
+private:
+    template <class Sink>
+    struct Stage {
+        const Predicate* predicate;
+        Sink* sink;
+
+        bool operator()(const value_type& elem) {
+            return !(*predicate)(elem) || (*sink)(elem);
+        }
+    };
+
+    Upstream upstream;
+    Predicate predicate;
+};
+
+/**
+ * Passes on the transformed value of each element.  The value is handed to the next stage as a temporary and
+ * is never stored.
+ * @author etsai
+ */
+template <class Upstream, class Transform>
+class Map {
+public:
+    typedef typename std::decay<typename std::result_of<const Transform(const typename Upstream::value_type&)>::type>::type value_type;
+
+    Map(const Upstream& upstream, const Transform& transform) : upstream(upstream), transform(transform) {
+    }
+
+    template <class Sink>
+    void run(Sink& sink) const {
+        Stage<Sink> stage= {&transform, &sink};
+        upstream.run(stage);
+    }
+
+private:
+    template <class Sink>
+    struct Stage {
+        const Transform* transform;
+        Sink* sink;
+
+        bool operator()(const typename Upstream::value_type& elem) {
+            return (*sink)((*transform)(elem));
+        }
+    };
+
+    Upstream upstream;
+    Transform transform;
+};
+
+/**
+ * Passes on at most the given number of elements, then stops the pipeline
+ * @author etsai
+ */
+template <class Upstream>
+class Take {
+public:
+    typedef typename Upstream::value_type value_type;
+
+    Take(const Upstream& upstream, int count) : upstream(upstream), count(count) {
+    }
+
+    template <class Sink>
+    void run(Sink& sink) const {
+        if (count > 0) {
+            Stage<Sink> stage= {count, &sink};
+            upstream.run(stage);
+        }
+    }
+
+private:
+    template <class Sink>
+    struct Stage {
+        int remaining;
+        Sink* sink;
+
+        bool operator()(const value_type& elem) {
+            remaining--;
+            return (*sink)(elem) && remaining > 0;
+        }
+    };
+
+    Upstream upstream;
+    int count;
+};
+
+/**
+ * Pairs each element with the element at the same index of a list, stopping when either side runs out.  The list
+ * is stepped through with its cursor as elements arrive, so it is read lazily and only as far as the pipeline
+ * goes.
+ * @author etsai
+ */
+template <class Upstream, class U>
+class Zip {
+public:
+    typedef std::pair<typename Upstream::value_type, U> value_type;
+
+    Zip(const Upstream& upstream, const List<U>* list) : upstream(upstream), list(list) {
+    }
+
+    template <class Sink>
+    void run(Sink& sink) const {
+        std::unique_ptr<typename List<U>::Cursor> cursor(list->cursor());
+        const U* first= cursor->next();
+
+        if (first != NULL) {
+            Stage<Sink> stage= {cursor.get(), first, &sink};
+            upstream.run(stage);
+        }
+    }
+
+private:
+    template <class Sink>
+    struct Stage {
+        typename List<U>::Cursor* cursor;
+        const U* current;
+        Sink* sink;
+
+        bool operator()(const typename Upstream::value_type& elem) {
+            value_type zipped(elem, *current);
+
+            if (!(*sink)(zipped)) {
+                return false;
+            }
+            current= cursor->next();
+            return current != NULL;
+        }
+    };
+
+    Upstream upstream;
+    const List<U>* list;
+};
+
+}   //namespace view
+
+/**
+ * A lazy view over a collection.  Filters, transforms, truncations, and zips are recorded without touching the
+ * collection and are fused into a single pass when the view is evaluated, so no intermediate collections are
+ * created.  Evaluation stops as soon as the result is known, for example once take has seen enough elements.  A
+ * view only holds a pointer to its collection, which must outlive it and must not be modified while the view is
+ * being evaluated.  Views are obtained from Collection::view.
+ * @author etsai
+ */
+template <class T, class Pipeline= view::Source<T>>
+class View {
+public:
+    /**
+     * Constructs a view evaluating the given pipeline
+     * @param   pipeline    Stages producing the elements of the view
+     */
+    explicit View(const Pipeline& pipeline);
+
+    /**
+     * Keeps only the elements that satisfy the predicate
+     * @param   predicate   Callable that maps T -> bool
+     * @return  View of the elements satisfying the predicate
+     */
+    template <class Predicate>
+    View<T, view::Filter<Pipeline, Predicate>> filter(const Predicate& predicate) const;
+    /**
+     * Transforms each element.  Evaluates [f(a0), f(a1), ..., f(an)] as the view is consumed.
+     * @param   transform   Callable that maps T -> U
+     * @return  View of the transformed elements
+     */
+    template <class Transform>
+    View<typename view::Map<Pipeline, Transform>::value_type, view::Map<Pipeline, Transform>> map(const Transform& transform) const;
+    /**
+     * Keeps at most the first count elements.  Elements past the count are never evaluated.
+     * @param   count   Maximum number of elements to keep
+     * @return  View of the first count elements
+     */
+    View<T, view::Take<Pipeline>> take(int count) const;
+    /**
+     * Pairs the i-th element of the view with the i-th element of the list.  The view ends with the shorter of
+     * the two.  The list must outlive the view.
+     * @param   list    List to pair elements with
+     * @return  View of the paired elements
+     */
+    template <class U>
+    View<std::pair<T, U>, view::Zip<Pipeline, U>> zip(const List<U>& list) const;
+
+    /**
+     * Applies the lambda to each element of the view
+     * @param   lambda      Callable to evaluate each element with
+     */
+    template <class Lambda>
+    void each(const Lambda& lambda) const;
+    /**
+     * Checks if at least one element satisfies the predicate, stopping at the first one that does
+     * @param   predicate   Callable that maps T -> bool
+     * @return  True if at least one element satisfies the predicate
+     */
+    template <class Predicate>
+    bool exists(const Predicate& predicate) const;
+    /**
+     * Checks if all elements satisfy the predicate, stopping at the first one that does not
+     * @param   predicate   Callable that maps T -> bool
+     * @return  True if all elements satisfy the predicate
+     */
+    template <class Predicate>
+    bool forAll(const Predicate& predicate) const;
+    /**
+     * Counts the elements of the view
+     * @return  Number of elements
+     */
+    int count() const;
+
+    /**
+     * Adds every element of the view to the collection
+     * @param   collection  Collection to add the elements to
+     */
+    void collect(Collection<T>& collection) const;
+    /**
+     * Evaluates the view into a new ArrayList
+     * @return  List of the elements, in view order
+     */
+    list::ArrayList<T> toArrayList() const;
+    /**
+     * Evaluates the view into a new CircularLinkedList
+     * @return  List of the elements, in view order
+     */
+    list::CircularLinkedList<T> toCircularLinkedList() const;
+    /**
+     * Evaluates the view into a new SortedSet ordered with std::less.  The elements are gathered into a list and
+     * sorted once, instead of being inserted one at a time.
+     * @return  Set of the elements
+     */
+    set::SortedSet<T, std::less<T>> toSortedSet() const;
+    /**
+     * Evaluates the view into a new SortedSet ordered by the given comparator
+     * @param   compare     Comparator defining the ordering of the set
+     * @return  Set of the elements
+     */
+    template <class Compare>
+    set::SortedSet<T, Compare> toSortedSet(const Compare& compare) const;
+
+private:
+    template <class Lambda>
+    struct EachSink {
+        const Lambda* lambda;
+
+        bool operator()(const T& elem) {
+            (*lambda)(elem);
+            return true;
+        }
+    };
+    template <class Predicate>
+    struct ExistsSink {
+        const Predicate* predicate;
+        bool found;
+
+        bool operator()(const T& elem) {
+            found= (*predicate)(elem);
+            return !found;
+        }
+    };
+
+    Pipeline pipeline;
+};
+
+template <class T, class Pipeline>
+View<T, Pipeline>::View(const Pipeline& pipeline) : pipeline(pipeline) {
+}
+
+template <class T, class Pipeline> template <class Predicate>
+View<T, view::Filter<Pipeline, Predicate>> View<T, Pipeline>::filter(const Predicate& predicate) const {
+    return View<T, view::Filter<Pipeline, Predicate>>(view::Filter<Pipeline, Predicate>(pipeline, predicate));
+}
+
+template <class T, class Pipeline> template <class Transform>
+View<typename view::Map<Pipeline, Transform>::value_type, view::Map<Pipeline, Transform>> View<T, Pipeline>::map(const Transform& transform) const {
+    typedef view::Map<Pipeline, Transform> Stage;
+
+    return View<typename Stage::value_type, Stage>(Stage(pipeline, transform));
+}
+
+template <class T, class Pipeline>
+View<T, view::Take<Pipeline>> View<T, Pipeline>::take(int count) const {
+    return View<T, view::Take<Pipeline>>(view::Take<Pipeline>(pipeline, count));
+}
+
+template <class T, class Pipeline> template <class U>
+View<std::pair<T, U>, view::Zip<Pipeline, U>> View<T, Pipeline>::zip(const List<U>& list) const {
+    return View<std::pair<T, U>, view::Zip<Pipeline, U>>(view::Zip<Pipeline, U>(pipeline, &list));
+}
+
+template <class T, class Pipeline> template <class Lambda>
+void View<T, Pipeline>::each(const Lambda& lambda) const {
+    EachSink<Lambda> sink= {&lambda};
+    pipeline.run(sink);
+}
+
+template <class T, class Pipeline> template <class Predicate>
+bool View<T, Pipeline>::exists(const Predicate& predicate) const {
+    ExistsSink<Predicate> sink= {&predicate, false};
+    pipeline.run(sink);
+    return sink.found;
+}
+
+template <class T, class Pipeline> template <class Predicate>
+bool View<T, Pipeline>::forAll(const Predicate& predicate) const {
+    return !exists([&predicate](const T& elem) -> bool {
+        return !predicate(elem);
+    });
+}
+
+template <class T, class Pipeline>
+int View<T, Pipeline>::count() const {
+    int elements= 0;
+
+    each([&elements](const T&) -> void {
+        elements++;
+    });
+    return elements;
+}
+
+template <class T, class Pipeline>
+void View<T, Pipeline>::collect(Collection<T>& collection) const {
+    each([&collection](const T& elem) -> void {
+        collection.add(elem);
+    });
+}
+
+template <class T, class Pipeline>
+list::ArrayList<T> View<T, Pipeline>::toArrayList() const {
+    list::ArrayList<T> elements;
+
+    collect(elements);
+    return elements;
+}
+
+template <class T, class Pipeline>
+list::CircularLinkedList<T> View<T, Pipeline>::toCircularLinkedList() const {
+    list::CircularLinkedList<T> elements;
+
+    collect(elements);
+    return elements;
+}
+
+template <class T, class Pipeline>
+set::SortedSet<T, std::less<T>> View<T, Pipeline>::toSortedSet() const {
+    return toSortedSet(std::less<T>());
+}
+
+template <class T, class Pipeline> template <class Compare>
+set::SortedSet<T, Compare> View<T, Pipeline>::toSortedSet(const Compare& compare) const {
+    return set::SortedSet<T, Compare>(toArrayList(), compare);
+}
+
+}   //namespace collections
+}   //namespace etsai
+
+#endif
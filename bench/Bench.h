@@ -0,0 +1,239 @@
+#ifndef ETSAI_COLLECTIONS_BENCH_BENCH_H
+#define ETSAI_COLLECTIONS_BENCH_BENCH_H
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+/**
+ * Shared pieces of the benchmark programs: element types, a deterministic random generator, timing loops, and a
+ * JSON reporter.
+ */
+namespace bench {
+
+using std::ostream;
+using std::string;
+
+typedef std::chrono::steady_clock Clock;
+
+/**
+ * Integer that owns its value on the heap, so every copy allocates.  Same as the Integer class of the tests.
+ * @author etsai
+ */
+class Integer {
+public:
+    Integer() : Integer(0) {
+    }
+    Integer(const Integer& r) : Integer(*(r.ptr)) {
+    }
+    Integer(int value) {
+        ptr= new int(value);
+    }
+    ~Integer() {
+        delete ptr;
+        ptr= NULL;
+    }
+    int get() const {
+        return *ptr;
+    }
+    Integer& operator= (const Integer& r) {
+        if (this != &r) {
+            delete ptr;
+            ptr= new int(*(r.ptr));
+        }
+        return *this;
+    };
+    bool operator== (const Integer& r) const {
+        return *ptr == *(r.ptr);
+    }
+    bool operator< (const Integer& r) const {
+        return *ptr < *(r.ptr);
+    }
+
+private:
+    int* ptr;
+};
+
+inline ostream& operator <<(ostream& os, const Integer& obj) {
+    return os << obj.get();
+}
+
+/**
+ * Describes how the benchmarks create and read an element type.  Each type gives its name in the output, builds
+ * the i-th distinct element, and reduces an element to an int so results can be summed.
+ */
+template <class T>
+struct Element;
+
+template <>
+struct Element<int> {
+    static const char* name() {
+        return "int";
+    }
+    static int make(int i) {
+        return i;
+    }
+    static int key(const int& elem) {
+        return elem;
+    }
+};
+
+template <>
+struct Element<string> {
+    static const char* name() {
+        return "string";
+    }
+    /**
+     * Numbers are zero padded so strings sort in the same order as the numbers they are made from
+     */
+    static string make(int i) {
+        std::stringstream value;
+
+        value << "e" << std::setw(9) << std::setfill('0') << i;
+        return value.str();
+    }
+    static int key(const string& elem) {
+        return elem.size();
+    }
+};
+
+template <>
+struct Element<Integer> {
+    static const char* name() {
+        return "Integer";
+    }
+    static Integer make(int i) {
+        return Integer(i);
+    }
+    static int key(const Integer& elem) {
+        return elem.get();
+    }
+};
+
+/**
+ * Xorshift generator with a fixed seed, so every run probes the same positions
+ * @author etsai
+ */
+class Random {
+public:
+    Random() : state(0x2545f4914f6cdd1dULL) {
+    }
+
+    /**
+     * Get a number in [0, bound)
+     */
+    int next(int bound) {
+        state^= state << 13;
+        state^= state >> 7;
+        state^= state << 17;
+        return state % bound;
+    }
+
+private:
+    std::uint64_t state;
+};
+
+/**
+ * Times up to count calls of a per operation lambda, stopping early once the time budget is spent.  The clock is
+ * read once per batch of calls so reading it does not dominate cheap operations.
+ * @param   count       Maximum number of operations
+ * @param   budgetMs    Time after which no more batches are started, in milliseconds
+ * @param   lambda      Callable taking the index of the operation
+ * @param   done        Set to the number of operations run
+ * @return  Average time per operation in nanoseconds
+ */
+template <class Lambda>
+double perOperation(int count, double budgetMs, const Lambda& lambda, int& done) {
+    const int BATCH= 16;
+    Clock::time_point start= Clock::now();
+    double elapsed= 0;
+
+    done= 0;
+    while(done < count && elapsed < budgetMs * 1e6) {
+        int end= done + BATCH < count ? done + BATCH : count;
+
+        for(; done < end; done++) {
+            lambda(done);
+        }
+        elapsed= std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    }
+    return elapsed / done;
+}
+
+/**
+ * Repeats a lambda over the whole container until the time budget is spent, running it at least once
+ * @param   elements    Number of elements the lambda visits
+ * @param   budgetMs    Time after which no more runs are started, in milliseconds
+ * @param   lambda      Callable making one pass over the container
+ * @param   runs        Set to the number of runs
+ * @return  Average time per element in nanoseconds
+ */
+template <class Lambda>
+double perElement(int elements, double budgetMs, const Lambda& lambda, int& runs) {
+    Clock::time_point start= Clock::now();
+    double elapsed= 0;
+
+    runs= 0;
+    do {
+        lambda();
+        runs++;
+        elapsed= std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    } while(elapsed < budgetMs * 1e6);
+    return elapsed / runs / (elements > 0 ? elements : 1);
+}
+
+/**
+ * Writes benchmark results as a JSON document, one result object per line so two runs can be compared with diff
+ * @author etsai
+ */
+class JsonReporter {
+public:
+    /**
+     * Starts the document
+     * @param   output  Stream to write to
+     * @param   suite   Name of the benchmark suite
+     */
+    JsonReporter(ostream& output, const string& suite) : output(output), first(true) {
+        output << "{\"suite\": \"" << suite << "\", \"results\": [" << std::endl;
+    }
+    /**
+     * Closes the document
+     */
+    ~JsonReporter() {
+        output << std::endl << "]}" << std::endl;
+    }
+
+    /**
+     * Writes one result
+     * @param   container   Name of the container measured
+     * @param   element     Name of the element type
+     * @param   operation   Name of the operation measured
+     * @param   size        Number of elements in the container
+     * @param   repeats     Number of operations or passes timed
+     * @param   ns          Nanoseconds per operation or per element
+     * @param   unit        What ns is measured per, "op" or "element"
+     * @param   threads     Number of threads on each side of a concurrent benchmark, left out of the output if 0
+     */
+    void result(const string& container, const string& element, const string& operation, int size, int repeats, double ns,
+            const string& unit, int threads= 0) {
+        output << (first ? "" : ",\n") << "  {\"container\": \"" << container << "\", \"element\": \"" << element <<
+                "\", \"operation\": \"" << operation << "\", \"size\": " << size << ", \"repeats\": " << repeats;
+        if (threads > 0) {
+            output << ", \"threads\": " << threads;
+        }
+        output << ", \"ns_per_" << unit << "\": " << std::fixed << std::setprecision(2) << ns << "}";
+        output.flush();
+        first= false;
+    }
+
+private:
+    ostream& output;
+    bool first;
+};
+
+}   //namespace bench
+
+#endif
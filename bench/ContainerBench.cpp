@@ -0,0 +1,617 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <numeric>
+#include <queue>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "bench/Bench.h"
+#include "List/ArrayList.h"
+#include "List/CircularLinkedList.h"
+#include "List/GapBufferList.h"
+#include "List/SegmentedArrayList.h"
+#include "List/TreeList.h"
+#include "Queue/PriorityQueue.h"
+#include "Set/SortedSet.h"
+
+using bench::Clock;
+using bench::Element;
+using bench::Integer;
+using bench::JsonReporter;
+using bench::Random;
+using etsai::collections::list::ArrayList;
+using etsai::collections::list::CircularLinkedList;
+using etsai::collections::list::GapBufferList;
+using etsai::collections::list::SegmentedArrayList;
+using etsai::collections::list::TreeList;
+using etsai::collections::queue::PriorityQueue;
+using etsai::collections::set::SortedSet;
+using std::cout;
+using std::string;
+using std::unique_ptr;
+using std::vector;
+
+/** Maximum number of operations timed by a per operation benchmark */
+const int OPERATIONS= 1000;
+
+/**
+ * Name each list class is reported under
+ */
+template <template <class...> class L>
+struct ListName;
+
+template <>
+struct ListName<ArrayList> {
+    static const char* value() {
+        return "ArrayList";
+    }
+};
+
+template <>
+struct ListName<SegmentedArrayList> {
+    static const char* value() {
+        return "SegmentedArrayList";
+    }
+};
+
+template <>
+struct ListName<GapBufferList> {
+    static const char* value() {
+        return "GapBufferList";
+    }
+};
+
+template <>
+struct ListName<TreeList> {
+    static const char* value() {
+        return "TreeList";
+    }
+};
+
+template <>
+struct ListName<CircularLinkedList> {
+    static const char* value() {
+        return "CircularLinkedList";
+    }
+};
+
+/**
+ * Adapters giving every container the same interface, so one runner measures them all.  The list adapters also
+ * provide insert, reverse, and subList; the set adapters do not.  ListOps covers every List class, so a new list
+ * only needs a ListName.
+ */
+template <template <class...> class L, class T>
+struct ListOps {
+    typedef L<T> Container;
+
+    static const char* name() {
+        return ListName<L>::value();
+    }
+    static void add(Container& c, const T& elem) {
+        c.add(elem);
+    }
+    static void insert(Container& c, const T& elem) {
+        c.add(c.size() / 2, elem);
+    }
+    static int get(const Container& c, int index) {
+        return Element<T>::key(c.at(index));
+    }
+    static bool contains(const Container& c, const T& elem) {
+        return c.contains(elem);
+    }
+    static void remove(Container& c, const T& elem) {
+        c.remove(elem);
+    }
+    static long each(const Container& c) {
+        long sum= 0;
+
+        c.each([&sum](const T& elem) -> void {
+            sum+= Element<T>::key(elem);
+        });
+        return sum;
+    }
+    static long map(const Container& c) {
+        return c.template map<int>(Element<T>::key).size();
+    }
+    static long fold(const Container& c) {
+        return c.template foldLeft<long>(0, [](const long& sum, const T& elem) -> long {
+            return sum + Element<T>::key(elem);
+        });
+    }
+    static long reverse(const Container& c) {
+        return unique_ptr<Container>(c.reverse())->size();
+    }
+    static long subList(const Container& c) {
+        return unique_ptr<Container>(c.subList(c.size() / 4, c.size() * 3 / 4))->size();
+    }
+};
+
+/**
+ * ArrayList in incremental resize mode.  Only used to time adds.
+ */
+template <class T>
+struct IncrementalArrayListOps : public ListOps<ArrayList, T> {
+    struct Container : public ArrayList<T> {
+        Container() {
+            this->setIncrementalResize(true);
+        }
+    };
+
+    static const char* name() {
+        return "ArrayList_incremental";
+    }
+};
+
+template <class T>
+struct VectorOps {
+    typedef vector<T> Container;
+
+    static const char* name() {
+        return "std::vector";
+    }
+    static void add(Container& c, const T& elem) {
+        c.push_back(elem);
+    }
+    static void insert(Container& c, const T& elem) {
+        c.insert(c.begin() + c.size() / 2, elem);
+    }
+    static int get(const Container& c, int index) {
+        return Element<T>::key(c[index]);
+    }
+    static bool contains(const Container& c, const T& elem) {
+        return std::find(c.begin(), c.end(), elem) != c.end();
+    }
+    static void remove(Container& c, const T& elem) {
+        typename Container::iterator it= std::find(c.begin(), c.end(), elem);
+
+        if (it != c.end()) {
+            c.erase(it);
+        }
+    }
+    static long each(const Container& c) {
+        long sum= 0;
+
+        for(const T& elem: c) {
+            sum+= Element<T>::key(elem);
+        }
+        return sum;
+    }
+    static long map(const Container& c) {
+        vector<int> mapped(c.size());
+
+        std::transform(c.begin(), c.end(), mapped.begin(), Element<T>::key);
+        return mapped.size();
+    }
+    static long fold(const Container& c) {
+        return std::accumulate(c.begin(), c.end(), 0L, [](long sum, const T& elem) -> long {
+            return sum + Element<T>::key(elem);
+        });
+    }
+    static long reverse(const Container& c) {
+        return Container(c.rbegin(), c.rend()).size();
+    }
+    static long subList(const Container& c) {
+        return Container(c.begin() + c.size() / 4, c.begin() + c.size() * 3 / 4 + 1).size();
+    }
+};
+
+template <class T>
+struct StdListOps {
+    typedef std::list<T> Container;
+
+    static const char* name() {
+        return "std::list";
+    }
+    static void add(Container& c, const T& elem) {
+        c.push_back(elem);
+    }
+    static void insert(Container& c, const T& elem) {
+        c.insert(std::next(c.begin(), c.size() / 2), elem);
+    }
+    static int get(const Container& c, int index) {
+        return Element<T>::key(*std::next(c.begin(), index));
+    }
+    static bool contains(const Container& c, const T& elem) {
+        return std::find(c.begin(), c.end(), elem) != c.end();
+    }
+    static void remove(Container& c, const T& elem) {
+        typename Container::iterator it= std::find(c.begin(), c.end(), elem);
+
+        if (it != c.end()) {
+            c.erase(it);
+        }
+    }
+    static long each(const Container& c) {
+        long sum= 0;
+
+        for(const T& elem: c) {
+            sum+= Element<T>::key(elem);
+        }
+        return sum;
+    }
+    static long map(const Container& c) {
+        std::list<int> mapped;
+
+        std::transform(c.begin(), c.end(), std::back_inserter(mapped), Element<T>::key);
+        return mapped.size();
+    }
+    static long fold(const Container& c) {
+        return std::accumulate(c.begin(), c.end(), 0L, [](long sum, const T& elem) -> long {
+            return sum + Element<T>::key(elem);
+        });
+    }
+    static long reverse(const Container& c) {
+        return Container(c.rbegin(), c.rend()).size();
+    }
+    static long subList(const Container& c) {
+        return Container(std::next(c.begin(), c.size() / 4), std::next(c.begin(), c.size() * 3 / 4 + 1)).size();
+    }
+};
+
+template <class T>
+struct SortedSetOps {
+    typedef SortedSet<T> Container;
+
+    static const char* name() {
+        return "SortedSet";
+    }
+    static void add(Container& c, const T& elem) {
+        c.add(elem);
+    }
+    static int get(const Container& c, int index) {
+        return Element<T>::key(c.select(index));
+    }
+    static bool contains(const Container& c, const T& elem) {
+        return c.contains(elem);
+    }
+    static void remove(Container& c, const T& elem) {
+        c.remove(elem);
+    }
+    static long each(const Container& c) {
+        long sum= 0;
+
+        c.each([&sum](const T& elem) -> void {
+            sum+= Element<T>::key(elem);
+        });
+        return sum;
+    }
+    static long map(const Container& c) {
+        return c.template map<int>(Element<T>::key).size();
+    }
+};
+
+template <class T>
+struct StdSetOps {
+    typedef std::set<T> Container;
+
+    static const char* name() {
+        return "std::set";
+    }
+    static void add(Container& c, const T& elem) {
+        c.insert(elem);
+    }
+    static int get(const Container& c, int index) {
+        return Element<T>::key(*std::next(c.begin(), index));
+    }
+    static bool contains(const Container& c, const T& elem) {
+        return c.count(elem) != 0;
+    }
+    static void remove(Container& c, const T& elem) {
+        c.erase(elem);
+    }
+    static long each(const Container& c) {
+        long sum= 0;
+
+        for(const T& elem: c) {
+            sum+= Element<T>::key(elem);
+        }
+        return sum;
+    }
+    static long map(const Container& c) {
+        std::set<int> mapped;
+
+        std::transform(c.begin(), c.end(), std::inserter(mapped, mapped.end()), Element<T>::key);
+        return mapped.size();
+    }
+};
+
+/**
+ * Adapters for the priority queues, and for the SortedSet used as one before PriorityQueue existed.  Every adapter
+ * pops the smallest element first.
+ */
+template <class T, int Arity>
+struct PriorityQueueOps {
+    typedef PriorityQueue<T> Container;
+
+    static const char* name() {
+        return Arity == 2 ? "PriorityQueue<2>" : "PriorityQueue<4>";
+    }
+    static Container* create() {
+        return new Container(Arity);
+    }
+    static Container* heapify(const vector<T>& elems) {
+        ArrayList<T> list(elems.size());
+
+        for(const T& elem: elems) {
+            list.add(elem);
+        }
+        return new Container(std::move(list), Arity);
+    }
+    static void push(Container& c, const T& elem) {
+        c.push(elem);
+    }
+    static int pop(Container& c) {
+        return Element<T>::key(c.pop());
+    }
+};
+
+template <class T>
+struct StdPriorityQueueOps {
+    struct Later {
+        bool operator()(const T& left, const T& right) const {
+            return right < left;
+        }
+    };
+    typedef std::priority_queue<T, vector<T>, Later> Container;
+
+    static const char* name() {
+        return "std::priority_queue";
+    }
+    static Container* create() {
+        return new Container();
+    }
+    static Container* heapify(const vector<T>& elems) {
+        return new Container(Later(), elems);
+    }
+    static void push(Container& c, const T& elem) {
+        c.push(elem);
+    }
+    static int pop(Container& c) {
+        int key= Element<T>::key(c.top());
+
+        c.pop();
+        return key;
+    }
+};
+
+template <class T>
+struct SortedSetQueueOps {
+    typedef SortedSet<T> Container;
+
+    static const char* name() {
+        return "SortedSet";
+    }
+    static Container* create() {
+        return new Container();
+    }
+    static Container* heapify(const vector<T>& elems) {
+        ArrayList<T> list(elems.size());
+
+        for(const T& elem: elems) {
+            list.add(elem);
+        }
+        return new Container(std::move(list));
+    }
+    static void push(Container& c, const T& elem) {
+        c.add(elem);
+    }
+    static int pop(Container& c) {
+        T first= c.first();
+
+        c.remove(first);
+        return Element<T>::key(first);
+    }
+};
+
+/**
+ * Builds a container holding the elements make(0), make(step), ..., make((size - 1) * step).  The elements are 
+ * added in ascending order, so sets are built by appending.  Sets are given even steps so odd keys can be added 
+ * as new elements.
+ */
+template <class Ops, class T>
+void build(typename Ops::Container& c, int size, int step) {
+    for(int i= 0; i < size; i++) {
+        Ops::add(c, Element<T>::make(i * step));
+    }
+}
+
+/**
+ * Measures the operations that every container supports
+ */
+template <class Ops, class T>
+void runCommon(JsonReporter& reporter, int size, int step, double budget, volatile long& sink) {
+    typedef typename Ops::Container Container;
+    int count= size < OPERATIONS ? size : OPERATIONS, done;
+    vector<int> indices(count);
+    vector<T> probes, added, removed;
+    Random random;
+    double ns;
+
+    for(int i= 0; i < count; i++) {
+        indices[i]= random.next(size);
+        probes.push_back(Element<T>::make(random.next(size) * step));
+        added.push_back(Element<T>::make(random.next(size) * step + 1));
+        removed.push_back(Element<T>::make((int) ((long) i * size / count) * step));
+    }
+
+    unique_ptr<Container> c(new Container());
+    build<Ops, T>(*c, size, step);
+
+    ns= bench::perOperation(count, budget, [&c, &indices, &sink](int i) -> void {
+        sink+= Ops::get(*c, indices[i]);
+    }, done);
+    reporter.result(Ops::name(), Element<T>::name(), "get", size, done, ns, "op");
+    ns= bench::perOperation(count, budget, [&c, &probes, &sink](int i) -> void {
+        sink+= Ops::contains(*c, probes[i]);
+    }, done);
+    reporter.result(Ops::name(), Element<T>::name(), "contains", size, done, ns, "op");
+    ns= bench::perElement(size, budget, [&c, &sink]() -> void {
+        sink+= Ops::each(*c);
+    }, done);
+    reporter.result(Ops::name(), Element<T>::name(), "each", size, done, ns, "element");
+    ns= bench::perElement(size, budget, [&c, &sink]() -> void {
+        sink+= Ops::map(*c);
+    }, done);
+    reporter.result(Ops::name(), Element<T>::name(), "map", size, done, ns, "element");
+
+    ns= bench::perOperation(count, budget, [&c, &added](int i) -> void {
+        Ops::add(*c, added[i]);
+    }, done);
+    reporter.result(Ops::name(), Element<T>::name(), "add", size, done, ns, "op");
+
+    c.reset(new Container());
+    build<Ops, T>(*c, size, step);
+    ns= bench::perOperation(count, budget, [&c, &removed](int i) -> void {
+        Ops::remove(*c, removed[i]);
+    }, done);
+    reporter.result(Ops::name(), Element<T>::name(), "remove", size, done, ns, "op");
+}
+
+/**
+ * Measures the common operations plus the ones only lists support
+ */
+template <class Ops, class T>
+void runList(JsonReporter& reporter, int size, double budget, volatile long& sink) {
+    typedef typename Ops::Container Container;
+    int count= size < OPERATIONS ? size : OPERATIONS, done;
+    T elem= Element<T>::make(-1);
+    double ns;
+
+    runCommon<Ops, T>(reporter, size, 1, budget, sink);
+
+    unique_ptr<Container> c(new Container());
+    build<Ops, T>(*c, size, 1);
+    ns= bench::perElement(size, budget, [&c, &sink]() -> void {
+        sink+= Ops::fold(*c);
+    }, done);
+    reporter.result(Ops::name(), Element<T>::name(), "fold", size, done, ns, "element");
+    ns= bench::perElement(size, budget, [&c, &sink]() -> void {
+        sink+= Ops::reverse(*c);
+    }, done);
+    reporter.result(Ops::name(), Element<T>::name(), "reverse", size, done, ns, "element");
+    ns= bench::perElement(size / 2, budget, [&c, &sink]() -> void {
+        sink+= Ops::subList(*c);
+    }, done);
+    reporter.result(Ops::name(), Element<T>::name(), "subList", size, done, ns, "element");
+    ns= bench::perOperation(count, budget, [&c, &elem](int) -> void {
+        Ops::insert(*c, elem);
+    }, done);
+    reporter.result(Ops::name(), Element<T>::name(), "insert", size, done, ns, "op");
+}
+
+/**
+ * Times every add that grows a container from empty to the given size, and reports the median, 99th, and 99.9th 
+ * percentile and the longest time of a single add.  Adds that reallocate the container's storage make up the tail.
+ */
+template <class Ops, class T>
+void runAddLatency(JsonReporter& reporter, int size) {
+    typename Ops::Container c;
+    vector<long> latencies(size);
+
+    for(int i= 0; i < size; i++) {
+        T elem= Element<T>::make(i);
+        Clock::time_point start= Clock::now();
+
+        Ops::add(c, elem);
+        latencies[i]= std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+    }
+    std::sort(latencies.begin(), latencies.end());
+    reporter.result(Ops::name(), Element<T>::name(), "add_latency_p50", size, size, latencies[size / 2], "op");
+    reporter.result(Ops::name(), Element<T>::name(), "add_latency_p99", size, size, latencies[size * 99L / 100], "op");
+    reporter.result(Ops::name(), Element<T>::name(), "add_latency_p999", size, size, latencies[size * 999L / 1000], "op");
+    reporter.result(Ops::name(), Element<T>::name(), "add_latency_max", size, size, latencies[size - 1], "op");
+}
+
+/**
+ * Measures a priority queue: pushing the elements in random order and popping them all, and building the queue from
+ * all the elements at once and popping them all.  The elements are distinct so the SortedSet keeps every one.
+ */
+template <class Ops, class T>
+void runPriorityQueue(JsonReporter& reporter, int size, double budget, volatile long& sink) {
+    typedef typename Ops::Container Container;
+    vector<T> elems;
+    Random random;
+    double ns;
+    int runs;
+
+    for(int i= 0; i < size; i++) {
+        elems.push_back(Element<T>::make(i));
+    }
+    for(int i= size - 1; i > 0; i--) {
+        std::swap(elems[i], elems[random.next(i + 1)]);
+    }
+
+    ns= bench::perElement(size, budget, [&elems, &sink, size]() -> void {
+        unique_ptr<Container> c(Ops::create());
+
+        for(const T& elem: elems) {
+            Ops::push(*c, elem);
+        }
+        for(int i= 0; i < size; i++) {
+            sink+= Ops::pop(*c);
+        }
+    }, runs);
+    reporter.result(Ops::name(), Element<T>::name(), "push_pop", size, runs, ns, "element");
+    ns= bench::perElement(size, budget, [&elems, &sink, size]() -> void {
+        unique_ptr<Container> c(Ops::heapify(elems));
+
+        for(int i= 0; i < size; i++) {
+            sink+= Ops::pop(*c);
+        }
+    }, runs);
+    reporter.result(Ops::name(), Element<T>::name(), "heapify_pop", size, runs, ns, "element");
+}
+
+template <class T>
+void runType(JsonReporter& reporter, int maxSize, double budget, volatile long& sink) {
+    for(long size= 10; size <= maxSize; size*= 10) {
+        runList<ListOps<ArrayList, T>, T>(reporter, size, budget, sink);
+        runList<ListOps<SegmentedArrayList, T>, T>(reporter, size, budget, sink);
+        runList<ListOps<GapBufferList, T>, T>(reporter, size, budget, sink);
+        runList<ListOps<TreeList, T>, T>(reporter, size, budget, sink);
+        runList<VectorOps<T>, T>(reporter, size, budget, sink);
+        runList<ListOps<CircularLinkedList, T>, T>(reporter, size, budget, sink);
+        runList<StdListOps<T>, T>(reporter, size, budget, sink);
+        runCommon<SortedSetOps<T>, T>(reporter, size, 2, budget, sink);
+        runCommon<StdSetOps<T>, T>(reporter, size, 2, budget, sink);
+        runAddLatency<ListOps<ArrayList, T>, T>(reporter, size);
+        runAddLatency<IncrementalArrayListOps<T>, T>(reporter, size);
+        runAddLatency<ListOps<SegmentedArrayList, T>, T>(reporter, size);
+        runAddLatency<VectorOps<T>, T>(reporter, size);
+        runPriorityQueue<PriorityQueueOps<T, 2>, T>(reporter, size, budget, sink);
+        runPriorityQueue<PriorityQueueOps<T, 4>, T>(reporter, size, budget, sink);
+        runPriorityQueue<StdPriorityQueueOps<T>, T>(reporter, size, budget, sink);
+        if (size <= 10000) {
+            runPriorityQueue<SortedSetQueueOps<T>, T>(reporter, size, budget, sink);
+        }
+    }
+}
+
+/**
+ * Compares the containers against their standard library counterparts, writing the results as JSON to stdout.
+ * Per operation benchmarks time up to 1000 operations; per element benchmarks time whole passes over the
+ * container.  Each measurement stops after the time budget.  Add latency percentiles time every add made while
+ * growing the list containers from empty.  The priority queues are timed pushing or heapifying every element
+ * and popping them all; SortedSet is only timed as a queue up to 10000 elements, since each push shifts O(n)
+ * elements.  Usage: ContainerBench [max size] [budget ms]
+ */
+int main(int argc, char **argv) {
+    int maxSize= argc > 1 ? atoi(argv[1]) : 10000000;
+    double budget= argc > 2 ? atof(argv[2]) : 200;
+    volatile long sink= 0;
+
+    {
+        JsonReporter reporter(cout, "containers");
+
+        runType<int>(reporter, maxSize, budget, sink);
+        runType<string>(reporter, maxSize, budget, sink);
+        runType<Integer>(reporter, maxSize, budget, sink);
+    }
+    return 0;
+}
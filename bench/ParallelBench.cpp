@@ -0,0 +1,93 @@
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "List/ArrayList.h"
+
+using etsai::collections::WorkStealingPool;
+using etsai::collections::list::ArrayList;
+using std::cout;
+using std::endl;
+using std::function;
+using std::vector;
+
+typedef std::chrono::steady_clock Clock;
+
+/**
+ * Times the fastest of several runs of the lambda
+ * @return  Best time in milliseconds
+ */
+double best(int runs, const function<void (void)>& lambda) {
+    double fastest= -1;
+
+    for(int i= 0; i < runs; i++) {
+        Clock::time_point start= Clock::now();
+        lambda();
+        double elapsed= std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        if (fastest < 0 || elapsed < fastest) {
+            fastest= elapsed;
+        }
+    }
+    return fastest;
+}
+
+/**
+ * Measures how the parallel ArrayList operations scale with the number of threads.  Usage: ParallelBench [elements] [runs]
+ */
+int main(int argc, char **argv) {
+    int size= argc > 1 ? atoi(argv[1]) : 10000000;
+    int runs= argc > 2 ? atoi(argv[2]) : 3;
+    vector<int> threadCounts= {1, 2, 4, 8, 16, 32, 64};
+    ArrayList<int> list(size);
+    const ArrayList<int>& constList= list;
+    volatile long sink= 0;
+
+    for(int i= 0; i < size; i++) {
+        list.add(i);
+    }
+
+    double sequential= best(runs, [&list, &sink]() -> void {
+        ArrayList<double> mapped= list.map<double>([](const int& elem) -> double {
+            return elem * 0.5 + 1;
+        });
+        sink+= mapped.size();
+    });
+    cout << "elements=" << size << " hardware threads=" << std::thread::hardware_concurrency() << endl;
+    cout << "sequential map: " << std::fixed << std::setprecision(2) << sequential << " ms" << endl;
+    cout << std::setw(8) << "threads" << std::setw(14) << "parMap ms" << std::setw(14) << "parCount ms" 
+            << std::setw(14) << "parEach ms" << std::setw(14) << "parExists ms" << std::setw(10) << "speedup" << endl;
+    for(int threads: threadCounts) {
+        WorkStealingPool pool(threads - 1);
+
+        double map= best(runs, [&list, &pool, &sink]() -> void {
+            ArrayList<double> mapped= list.parMap<double>([](const int& elem) -> double {
+                return elem * 0.5 + 1;
+            }, 0, &pool);
+            sink+= mapped.size();
+        });
+        double count= best(runs, [&list, &pool, &sink]() -> void {
+            sink+= list.parCount([](const int& elem) -> bool {
+                return elem % 3 == 0;
+            }, 0, &pool);
+        });
+        double each= best(runs, [&constList, &pool, &sink]() -> void {
+            constList.parEach([](const int& elem) -> void {
+                if (elem < 0) {
+                    throw elem;
+                }
+            }, 0, &pool);
+        });
+        double exists= best(runs, [&list, &pool, &sink, size]() -> void {
+            sink+= list.parExists([size](const int& elem) -> bool {
+                return elem == size / 2;
+            }, 0, &pool);
+        });
+        cout << std::setw(8) << threads << std::setw(14) << map << std::setw(14) << count << std::setw(14) << each 
+                << std::setw(14) << exists << std::setw(10) << sequential / map << endl;
+    }
+    return 0;
+}
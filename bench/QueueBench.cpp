@@ -0,0 +1,167 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench/Bench.h"
+#include "List/CircularLinkedList.h"
+#include "Queue/MpmcQueue.h"
+#include "Queue/SpscQueue.h"
+
+using bench::Clock;
+using bench::JsonReporter;
+using etsai::collections::list::CircularLinkedList;
+using etsai::collections::queue::MpmcQueue;
+using etsai::collections::queue::SpscQueue;
+using std::atomic;
+using std::cout;
+using std::string;
+using std::thread;
+using std::vector;
+
+/** Number of slots in every queue */
+const int CAPACITY= 1024;
+
+/**
+ * The mutex guarded CircularLinkedList the lock-free queues replace, behind the same interface and bounded to the
+ * same capacity
+ */
+template <class T>
+class LockedListQueue {
+public:
+    explicit LockedListQueue(int capacity) : limit(capacity) {
+    }
+
+    int tryPushN(const T* elems, int count) {
+        std::lock_guard<std::mutex> guard(lock);
+        int added= std::min(count, limit - list.size());
+
+        for(int i= 0; i < added; i++) {
+            list.add(elems[i]);
+        }
+        return added;
+    }
+    int tryPopN(T* elems, int count) {
+        std::lock_guard<std::mutex> guard(lock);
+        int removed= std::min(count, list.size());
+
+        for(int i= 0; i < removed; i++) {
+            elems[i]= list.minus(0);
+        }
+        return removed;
+    }
+
+private:
+    int limit;
+    std::mutex lock;
+    CircularLinkedList<T> list;
+};
+
+/**
+ * Get the current time in nanoseconds, which producers send as the message so consumers can measure latency
+ */
+long now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+/**
+ * Passes messages from producer threads to the same number of consumer threads in batches, then reports the time
+ * per message and the 50th and 99th percentile time from push to pop.  Threads yield whenever the queue is full or
+ * empty, so runs with more threads than cores still make progress.
+ * @param   threads     Number of producers, and of consumers
+ * @param   batch       Number of messages per tryPushN and tryPopN call
+ * @param   messages    Total number of messages, split evenly among the producers
+ */
+template <class Queue>
+void run(JsonReporter& reporter, const string& name, int threads, int batch, int messages) {
+    Queue queue(CAPACITY);
+    vector<thread> workers;
+    vector<vector<long>> latencies(threads);
+    atomic<int> remaining(messages / threads * threads);
+    int perProducer= messages / threads;
+    Clock::time_point start= Clock::now();
+
+    for(int t= 0; t < threads; t++) {
+        workers.push_back(thread([&queue, batch, perProducer]() -> void {
+            vector<long> stamps(batch);
+
+            for(int sent= 0; sent < perProducer;) {
+                int size= std::min(batch, perProducer - sent);
+
+                for(int i= 0; i < size; i++) {
+                    stamps[i]= now();
+                }
+                for(int pushed= 0; pushed < size;) {
+                    int added= queue.tryPushN(stamps.data() + pushed, size - pushed);
+
+                    pushed+= added;
+                    if (added == 0) {
+                        std::this_thread::yield();
+                    }
+                }
+                sent+= size;
+            }
+        }));
+        workers.push_back(thread([&queue, &latencies, &remaining, batch, t]() -> void {
+            vector<long> stamps(batch);
+
+            latencies[t].reserve(remaining / latencies.size() + batch);
+            while(remaining > 0) {
+                int removed= queue.tryPopN(stamps.data(), batch);
+                long received= now();
+
+                for(int i= 0; i < removed; i++) {
+                    latencies[t].push_back(received - stamps[i]);
+                }
+                remaining-= removed;
+                if (removed == 0) {
+                    std::this_thread::yield();
+                }
+            }
+        }));
+    }
+    for(thread& worker: workers) {
+        worker.join();
+    }
+
+    double elapsed= std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    vector<long> all;
+    for(vector<long>& consumer: latencies) {
+        all.insert(all.end(), consumer.begin(), consumer.end());
+    }
+    std::sort(all.begin(), all.end());
+
+    string suffix= "_batch" + std::to_string(batch);
+    int sent= all.size();
+    reporter.result(name, "long", "throughput" + suffix, CAPACITY, sent, elapsed / sent, "op", threads);
+    reporter.result(name, "long", "latency_p50" + suffix, CAPACITY, sent, all[sent / 2], "op", threads);
+    reporter.result(name, "long", "latency_p99" + suffix, CAPACITY, sent, all[sent * 99L / 100], "op", threads);
+}
+
+/**
+ * Measures throughput and latency of the concurrent queues against a locked CircularLinkedList, from 1 to 32
+ * producer and consumer threads.  The single producer queue only runs with one thread on each side.
+ * Usage: QueueBench [messages] [max threads]
+ */
+int main(int argc, char **argv) {
+    int messages= argc > 1 ? atoi(argv[1]) : 1000000;
+    int maxThreads= argc > 2 ? atoi(argv[2]) : 32;
+
+    {
+        JsonReporter reporter(cout, "queues");
+
+        for(int batch: {1, 16}) {
+            run<SpscQueue<long>>(reporter, "SpscQueue", 1, batch, messages);
+            for(int threads= 1; threads <= maxThreads; threads*= 2) {
+                run<MpmcQueue<long>>(reporter, "MpmcQueue", threads, batch, messages);
+                run<LockedListQueue<long>>(reporter, "LockedCircularLinkedList", threads, batch, messages);
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,125 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench/Bench.h"
+#include "Set/ConcurrentSortedSet.h"
+#include "Set/SortedSet.h"
+
+using bench::Clock;
+using bench::JsonReporter;
+using etsai::collections::set::ConcurrentSortedSet;
+using etsai::collections::set::SortedSet;
+using std::atomic;
+using std::cout;
+using std::function;
+using std::string;
+using std::thread;
+using std::vector;
+
+/** Number of elements in every set */
+const int SIZE= 100000;
+/** Time the writer waits between two updates */
+const std::chrono::microseconds WRITE_INTERVAL(1000);
+
+/**
+ * The mutex guarded SortedSet that ConcurrentSortedSet replaces, behind the same interface
+ */
+class LockedSortedSet {
+public:
+    bool contains(const int& elem) const {
+        std::lock_guard<std::mutex> guard(lock);
+
+        return set.contains(elem);
+    }
+    void update(const function<void (SortedSet<int>&)>& mutation) {
+        std::lock_guard<std::mutex> guard(lock);
+
+        mutation(set);
+    }
+
+private:
+    mutable std::mutex lock;
+    SortedSet<int> set;
+};
+
+/**
+ * Looks up elements from the given number of reader threads while one writer moves an element of the set every
+ * WRITE_INTERVAL, then reports the time per lookup across all readers.  The set holds the even numbers below
+ * 2 * SIZE, and the readers look up every number in that range, so half of the lookups hit.
+ * @param   threads     Number of reader threads
+ * @param   lookups     Total number of lookups, split evenly among the readers
+ */
+template <class Set>
+void run(JsonReporter& reporter, const string& name, int threads, int lookups, volatile long& sink) {
+    Set set;
+    atomic<bool> done(false);
+    atomic<long> hits(0);
+    vector<thread> readers;
+    int perReader= lookups / threads;
+
+    set.update([](SortedSet<int>& version) -> void {
+        for(int i= 0; i < SIZE; i++) {
+            version.add(2 * i);
+        }
+    });
+    thread writer([&set, &done]() -> void {
+        for(int i= 0; !done; i++) {
+            int from= 2 * (i % SIZE);
+
+            set.update([from](SortedSet<int>& version) -> void {
+                version.remove(from);
+                version.add(from);
+            });
+            std::this_thread::sleep_for(WRITE_INTERVAL);
+        }
+    });
+
+    Clock::time_point start= Clock::now();
+    for(int t= 0; t < threads; t++) {
+        readers.push_back(thread([&set, &hits, perReader, t]() -> void {
+            long found= 0;
+
+            for(int i= 0; i < perReader; i++) {
+                found+= set.contains((int) ((i * 7919L + t * 104729L) % (2 * SIZE)));
+            }
+            hits+= found;
+        }));
+    }
+    for(thread& reader: readers) {
+        reader.join();
+    }
+
+    double elapsed= std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    done= true;
+    writer.join();
+    sink+= hits;
+    reporter.result(name, "int", "contains", SIZE, perReader * threads, elapsed / (perReader * threads), "op", threads);
+}
+
+/**
+ * Measures how lookups on ConcurrentSortedSet scale with the number of reader threads, against a SortedSet behind
+ * a mutex, from 1 to the given number of readers.  A writer keeps publishing updates during every run.
+ * Usage: SetBench [lookups] [max threads]
+ */
+int main(int argc, char **argv) {
+    int lookups= argc > 1 ? atoi(argv[1]) : 4000000;
+    int maxThreads= argc > 2 ? atoi(argv[2]) : 32;
+    volatile long sink= 0;
+
+    {
+        JsonReporter reporter(cout, "sets");
+
+        for(int threads= 1; threads <= maxThreads; threads*= 2) {
+            run<ConcurrentSortedSet<int>>(reporter, "ConcurrentSortedSet", threads, lookups, sink);
+            run<LockedSortedSet>(reporter, "LockedSortedSet", threads, lookups, sink);
+        }
+    }
+    return 0;
+}
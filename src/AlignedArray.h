@@ -0,0 +1,87 @@
+#ifndef ETSAI_COLLECTIONS_SRC_ALIGNEDARRAY_H
+#define ETSAI_COLLECTIONS_SRC_ALIGNEDARRAY_H
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+namespace etsai {
+namespace collections {
+
+/**
+ * Fixed size heap array that honors the alignment of its element type.  Plain new[] only guarantees the alignment
+ * of the largest fundamental type before C++17, so types padded to a cache line with alignas must be allocated
+ * here instead.  Elements are value initialized and destroyed with the array.
+ * @author etsai
+ */
+template <class T>
+class AlignedArray {
+public:
+    /**
+     * Allocates and value initializes the given number of elements
+     * @param   count   Number of elements
+     * @throws  bad_alloc   If the memory cannot be allocated
+     */
+    explicit AlignedArray(int count);
+    ~AlignedArray();
+
+    /**
+     * Get the element at the index, which is not checked
+     */
+    T& operator[](int index) const;
+    T* begin() const;
+    T* end() const;
+
+private:
+    AlignedArray(const AlignedArray&);
+    AlignedArray& operator=(const AlignedArray&);
+
+    T* elements;
+    int count;
+};
+
+template <class T>
+AlignedArray<T>::AlignedArray(int count) : elements(NULL), count(0) {
+    void* memory;
+
+    if (posix_memalign(&memory, std::max(alignof(T), sizeof(void*)), count * sizeof(T)) != 0) {
+        throw std::bad_alloc();
+    }
+    elements= static_cast<T*>(memory);
+    try {
+        for(; this->count < count; this->count++) {
+            new (elements + this->count) T();
+        }
+    } catch (...) {
+        this->~AlignedArray();
+        throw;
+    }
+}
+
+template <class T>
+AlignedArray<T>::~AlignedArray() {
+    for(int i= 0; i < count; i++) {
+        elements[i].~T();
+    }
+    free(elements);
+}
+
+template <class T>
+T& AlignedArray<T>::operator[](int index) const {
+    return elements[index];
+}
+
+template <class T>
+T* AlignedArray<T>::begin() const {
+    return elements;
+}
+
+template <class T>
+T* AlignedArray<T>::end() const {
+    return elements + count;
+}
+
+}   //namespace collections
+}   //namespace etsai
+
+#endif
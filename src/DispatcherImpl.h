@@ -1,34 +1,102 @@
 #ifndef ETSAI_COLLECTIONS_DISPATCHER_IMPL_H
 #define ETSAI_COLLECTIONS_DISPATCHER_IMPL_H
 
-#include <typeindex>
-#include <typeinfo>
 #include "Dispatcher.h"
-#include "classes.h"
+#include "List/ArrayList.h"
+#include "List/CircularLinkedList.h"
+#include "List/TreeList.h"
+#include "Set/SortedSet.h"
 
 namespace etsai {
 namespace collections {
 
-using std::type_index;
-using std::type_info;
-using namespace list;
-
+/**
+ * Dispatcher that maps a collection of type T to the same kind of collection of type U.  Each overload calls 
+ * the concrete class' own map function, so the new collection is built without virtual calls per element.
+ * @author etsai
+ */
 template <class T, class U>
-class DispatcherImpl : public Dispatcher<T,U> {
+class DispatcherImpl : public Dispatcher<T> {
 public:
-    virtual Collection<U>* create(const Collection<T>* collection);
+    /**
+     * Creates a dispatcher that applies the transform to every element
+     * @param   transform   Lambda that maps T -> U
+     */
+    DispatcherImpl(const function<U (const T&)>& transform);
+
+    virtual void dispatch(const List<T>& collection);
+    virtual void dispatch(const Set<T>& collection);
+    virtual void dispatch(const list::ArrayList<T>& collection);
+    virtual void dispatch(const list::CircularLinkedList<T>& collection);
+    virtual void dispatch(const list::TreeList<T>& collection);
+    virtual void dispatch(const set::SortedSet<T>& collection);
+
+    /**
+     * Get the collection created by the last dispatch.  The caller is responsible for deallocating it.
+     * @return  The transformed collection
+     */
+    Collection<U>* result() const;
+
+private:
+    const function<U (const T&)>& transform;
+    Collection<U>* mapped;
 };
 
 template <class T, class U>
-Collection<U>* DispatcherImpl<T,U>::create(const Collection<T>* collection) {
-    type_index typeInfo(typeid(*collection));
-    
-    if (typeInfo == typeid(ArrayList<T>)) {
-        return new ArrayList<U>();
-    } else if (typeInfo == typeid(CircularLinkedList<T>)) {
-        return new CircularLinkedList<U>();
-    }
-    return NULL;
+DispatcherImpl<T,U>::DispatcherImpl(const function<U (const T&)>& transform) : transform(transform), mapped(NULL) {
+}
+
+template <class T, class U>
+void DispatcherImpl<T,U>::dispatch(const List<T>& collection) {
+    list::ArrayList<U>* converted= new list::ArrayList<U>(collection.size());
+
+    collection.each([converted, this](const T& elem) -> void {
+        converted->add(transform(elem));
+    });
+    mapped= converted;
+}
+
+template <class T, class U>
+void DispatcherImpl<T,U>::dispatch(const Set<T>& collection) {
+    set::SortedSet<U>* converted= new set::SortedSet<U>();
+
+    collection.each([converted, this](const T& elem) -> void {
+        converted->add(transform(elem));
+    });
+    mapped= converted;
+}
+
+template <class T, class U>
+void DispatcherImpl<T,U>::dispatch(const list::ArrayList<T>& collection) {
+    mapped= new list::ArrayList<U>(collection.template map<U>(transform));
+}
+
+template <class T, class U>
+void DispatcherImpl<T,U>::dispatch(const list::CircularLinkedList<T>& collection) {
+    mapped= new list::CircularLinkedList<U>(collection.template map<U>(transform));
+}
+
+template <class T, class U>
+void DispatcherImpl<T,U>::dispatch(const list::TreeList<T>& collection) {
+    mapped= new list::TreeList<U>(collection.template map<U>(transform));
+}
+
+template <class T, class U>
+void DispatcherImpl<T,U>::dispatch(const set::SortedSet<T>& collection) {
+    mapped= new set::SortedSet<U>(collection.template map<U>(transform));
+}
+
+template <class T, class U>
+Collection<U>* DispatcherImpl<T,U>::result() const {
+    return mapped;
+}
+
+template <class T> template <class U>
+Collection<U>* Collection<T>::map(const function<U (const T&)>& transform) const {
+    DispatcherImpl<T,U> dispatcher(transform);
+
+    accept(dispatcher);
+    return dispatcher.result();
 }
 
 }
@@ -0,0 +1,54 @@
+#ifndef ETSAI_COLLECTIONS_SRC_SEGMENTS_H
+#define ETSAI_COLLECTIONS_SRC_SEGMENTS_H
+
+namespace etsai {
+namespace collections {
+namespace segmented {
+
+/**
+ * Layout shared by the lists that store their elements in a directory of geometrically growing arrays.  The first
+ * segment holds 2^FIRST_BITS slots and segment k holds 2^(FIRST_BITS + k), so an index is located with one count
+ * of leading zeros and existing segments never move.
+ */
+const int FIRST_BITS= 3;
+/** Enough segments to hold every non negative int index */
+const int SEGMENTS= 32 - FIRST_BITS;
+
+/**
+ * Segment holding an index, and the index's offset within it
+ */
+struct Location {
+    int segment;
+    long offset;
+};
+
+/**
+ * Get the number of slots in the segment
+ */
+inline long length(int segment) {
+    return 1L << (FIRST_BITS + segment);
+}
+
+/**
+ * Get the number of slots in the first count segments
+ */
+inline long slotsIn(int count) {
+    return (1L << (FIRST_BITS + count)) - (1L << FIRST_BITS);
+}
+
+/**
+ * Get the segment and offset of the index
+ */
+inline Location locate(int index) {
+    unsigned long position= (unsigned long) index + (1UL << FIRST_BITS);
+    int highBit= sizeof(unsigned long) * 8 - 1 - __builtin_clzl(position);
+    Location location= {highBit - FIRST_BITS, (long) (position - (1UL << highBit))};
+
+    return location;
+}
+
+}   //namespace segmented
+}   //namespace collections
+}   //namespace etsai
+
+#endif
@@ -0,0 +1,215 @@
+#ifndef ETSAI_COLLECTIONS_SRC_SNAPSHOT_H
+#define ETSAI_COLLECTIONS_SRC_SNAPSHOT_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace etsai {
+namespace collections {
+namespace snapshot {
+
+using std::runtime_error;
+using std::shared_ptr;
+using std::string;
+using std::uint32_t;
+using std::uint64_t;
+
+/**
+ * Collection type stored in a snapshot file
+ */
+enum Kind : uint32_t {
+    LIST= 1,
+    SORTED_SET= 2
+};
+
+/**
+ * Fixed size header at the start of a snapshot file.  The elements follow the header as a raw array, starting at
+ * payloadOffset, which is a multiple of 64 so the array is suitably aligned when the file is mapped.  Fields are
+ * stored in the byte order of the machine that wrote the file; the endian field detects files from a machine
+ * with the other byte order.
+ */
+struct Header {
+    static const uint32_t MAGIC= 0x50534345;
+    static const uint32_t VERSION= 1;
+    static const uint32_t ENDIAN= 0x01020304;
+    static const uint64_t ALIGNMENT= 64;
+
+    uint32_t magic, version, endian, kind;
+    uint32_t elementSize, elementAlign;
+    uint64_t count, payloadOffset, checksum;
+    char reserved[16];
+};
+
+/**
+ * Computes a 64 bit FNV-1a hash of the bytes, folding in 8 bytes at a time
+ * @param   data    Bytes to hash
+ * @param   length  Number of bytes
+ * @return  Hash of the bytes
+ */
+inline uint64_t checksum(const void* data, uint64_t length) {
+    const unsigned char* bytes= static_cast<const unsigned char*>(data);
+    uint64_t hash= 0xcbf29ce484222325ULL;
+    uint64_t i= 0;
+
+    for(; i + 8 <= length; i+= 8) {
+        uint64_t word;
+
+        memcpy(&word, bytes + i, 8);
+        hash= (hash ^ word) * 0x100000001b3ULL;
+    }
+    for(; i < length; i++) {
+        hash= (hash ^ bytes[i]) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+/**
+ * Writes a snapshot file holding an array of elements.  The file is written to a temporary name and renamed into
+ * place, so readers never see a partially written snapshot.
+ * @param   path            Path of the file to write
+ * @param   kind            Collection type stored in the file
+ * @param   data            First element of the array
+ * @param   count           Number of elements
+ * @param   elementSize     Size of one element, in bytes
+ * @param   elementAlign    Alignment of one element, in bytes
+ * @throws  runtime_error   If the file cannot be written
+ */
+inline void write(const string& path, Kind kind, const void* data, uint64_t count, uint32_t elementSize, uint32_t elementAlign) {
+    Header header;
+    string temp= path + ".tmp";
+    FILE* file= fopen(temp.c_str(), "wb");
+    char padding[Header::ALIGNMENT]= {0};
+    uint64_t length= count * elementSize;
+
+    if (file == NULL) {
+        throw runtime_error("Cannot open " + temp + " for writing");
+    }
+    memset(&header, 0, sizeof(header));
+    header.magic= Header::MAGIC;
+    header.version= Header::VERSION;
+    header.endian= Header::ENDIAN;
+    header.kind= kind;
+    header.elementSize= elementSize;
+    header.elementAlign= elementAlign;
+    header.count= count;
+    header.payloadOffset= (sizeof(Header) + Header::ALIGNMENT - 1) / Header::ALIGNMENT * Header::ALIGNMENT;
+    header.checksum= checksum(data, length);
+
+    bool written= fwrite(&header, sizeof(header), 1, file) == 1 &&
+            fwrite(padding, 1, header.payloadOffset - sizeof(header), file) == header.payloadOffset - sizeof(header) &&
+            (length == 0 || fwrite(data, 1, length, file) == length);
+    written= fclose(file) == 0 && written;
+    if (!written || rename(temp.c_str(), path.c_str()) != 0) {
+        remove(temp.c_str());
+        throw runtime_error("Cannot write snapshot " + path);
+    }
+}
+
+/**
+ * Read-only memory mapping of a snapshot file.  The pages are shared with every other process mapping the same
+ * file, and are only read from disk when first touched.
+ * @author etsai
+ */
+class Mapping {
+public:
+    /**
+     * Maps the file and validates its header against the expected element type
+     * @param   path            Path of the snapshot file
+     * @param   kind            Collection type the file must hold
+     * @param   elementSize     Expected size of one element
+     * @param   elementAlign    Expected alignment of one element
+     * @param   verify          True if the checksum of the elements should be checked, which reads every page
+     * @throws  runtime_error   If the file cannot be mapped or does not hold a matching snapshot
+     */
+    Mapping(const string& path, Kind kind, uint32_t elementSize, uint32_t elementAlign, bool verify);
+    /**
+     * Unmaps the file
+     */
+    ~Mapping();
+
+    /**
+     * Get the number of elements in the snapshot
+     */
+    uint64_t count() const;
+    /**
+     * Get the first element of the mapped array
+     */
+    const void* data() const;
+
+private:
+    Mapping(const Mapping& mapping);
+    Mapping& operator =(const Mapping& mapping);
+
+    void* address;
+    uint64_t length;
+    const Header* header;
+};
+
+inline Mapping::Mapping(const string& path, Kind kind, uint32_t elementSize, uint32_t elementAlign, bool verify) : address(MAP_FAILED), length(0) {
+    int fd= open(path.c_str(), O_RDONLY);
+    struct stat info;
+
+    if (fd < 0) {
+        throw runtime_error("Cannot open snapshot " + path);
+    }
+    if (fstat(fd, &info) != 0 || (uint64_t) info.st_size < sizeof(Header)) {
+        close(fd);
+        throw runtime_error("Snapshot " + path + " is truncated");
+    }
+    length= info.st_size;
+    address= mmap(NULL, length, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (address == MAP_FAILED) {
+        throw runtime_error("Cannot map snapshot " + path);
+    }
+
+    header= static_cast<const Header*>(address);
+    const char* error= NULL;
+    if (header->magic != Header::MAGIC) {
+        error= " is not a collection snapshot";
+    } else if (header->endian != Header::ENDIAN) {
+        error= " was written with a different byte order";
+    } else if (header->version != Header::VERSION) {
+        error= " has an unsupported snapshot version";
+    } else if (header->kind != kind) {
+        error= " holds a different collection type";
+    } else if (header->elementSize != elementSize || header->elementAlign != elementAlign) {
+        error= " holds a different element type";
+    } else if (header->payloadOffset % Header::ALIGNMENT != 0 || header->payloadOffset > length ||
+            header->count > (length - header->payloadOffset) / elementSize) {
+        error= " is truncated";
+    } else if (verify && checksum(data(), header->count * elementSize) != header->checksum) {
+        error= " failed its checksum";
+    }
+    if (error != NULL) {
+        munmap(address, length);
+        throw runtime_error("Snapshot " + path + error);
+    }
+}
+
+inline Mapping::~Mapping() {
+    munmap(address, length);
+}
+
+inline uint64_t Mapping::count() const {
+    return header->count;
+}
+
+inline const void* Mapping::data() const {
+    return static_cast<const char*>(address) + header->payloadOffset;
+}
+
+}   //namespace snapshot
+}   //namespace collections
+}   //namespace etsai
+
+#endif
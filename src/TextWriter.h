@@ -0,0 +1,206 @@
+#ifndef ETSAI_COLLECTIONS_SRC_TEXTWRITER_H
+#define ETSAI_COLLECTIONS_SRC_TEXTWRITER_H
+
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <type_traits>
+
+namespace etsai {
+namespace collections {
+
+/**
+ * Options controlling how a collection is written as text.  By default every element is written, as
+ * [a0, a1, ..., an].  Setting head and/or tail truncates the output to the first head and last tail elements,
+ * with the ellipsis standing in for the elements in between.
+ * @author etsai
+ */
+struct TextFormat {
+    /**
+     * Constructs the default format, writing every element between square brackets
+     */
+    TextFormat() : open("["), separator(", "), close("]"), ellipsis("..."), head(-1), tail(-1), chunkSize(8192) {
+    }
+
+    /** Written before the first element */
+    std::string open;
+    /** Written between two elements */
+    std::string separator;
+    /** Written after the last element */
+    std::string close;
+    /** Written in place of the elements dropped by truncation */
+    std::string ellipsis;
+    /** Number of leading elements to write, or -1 for no limit */
+    int head;
+    /** Number of trailing elements to write, or -1 for no limit */
+    int tail;
+    /** Number of bytes buffered before they are handed to the writer */
+    std::size_t chunkSize;
+};
+
+/**
+ * Buffers text in a fixed size chunk and hands full chunks to a writer callback, so text of any length is
+ * produced in constant memory.  Integers are formatted directly into the chunk, two digits at a time; other
+ * values go through a reused stringstream and their operator <<.
+ * @author etsai
+ */
+class TextWriter {
+public:
+    /**
+     * Creates a writer handing chunks of at most chunkSize bytes to the callback
+     * @param   writer      Lambda receiving each chunk as a pointer and a length
+     * @param   chunkSize   Size of the buffer, in bytes
+     */
+    TextWriter(const std::function<void (const char*, std::size_t)>& writer, std::size_t chunkSize);
+    /**
+     * Flushes the remaining text
+     */
+    ~TextWriter();
+
+    /**
+     * Appends raw bytes
+     */
+    void write(const char* data, std::size_t length);
+    /**
+     * Appends a string
+     */
+    void write(const std::string& text);
+    /**
+     * Appends the text representation of a value
+     */
+    template <class T>
+    void writeValue(const T& value);
+    /**
+     * Hands the buffered text to the writer
+     */
+    void flush();
+
+private:
+    /**
+     * True for the integer types that operator << prints as numbers, that is, excluding bool and the character types
+     */
+    template <class T>
+    struct IsNumber {
+        static const bool value= std::is_integral<T>::value && !std::is_same<T, bool>::value && !std::is_same<T, char>::value &&
+                !std::is_same<T, signed char>::value && !std::is_same<T, unsigned char>::value && !std::is_same<T, wchar_t>::value &&
+                !std::is_same<T, char16_t>::value && !std::is_same<T, char32_t>::value;
+    };
+
+    TextWriter(const TextWriter& writer);
+    TextWriter& operator =(const TextWriter& writer);
+
+    template <class T>
+    void format(const T& value, std::true_type isNumber);
+    template <class T>
+    void format(const T& value, std::false_type isNumber);
+    void format(const std::string& value, std::false_type isNumber);
+
+    static const char* digitPairs();
+
+    std::function<void (const char*, std::size_t)> writer;
+    std::unique_ptr<char[]> buffer;
+    std::size_t capacity, used;
+    std::unique_ptr<std::stringstream> formatter;
+};
+
+inline TextWriter::TextWriter(const std::function<void (const char*, std::size_t)>& writer, std::size_t chunkSize) : writer(writer),
+        capacity(chunkSize < 64 ? 64 : chunkSize), used(0) {
+    buffer.reset(new char[capacity]);
+}
+
+inline TextWriter::~TextWriter() {
+    flush();
+}
+
+inline void TextWriter::write(const char* data, std::size_t length) {
+    while(length > 0) {
+        if (used == capacity) {
+            flush();
+        }
+
+        std::size_t copied= length < capacity - used ? length : capacity - used;
+        std::memcpy(buffer.get() + used, data, copied);
+        used+= copied;
+        data+= copied;
+        length-= copied;
+    }
+}
+
+inline void TextWriter::write(const std::string& text) {
+    write(text.data(), text.size());
+}
+
+template <class T>
+void TextWriter::writeValue(const T& value) {
+    format(value, std::integral_constant<bool, IsNumber<T>::value>());
+}
+
+inline void TextWriter::flush() {
+    if (used > 0) {
+        writer(buffer.get(), used);
+        used= 0;
+    }
+}
+
+template <class T>
+void TextWriter::format(const T& value, std::true_type) {
+    typedef typename std::make_unsigned<T>::type Unsigned;
+    const char* pairs= digitPairs();
+    char digits[3 * sizeof(T) + 2];
+    char* end= digits + sizeof(digits);
+    char* start= end;
+    bool negative= std::is_signed<T>::value && value < 0;
+    Unsigned magnitude= negative ? Unsigned(0) - Unsigned(value) : Unsigned(value);
+
+    while(magnitude >= 100) {
+        int pair= (magnitude % 100) * 2;
+
+        magnitude/= 100;
+        *--start= pairs[pair + 1];
+        *--start= pairs[pair];
+    }
+    if (magnitude >= 10) {
+        *--start= pairs[magnitude * 2 + 1];
+        *--start= pairs[magnitude * 2];
+    } else {
+        *--start= '0' + magnitude;
+    }
+    if (negative) {
+        *--start= '-';
+    }
+    write(start, end - start);
+}
+
+template <class T>
+void TextWriter::format(const T& value, std::false_type) {
+    if (formatter == NULL) {
+        formatter.reset(new std::stringstream());
+    }
+    formatter->str("");
+    formatter->clear();
+    *formatter << value;
+    write(formatter->str());
+}
+
+inline void TextWriter::format(const std::string& value, std::false_type) {
+    write(value);
+}
+
+inline const char* TextWriter::digitPairs() {
+    static const char pairs[]=
+            "0001020304050607080910111213141516171819"
+            "2021222324252627282930313233343536373839"
+            "4041424344454647484950515253545556575859"
+            "6061626364656667686970717273747576777879"
+            "8081828384858687888990919293949596979899";
+
+    return pairs;
+}
+
+}   //namespace collections
+}   //namespace etsai
+
+#endif
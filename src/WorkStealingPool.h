@@ -0,0 +1,229 @@
+#ifndef ETSAI_COLLECTIONS_SRC_WORKSTEALINGPOOL_H
+#define ETSAI_COLLECTIONS_SRC_WORKSTEALINGPOOL_H
+
+#include "src/AlignedArray.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace etsai {
+namespace collections {
+
+/**
+ * Fixed size thread pool running index ranges in parallel.  Every worker owns a queue of chunks; a worker runs
+ * chunks from the back of its own queue and, when it runs dry, steals from the front of the other queues.  The
+ * thread submitting a range works on it too, so ranges may be submitted from inside another range without
+ * deadlocking.  A pool with no workers runs every range on the calling thread.
+ * @author etsai
+ */
+class WorkStealingPool {
+public:
+    /**
+     * Starts a pool with the given number of worker threads
+     * @param   threads     Number of workers, not counting the threads that submit work
+     */
+    explicit WorkStealingPool(int threads);
+    /**
+     * Stops and joins the workers.  No range may be running when the pool is destroyed.
+     */
+    ~WorkStealingPool();
+
+    /**
+     * Get the process wide pool, sized so that the workers plus the calling thread use every hardware thread.  The
+     * pool is created the first time this function is called.
+     * @return  Shared pool
+     */
+    static WorkStealingPool& global();
+    /**
+     * Get the number of worker threads
+     * @return  Number of workers
+     */
+    int threads() const;
+    /**
+     * Splits [begin, end) into chunks of at most grain indices and calls the body once per chunk with the chunk's
+     * bounds, then waits for every chunk to finish.  Chunks run concurrently, in no particular order.  If a body
+     * throws, the remaining chunks still run and the first exception is rethrown to the caller.
+     * @param   begin   First index of the range
+     * @param   end     One past the last index of the range
+     * @param   grain   Maximum number of indices per chunk, which must be positive
+     * @param   body    Lambda taking the [begin, end) bounds of a chunk
+     */
+    void parallelFor(int begin, int end, int grain, const std::function<void (int, int)>& body);
+
+private:
+    /**
+     * Chunks of one parallelFor call that have not finished yet
+     */
+    struct Batch {
+        const std::function<void (int, int)>* body;
+        std::atomic<int> remaining;
+        std::mutex errorLock;
+        std::exception_ptr error;
+    };
+    struct Chunk {
+        Batch* batch;
+        int begin, end;
+    };
+    struct alignas(64) Queue {
+        std::mutex lock;
+        std::deque<Chunk> chunks;
+    };
+
+    /**
+     * Runs one chunk, taken from the back of the given queue or stolen from the front of another queue
+     * @param   home    Index of the queue to look in first
+     * @return  True if a chunk was run
+     */
+    bool runOne(int home);
+    /**
+     * Runs a chunk and records its completion
+     */
+    void run(const Chunk& chunk);
+    /**
+     * Main loop of a worker thread
+     * @param   home    Index of the worker's own queue
+     */
+    void work(int home);
+
+    int queueCount;
+    AlignedArray<Queue> queues;
+    std::vector<std::thread> workers;
+    std::atomic<int> pending;
+    std::atomic<unsigned int> nextQueue;
+    std::mutex sleepLock;
+    std::condition_variable wakeUp;
+    bool stopping;
+};
+
+inline WorkStealingPool::WorkStealingPool(int threads) : queueCount(std::max(threads, 1)), queues(queueCount),
+        pending(0), nextQueue(0), stopping(false) {
+    for(int i= 0; i < threads; i++) {
+        workers.push_back(std::thread(&WorkStealingPool::work, this, i));
+    }
+}
+
+inline WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepLock);
+        stopping= true;
+    }
+    wakeUp.notify_all();
+    for(std::thread& worker: workers) {
+        worker.join();
+    }
+}
+
+inline WorkStealingPool& WorkStealingPool::global() {
+    static WorkStealingPool pool(std::max((int) std::thread::hardware_concurrency() - 1, 0));
+
+    return pool;
+}
+
+inline int WorkStealingPool::threads() const {
+    return workers.size();
+}
+
+inline void WorkStealingPool::parallelFor(int begin, int end, int grain, const std::function<void (int, int)>& body) {
+    if (begin >= end) {
+        return;
+    }
+    if (workers.empty() || end - begin <= grain) {
+        body(begin, end);
+        return;
+    }
+
+    Batch batch;
+    int home= nextQueue.fetch_add(1) % queueCount;
+    int chunkCount= (end - begin + grain - 1) / grain;
+
+    batch.body= &body;
+    batch.remaining= chunkCount;
+    for(int i= 0; i < chunkCount; i++) {
+        Queue& queue= queues[(home + i) % queueCount];
+        Chunk chunk= {&batch, begin + i * grain, std::min(begin + (i + 1) * grain, end)};
+
+        std::lock_guard<std::mutex> lock(queue.lock);
+        queue.chunks.push_back(chunk);
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleepLock);
+        pending+= chunkCount;
+    }
+    wakeUp.notify_all();
+
+    while(batch.remaining.load() > 0) {
+        if (!runOne(home)) {
+            std::this_thread::yield();
+        }
+    }
+    if (batch.error) {
+        std::rethrow_exception(batch.error);
+    }
+}
+
+inline bool WorkStealingPool::runOne(int home) {
+    for(int i= 0; i < queueCount; i++) {
+        Queue& queue= queues[(home + i) % queueCount];
+        Chunk chunk;
+
+        {
+            std::lock_guard<std::mutex> lock(queue.lock);
+            if (queue.chunks.empty()) {
+                continue;
+            }
+            if (i == 0) {
+                chunk= queue.chunks.back();
+                queue.chunks.pop_back();
+            } else {
+                chunk= queue.chunks.front();
+                queue.chunks.pop_front();
+            }
+        }
+        pending--;
+        run(chunk);
+        return true;
+    }
+    return false;
+}
+
+inline void WorkStealingPool::run(const Chunk& chunk) {
+    Batch* batch= chunk.batch;
+
+    try {
+        (*batch->body)(chunk.begin, chunk.end);
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(batch->errorLock);
+        if (!batch->error) {
+            batch->error= std::current_exception();
+        }
+    }
+    batch->remaining.fetch_sub(1);
+}
+
+inline void WorkStealingPool::work(int home) {
+    while(true) {
+        if (runOne(home)) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepLock);
+        wakeUp.wait(lock, [this]() -> bool {
+            return stopping || pending.load() > 0;
+        });
+        if (stopping) {
+            return;
+        }
+    }
+}
+
+}   //namespace collections
+}   //namespace etsai
+
+#endif
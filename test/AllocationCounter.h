@@ -0,0 +1,152 @@
+#ifndef ETSAI_COLLECTIONS_TEST_ALLOCATIONCOUNTER_H
+#define ETSAI_COLLECTIONS_TEST_ALLOCATIONCOUNTER_H
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+/**
+ * Replaces the global operator new and delete so tests can count the allocations made by an operation.  This
+ * header defines the replacement operators, so it must be included by exactly one translation unit of a program,
+ * which for the tests is the test file itself.
+ */
+namespace etsai {
+namespace collections {
+namespace test {
+
+/**
+ * Allocations and deallocations seen on one thread
+ * @author etsai
+ */
+struct Allocations {
+    Allocations() : count(0), bytes(0), frees(0) {
+    }
+
+    /** Number of calls to operator new or new[] */
+    long count;
+    /** Total number of bytes requested */
+    long bytes;
+    /** Number of calls to operator delete or delete[] with a non null pointer */
+    long frees;
+};
+
+/**
+ * Get the running totals for the calling thread.  Counting is per thread so allocations made by other threads,
+ * such as pool workers, do not disturb a measurement.
+ */
+inline Allocations& threadAllocations() {
+    static thread_local Allocations allocations;
+
+    return allocations;
+}
+
+/**
+ * Counts the allocations made on the calling thread between its construction and each call to allocations
+ * @author etsai
+ */
+class AllocationCounter {
+public:
+    /**
+     * Starts counting from the current totals
+     */
+    AllocationCounter() : start(threadAllocations()) {
+    }
+
+    /**
+     * Get the allocations made since the counter was created
+     * @return  Allocations since construction
+     */
+    Allocations allocations() const {
+        Allocations now(threadAllocations());
+
+        now.count-= start.count;
+        now.bytes-= start.bytes;
+        now.frees-= start.frees;
+        return now;
+    }
+    /**
+     * Get the number of allocations made since the counter was created
+     */
+    long count() const {
+        return allocations().count;
+    }
+    /**
+     * Get the number of bytes allocated since the counter was created
+     */
+    long bytes() const {
+        return allocations().bytes;
+    }
+    /**
+     * Get the number of deallocations made since the counter was created
+     */
+    long frees() const {
+        return allocations().frees;
+    }
+
+private:
+    Allocations start;
+};
+
+inline void* countedAllocate(std::size_t size) {
+    Allocations& allocations= threadAllocations();
+    void* ptr= std::malloc(size == 0 ? 1 : size);
+
+    allocations.count++;
+    allocations.bytes+= size;
+    return ptr;
+}
+
+inline void countedFree(void* ptr) {
+    if (ptr != NULL) {
+        threadAllocations().frees++;
+        std::free(ptr);
+    }
+}
+
+}   //namespace test
+}   //namespace collections
+}   //namespace etsai
+
+void* operator new(std::size_t size) {
+    void* ptr= etsai::collections::test::countedAllocate(size);
+
+    if (ptr == NULL) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* operator new[](std::size_t size) {
+    void* ptr= etsai::collections::test::countedAllocate(size);
+
+    if (ptr == NULL) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return etsai::collections::test::countedAllocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return etsai::collections::test::countedAllocate(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    etsai::collections::test::countedFree(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    etsai::collections::test::countedFree(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+    etsai::collections::test::countedFree(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+    etsai::collections::test::countedFree(ptr);
+}
+
+#endif
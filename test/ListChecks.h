@@ -0,0 +1,49 @@
+#ifndef ETSAI_COLLECTIONS_TEST_LISTCHECKS_H
+#define ETSAI_COLLECTIONS_TEST_LISTCHECKS_H
+
+#include "List.h"
+
+#include <string>
+
+/**
+ * Checks shared by the tests of the List implementations.  Each check only uses the List interface, so a test
+ * file keeps to the behavior specific to its own class.
+ */
+namespace etsai {
+namespace collections {
+namespace test {
+
+/**
+ * Checks that the list holds 0, 1, ..., size - 1, both by index and by traversal
+ */
+inline bool holdsRange(const List<int>& l, int size) {
+    int expected= 0;
+    bool ordered= l.size() == size;
+
+    for(int i= 0; ordered && i < size; i++) {
+        ordered= l.at(i) == i;
+    }
+    l.each([&expected, &ordered](const int& elem) -> void {
+        ordered= ordered && elem == expected++;
+    });
+    return ordered && expected == size;
+}
+
+/**
+ * Checks the read functions of a list created from {5, 3, 7, 0, 1, 9}.  The right fold prepends each element to
+ * the text of the ones after it, so it only spells out the list if eachReverse visits the elements back to front.
+ */
+inline bool readsSample(const List<int>& l) {
+    std::string folded= l.foldRight<std::string>("", [](const int& elem, const std::string& rest) -> std::string {
+        return std::to_string(elem) + rest;
+    });
+
+    return l.size() == 6 && l.get(2) == 7 && l.at(5) == 9 && l.contains(0) && !l.contains(4) &&
+            l.equals({5, 3, 7, 0, 1, 9}) && folded == "537019" && l.toString() == "[5, 3, 7, 0, 1, 9]";
+}
+
+}   //namespace test
+}   //namespace collections
+}   //namespace etsai
+
+#endif